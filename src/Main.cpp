@@ -2,6 +2,7 @@
 
 #include <string>
 #include <algorithm>
+#include <filesystem>
 
 #include "RisExcept.hpp"
 
@@ -15,6 +16,7 @@
 #include "misc/Config.hpp"
 #include "misc/Logger.hpp"
 #include "misc/Version.hpp"
+#include "misc/StringSupport.hpp"
 
 #include "game/GameLoop.hpp"
 
@@ -28,6 +30,7 @@
 #include "loader/Loader.hpp"
 #include "loader/ResourcePack.hpp"
 #include "loader/ZipPack.hpp"
+#include "loader/RisPack.hpp"
 #include "loader/FilesystemPack.hpp"
 #include "loader/EmbeddedPack.hpp"
 
@@ -54,6 +57,15 @@ namespace
     
     static Config globalConfig;
     static Args globalArgs;
+
+    // .rpak archives are engine packs, everything else is treated as zip
+    void MountArchive(Loader::ResourcePack &resourcePack, const std::string &archivePath)
+    {
+        if(lowerCase(std::filesystem::path(archivePath).extension().generic_string()) == ".rpak")
+            resourcePack.PushBack(Loader::RisPack(archivePath));
+        else
+            resourcePack.PushBack(Loader::ZipPack(archivePath));
+    }
 }
 
 #ifdef _WIN32
@@ -78,7 +90,7 @@ int main(int argc, char *argv[])
 
     Loader::ResourcePack resourcePack;
 
-    std::string baseArchive = "main.zip";
+    std::string baseArchive = std::filesystem::exists("main.rpak") ? "main.rpak" : "main.zip";
     if(args.IsSet("-debug"))
     {
         baseArchive = "";
@@ -93,7 +105,7 @@ int main(int argc, char *argv[])
     {
         try
         {
-            resourcePack.PushBack(Loader::ZipPack(baseArchive));
+            MountArchive(resourcePack, baseArchive);
         }
         catch(const std::runtime_error &e)
         {
@@ -112,7 +124,7 @@ int main(int argc, char *argv[])
         {
             try
             {
-                resourcePack.PushBack(Loader::ZipPack(archiveFile));
+                MountArchive(resourcePack, archiveFile);
             }
             catch(const std::runtime_error &e)
             {
@@ -199,6 +211,7 @@ int main(int argc, char *argv[])
 
     logger.Info("Exit game");
 
+    Loader::GetAsyncLoader().Shutdown();
     Loader::GetCache().Clear();
 
     Logger::Destroy();
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <cstddef>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// minimal timing for the benchmark programs
+namespace RIS::Benchmark
+{
+    // keeps the compiler from dropping work whose result is never used
+    template<typename T>
+    void DoNotOptimize(const T &value)
+    {
+#if defined(_MSC_VER)
+        static const void *volatile sink = nullptr;
+        sink = &value;
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r"(&value) : "memory");
+#endif
+    }
+
+    // runs f once to warm up, then iterations times and prints the average time of one run in ms
+    template<typename F>
+    double Measure(const std::string &name, std::size_t iterations, F &&f)
+    {
+        f();
+
+        auto start = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < iterations; ++i)
+            f();
+        auto end = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+        std::printf("%-48s %12.4f ms\n", name.c_str(), ms);
+        return ms;
+    }
+
+    inline void Speedup(const std::string &name, double before, double after)
+    {
+        std::printf("%-48s %12.2fx\n", name.c_str(), after > 0.0 ? before / after : 0.0);
+    }
+}
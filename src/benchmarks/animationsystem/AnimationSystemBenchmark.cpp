@@ -0,0 +1,151 @@
+#include "graphics/AnimationSystem.hpp"
+#include "benchmarks/Benchmark.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdio>
+#include <cmath>
+
+// one frame of several hundred animated characters, every controller updated one after the other on
+// the calling thread against AnimationSystem::Update spreading them over the workers with ParallelFor.
+// both sets of controllers run the same motions and have to end up with the same palettes
+
+using namespace RIS;
+using namespace RIS::Graphics;
+using namespace RIS::Graphics::Animation;
+
+namespace
+{
+    constexpr std::size_t NUM_CONTROLLERS = 500;
+    constexpr std::size_t NUM_JOINTS = 64;
+    constexpr std::size_t NUM_CLIPS = 4;
+    constexpr std::size_t NUM_KEYS = 31;
+    constexpr std::size_t ITERATIONS = 50;
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    Skeleton::Ptr CreateSkeleton(std::mt19937 &random)
+    {
+        std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+        Pose rest(NUM_JOINTS);
+        for(std::size_t i = 0; i < NUM_JOINTS; ++i)
+        {
+            rest.SetParent(i, i == 0 ? -1 : static_cast<int>(random() % i));
+            rest.SetLocalTransform(i, Transform(glm::vec3(offset(random), 1.0f, offset(random)), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f)));
+        }
+        Pose bind = rest;
+        return std::make_shared<Skeleton>(std::move(rest), std::move(bind), std::vector<std::string>(NUM_JOINTS));
+    }
+
+    // one second clips with a rotation key every frame of 30 Hz on every joint and the root moving
+    Animation::Animation::Ptr CreateAnimation(std::mt19937 &random)
+    {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<FastClip> clips;
+        for(std::size_t c = 0; c < NUM_CLIPS; ++c)
+        {
+            Clip clip;
+            for(std::size_t joint = 0; joint < NUM_JOINTS; ++joint)
+            {
+                auto &rotation = clip[joint].GetRotationTrack();
+                rotation.SetInterpolation(Interpolation::LINEAR);
+                rotation.Resize(NUM_KEYS);
+                for(std::size_t k = 0; k < NUM_KEYS; ++k)
+                {
+                    glm::quat q = glm::normalize(glm::quat(4.0f, unit(random), unit(random), unit(random)));
+                    rotation[k].time = static_cast<float>(k) / (NUM_KEYS - 1);
+                    rotation[k].value = { q.x, q.y, q.z, q.w };
+                }
+            }
+            auto &position = clip[0].GetPositionTrack();
+            position.SetInterpolation(Interpolation::LINEAR);
+            position.Resize(NUM_KEYS);
+            for(std::size_t k = 0; k < NUM_KEYS; ++k)
+            {
+                position[k].time = static_cast<float>(k) / (NUM_KEYS - 1);
+                position[k].value = { unit(random), unit(random), unit(random) };
+            }
+            clip.RecalculateDuration();
+            clips.push_back(OptimizeClip(clip));
+        }
+        return std::make_shared<Animation::Animation>(std::move(clips));
+    }
+
+    // a motion fading into another and an additive layer on half of the joints, started at different times
+    std::vector<AnimationController::Ptr> CreateControllers(Skeleton::Ptr skeleton, Animation::Animation::Ptr animation)
+    {
+        BoneMask mask(NUM_JOINTS);
+        for(std::size_t i = NUM_JOINTS / 2; i < NUM_JOINTS; ++i)
+            mask.Set(i, 1.0f);
+
+        std::vector<AnimationController::Ptr> controllers;
+        for(std::size_t i = 0; i < NUM_CONTROLLERS; ++i)
+        {
+            auto controller = std::make_shared<AnimationController>(skeleton, animation);
+            controller->Play(i % NUM_CLIPS);
+            controller->Update(static_cast<float>(i % 60) * DELTA_TIME);
+            controller->Play((i + 1) % NUM_CLIPS, 0.3f, 1.1f);
+            controller->AddLayer((i + 2) % NUM_CLIPS, AnimationController::LayerMode::ADDITIVE, BoneMask(mask), 0.5f);
+            controllers.push_back(controller);
+        }
+        return controllers;
+    }
+}
+
+int main()
+{
+    std::mt19937 random(1234);
+    auto skeleton = CreateSkeleton(random);
+    auto animation = CreateAnimation(random);
+
+    auto serialControllers = CreateControllers(skeleton, animation);
+    auto parallelControllers = CreateControllers(skeleton, animation);
+
+    WorkerPool pool;
+    AnimationSystem system(pool);
+    for(const auto &controller : parallelControllers)
+        system.Add(controller);
+
+    std::printf("%zu controllers, %zu joints, %zu workers, %zu iterations\n", NUM_CONTROLLERS, NUM_JOINTS, system.NumWorkers(), ITERATIONS);
+
+    // what the system does without the workers, palettes packed in the same order
+    std::vector<glm::mat4> serialPalettes(NUM_CONTROLLERS * NUM_JOINTS);
+    double serial = Benchmark::Measure("serial controller updates", ITERATIONS, [&]
+    {
+        for(std::size_t i = 0; i < serialControllers.size(); ++i)
+        {
+            serialControllers[i]->Update(DELTA_TIME);
+            serialControllers[i]->GetSkinningPalette(gsl::span<glm::mat4>(serialPalettes.data() + i * NUM_JOINTS, NUM_JOINTS));
+        }
+        Benchmark::DoNotOptimize(serialPalettes);
+    });
+    double parallel = Benchmark::Measure("AnimationSystem::Update", ITERATIONS, [&]
+    {
+        system.Update(DELTA_TIME);
+        Benchmark::DoNotOptimize(system.GetPalettes());
+    });
+    Benchmark::Speedup("speedup", serial, parallel);
+
+    auto parallelPalettes = system.GetPalettes();
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i < serialPalettes.size(); ++i)
+    {
+        bool same = true;
+        for(int c = 0; c < 4; ++c)
+        {
+            for(int r = 0; r < 4; ++r)
+                same &= std::abs(serialPalettes[i][c][r] - parallelPalettes[i][c][r]) <= 1e-4f;
+        }
+        mismatches += !same;
+    }
+
+    if(mismatches > 0)
+    {
+        std::printf("serial and parallel updates disagree on %zu matrices\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "physics/WorldSolids.hpp"
+#include "benchmarks/Benchmark.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <random>
+#include <cstdio>
+#include <cstdint>
+
+// point and sphere queries against 50k box brushes, the old linear search over all brushes
+// against the bvh of WorldSolids. both have to agree on every query
+
+using namespace RIS;
+using namespace RIS::Physics;
+
+namespace
+{
+    constexpr std::size_t NUM_BRUSHES = 50000;
+    constexpr std::size_t NUM_QUERIES = 2000;
+    constexpr std::size_t ITERATIONS = 5;
+    constexpr float CELL_SIZE = 64.0f;
+    constexpr float QUERY_RADIUS = 16.0f;
+
+    // the search WorldSolids did before the bvh: every plane of every brush
+    namespace Legacy
+    {
+        bool Collides(const std::vector<Brush> &brushes, const glm::vec3 &position, float radius)
+        {
+            for(const auto &brush : brushes)
+            {
+                bool isInside = true;
+                for(const auto &plane : brush.planes)
+                {
+                    glm::vec3 p = position - (plane.normal * radius);
+                    float side = glm::dot(p, plane.normal) + plane.d;
+                    isInside &= side < 0;
+                }
+                if(isInside)
+                    return true;
+            }
+            return false;
+        }
+    }
+
+    Plane MakePlane(const glm::vec3 &normal, const glm::vec3 &point)
+    {
+        return { normal, point, -glm::dot(normal, point) };
+    }
+
+    // boxes of random size in the cells of a grid, so about half of the space is solid
+    std::vector<Brush> CreateBrushes(std::mt19937 &random)
+    {
+        std::uniform_real_distribution<float> size(CELL_SIZE * 0.2f, CELL_SIZE * 0.9f);
+        std::size_t side = 1;
+        while(side * side * side < NUM_BRUSHES)
+            ++side;
+
+        std::vector<Brush> brushes;
+        brushes.reserve(NUM_BRUSHES);
+        for(std::size_t i = 0; i < NUM_BRUSHES; ++i)
+        {
+            glm::vec3 cell(static_cast<float>(i % side), static_cast<float>(i / side % side), static_cast<float>(i / (side * side)));
+            glm::vec3 min = cell * CELL_SIZE;
+            glm::vec3 max = min + glm::vec3(size(random), size(random), size(random));
+
+            auto &brush = brushes.emplace_back();
+            brush.planes.push_back(MakePlane(glm::vec3(1, 0, 0), max));
+            brush.planes.push_back(MakePlane(glm::vec3(0, 1, 0), max));
+            brush.planes.push_back(MakePlane(glm::vec3(0, 0, 1), max));
+            brush.planes.push_back(MakePlane(glm::vec3(-1, 0, 0), min));
+            brush.planes.push_back(MakePlane(glm::vec3(0, -1, 0), min));
+            brush.planes.push_back(MakePlane(glm::vec3(0, 0, -1), min));
+        }
+        return brushes;
+    }
+}
+
+int main()
+{
+    std::mt19937 random(1234);
+    std::vector<Brush> brushes = CreateBrushes(random);
+
+    float extent = 0.0f;
+    for(const auto &brush : brushes)
+        extent = glm::max(extent, brush.planes[0].point.x);
+    std::uniform_real_distribution<float> coordinate(0.0f, extent);
+    std::vector<glm::vec3> queries(NUM_QUERIES);
+    for(auto &query : queries)
+        query = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+
+    std::printf("%zu brushes, %zu queries, %zu iterations\n", brushes.size(), queries.size(), ITERATIONS);
+
+    Benchmark::Measure("build WorldSolids", 1, [&]
+    {
+        std::vector<Brush> copy = brushes;
+        WorldSolids built(std::move(copy));
+        Benchmark::DoNotOptimize(built);
+    });
+    std::vector<Brush> copy = brushes;
+    WorldSolids worldSolids(std::move(copy));
+
+    std::size_t mismatches = 0;
+    for(float radius : { 0.0f, QUERY_RADIUS })
+    {
+        std::vector<std::uint8_t> linearHits(queries.size()), bvhHits(queries.size());
+        const char *kind = radius > 0.0f ? "spheres" : "points";
+
+        double linear = Benchmark::Measure(std::string(kind) + ", linear search", ITERATIONS, [&]
+        {
+            for(std::size_t i = 0; i < queries.size(); ++i)
+                linearHits[i] = Legacy::Collides(brushes, queries[i], radius);
+            Benchmark::DoNotOptimize(linearHits);
+        });
+        double bvh = Benchmark::Measure(std::string(kind) + ", bvh", ITERATIONS, [&]
+        {
+            for(std::size_t i = 0; i < queries.size(); ++i)
+                bvhHits[i] = worldSolids.Collides(queries[i], radius);
+            Benchmark::DoNotOptimize(bvhHits);
+        });
+        Benchmark::Speedup(std::string(kind) + " speedup", linear, bvh);
+
+        std::size_t hits = 0;
+        for(std::size_t i = 0; i < queries.size(); ++i)
+        {
+            hits += linearHits[i];
+            mismatches += linearHits[i] != bvhHits[i];
+        }
+        std::printf("%s: %zu of %zu queries hit a brush\n", kind, hits, queries.size());
+    }
+
+    if(mismatches > 0)
+    {
+        std::printf("bvh and linear search disagree on %zu queries\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
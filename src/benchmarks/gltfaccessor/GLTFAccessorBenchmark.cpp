@@ -0,0 +1,199 @@
+#include "loader/MeshData.hpp"
+#include "loader/TinyGLTF.hpp"
+#include "loader/GLTFAccessor.hpp"
+#include "benchmarks/Benchmark.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cstring>
+#include <cstdint>
+
+// compares the old per element accessor reads with ReadAccessor and ExtractGLTFMesh on
+// a parsed 100k vertex glb, built in memory so the benchmark doesn't need an asset
+
+using namespace RIS;
+using namespace RIS::Loader;
+
+namespace
+{
+    constexpr std::size_t NUM_VERTICES = 100000;
+    constexpr std::size_t ITERATIONS = 20;
+
+    // the reader that was replaced: a temporary vector for every element and no byteStride
+    namespace Legacy
+    {
+        template<typename T, std::size_t Size = sizeof(T)>
+        void GetValues(const tinygltf::Model &model, const tinygltf::Accessor &accessor, std::vector<T> &out)
+        {
+            out.resize(accessor.count);
+            const auto &bufferView = model.bufferViews.at(accessor.bufferView);
+            const auto &buffer = model.buffers.at(bufferView.buffer);
+
+            auto beg = buffer.data.cbegin() + bufferView.byteOffset + accessor.byteOffset;
+            auto end = buffer.data.cbegin() + bufferView.byteOffset + accessor.byteOffset + bufferView.byteLength;
+
+            std::size_t i = 0;
+            for(auto it = beg; it != end;)
+            {
+                std::vector<unsigned char> bytes(it, it + Size);
+                T val;
+                std::memcpy(&val, bytes.data(), Size);
+
+                out[i++] = val;
+
+                it += Size;
+            }
+        }
+
+        struct Mesh
+        {
+            std::vector<VertexType::ModelVertex> vertices;
+            std::vector<std::uint32_t> indices;
+            glm::vec3 min;
+            glm::vec3 max;
+        };
+
+        Mesh Extract(const tinygltf::Model &model)
+        {
+            const auto &primitive = model.meshes.at(0).primitives.at(0);
+            std::size_t numElements = model.accessors.at(primitive.attributes.at("POSITION")).count;
+
+            std::vector<glm::vec3> positions;
+            GetValues(model, model.accessors.at(primitive.attributes.at("POSITION")), positions);
+            std::vector<glm::vec3> normals;
+            GetValues(model, model.accessors.at(primitive.attributes.at("NORMAL")), normals);
+            std::vector<glm::vec2> texCoords;
+            GetValues(model, model.accessors.at(primitive.attributes.at("TEXCOORD_0")), texCoords);
+            std::vector<glm::i16vec4> joints;
+            GetValues(model, model.accessors.at(primitive.attributes.at("JOINTS_0")), joints);
+            std::vector<glm::vec4> weights;
+            GetValues(model, model.accessors.at(primitive.attributes.at("WEIGHTS_0")), weights);
+
+            Mesh mesh;
+            mesh.vertices.resize(numElements);
+            mesh.min = numElements > 0 ? positions.at(0) : glm::vec3(0.0f);
+            mesh.max = mesh.min;
+            for(std::size_t i = 0; i < numElements; ++i)
+            {
+                mesh.vertices[i] = { positions.at(i), normals.at(i), texCoords.at(i), joints.at(i), weights.at(i) };
+                mesh.min = glm::min(mesh.min, positions[i]);
+                mesh.max = glm::max(mesh.max, positions[i]);
+            }
+            GetValues(model, model.accessors.at(primitive.indices), mesh.indices);
+            return mesh;
+        }
+    }
+
+    // one tightly packed buffer view per attribute, the only layout the old reader handled correctly
+    template<typename T>
+    int AddAccessor(tinygltf::Model &model, const std::vector<T> &values, int componentType, int type, std::size_t count)
+    {
+        auto &buffer = model.buffers.at(0);
+        std::size_t offset = buffer.data.size();
+        std::size_t size = values.size() * sizeof(T);
+        buffer.data.resize(offset + size);
+        std::memcpy(buffer.data.data() + offset, values.data(), size);
+
+        tinygltf::BufferView view;
+        view.buffer = 0;
+        view.byteOffset = offset;
+        view.byteLength = size;
+        model.bufferViews.push_back(view);
+
+        tinygltf::Accessor accessor;
+        accessor.bufferView = static_cast<int>(model.bufferViews.size() - 1);
+        accessor.componentType = componentType;
+        accessor.type = type;
+        accessor.count = count;
+        model.accessors.push_back(accessor);
+        return static_cast<int>(model.accessors.size() - 1);
+    }
+
+    tinygltf::Model CreateModel(std::size_t numVertices)
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        auto fill = [&](std::size_t count){ std::vector<float> values(count); for(auto &value : values) value = distribution(random); return values; };
+
+        std::vector<std::uint16_t> joints(numVertices * 4);
+        for(std::size_t i = 0; i < joints.size(); ++i)
+            joints[i] = static_cast<std::uint16_t>(random() % 64);
+
+        // a triangle strip written out as a list
+        std::vector<std::uint32_t> indices;
+        indices.reserve((numVertices - 2) * 3);
+        for(std::uint32_t i = 0; i + 2 < numVertices; ++i)
+        {
+            indices.push_back(i);
+            indices.push_back(i + 1);
+            indices.push_back(i + 2);
+        }
+
+        tinygltf::Model model;
+        model.buffers.emplace_back();
+
+        tinygltf::Primitive primitive;
+        primitive.mode = TINYGLTF_MODE_TRIANGLES;
+        primitive.attributes["POSITION"] = AddAccessor(model, fill(numVertices * 3), TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, numVertices);
+        primitive.attributes["NORMAL"] = AddAccessor(model, fill(numVertices * 3), TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, numVertices);
+        primitive.attributes["TEXCOORD_0"] = AddAccessor(model, fill(numVertices * 2), TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC2, numVertices);
+        primitive.attributes["JOINTS_0"] = AddAccessor(model, joints, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_TYPE_VEC4, numVertices);
+        primitive.attributes["WEIGHTS_0"] = AddAccessor(model, fill(numVertices * 4), TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC4, numVertices);
+        primitive.indices = AddAccessor(model, indices, TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT, TINYGLTF_TYPE_SCALAR, indices.size());
+
+        tinygltf::Mesh mesh;
+        mesh.primitives.push_back(primitive);
+        model.meshes.push_back(mesh);
+
+        tinygltf::Node node;
+        node.mesh = 0;
+        model.nodes.push_back(node);
+
+        tinygltf::Scene scene;
+        scene.nodes.push_back(0);
+        model.scenes.push_back(scene);
+        model.defaultScene = 0;
+        return model;
+    }
+}
+
+int main()
+{
+    tinygltf::Model model = CreateModel(NUM_VERTICES);
+    const auto &primitive = model.meshes.at(0).primitives.at(0);
+    const auto &positionAccessor = model.accessors.at(primitive.attributes.at("POSITION"));
+
+    std::printf("%zu vertices, %zu iterations\n", NUM_VERTICES, ITERATIONS);
+
+    double legacyPositions = Benchmark::Measure("positions, per element copies", ITERATIONS, [&]
+    {
+        std::vector<glm::vec3> positions;
+        Legacy::GetValues(model, positionAccessor, positions);
+        Benchmark::DoNotOptimize(positions);
+    });
+    double positions = Benchmark::Measure("positions, ReadAccessor", ITERATIONS, [&]
+    {
+        std::vector<glm::vec3> positions(positionAccessor.count);
+        ReadAccessor(model, positionAccessor, 3, &positions[0].x);
+        Benchmark::DoNotOptimize(positions);
+    });
+    Benchmark::Speedup("positions speedup", legacyPositions, positions);
+
+    double legacyMesh = Benchmark::Measure("whole mesh, per element copies", ITERATIONS, [&]
+    {
+        auto mesh = Legacy::Extract(model);
+        Benchmark::DoNotOptimize(mesh);
+    });
+    double mesh = Benchmark::Measure("whole mesh, ExtractGLTFMesh", ITERATIONS, [&]
+    {
+        std::string warning;
+        auto meshData = ExtractGLTFMesh(model, warning);
+        Benchmark::DoNotOptimize(meshData);
+    });
+    Benchmark::Speedup("whole mesh speedup", legacyMesh, mesh);
+
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include "graphics/Animation.hpp"
+#include "benchmarks/Benchmark.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+
+// plays 1000 looping clips with 1k keys each at 60 fps, every clip offset in time. the key lookup of
+// the old backwards scan of Track, the binary search of Track, FastTrack and Track with a cursor.
+// all of them have to sample the same values
+
+using namespace RIS;
+using namespace RIS::Graphics::Animation;
+
+namespace
+{
+    constexpr std::size_t NUM_CLIPS = 1000;
+    constexpr std::size_t NUM_KEYS = 1000;
+    constexpr std::size_t NUM_FRAMES = 2400;
+    constexpr std::size_t ITERATIONS = 3;
+    constexpr float FRAME_TIME = 1.0f / 60.0f;
+    constexpr float KEY_TIME = 1.0f / 30.0f;
+
+    // the lookup Track did before: every frame from the back until one starts before time
+    namespace Legacy
+    {
+        class LinearTrack : public VectorTrack
+        {
+        protected:
+            int FrameIndex(float time, bool looping) const override
+            {
+                std::size_t size = frames.size();
+                if(size <= 1)
+                    return -1;
+
+                if(looping)
+                {
+                    float startTime = frames.front().time;
+                    float endTime = frames.back().time;
+                    float duration = endTime - startTime;
+
+                    time = std::fmod(time - startTime, duration);
+                    if(time < 0.0f)
+                        time += duration;
+                    time += startTime;
+                }
+                else
+                {
+                    if(time <= frames.front().time)
+                        return 0;
+                    if(time >= frames.rbegin()[1].time) // second to last element
+                        return static_cast<int>(size) - 2;
+                }
+
+                int index = static_cast<int>(size) - 1;
+                for(auto it = frames.rbegin(); it != frames.rend(); ++it)
+                {
+                    if(time >= (*it).time)
+                        return index;
+                    index--;
+                }
+                return -1;
+            }
+        };
+    }
+
+    // keys a little off the 30 fps grid, like exported animations with dropped or moved keys
+    VectorTrack CreateTrack(std::mt19937 &random)
+    {
+        std::uniform_real_distribution<float> jitter(0.25f, 1.75f);
+        std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+
+        VectorTrack track;
+        track.SetInterpolation(Interpolation::LINEAR);
+        track.Resize(NUM_KEYS);
+        float time = 0.0f;
+        for(std::size_t i = 0; i < NUM_KEYS; ++i)
+        {
+            auto &frame = track[i];
+            frame.time = time;
+            frame.value = { value(random), value(random), value(random) };
+            frame.in = { 0.0f, 0.0f, 0.0f };
+            frame.out = { 0.0f, 0.0f, 0.0f };
+            time += KEY_TIME * jitter(random);
+        }
+        return track;
+    }
+
+    template<typename TRACK>
+    void CopyKeys(const VectorTrack &from, TRACK &to)
+    {
+        to.SetInterpolation(from.GetInterpolation());
+        to.Resize(from.Size());
+        for(std::size_t i = 0; i < from.Size(); ++i)
+            to[i] = from[i];
+    }
+}
+
+int main()
+{
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> offset(0.0f, NUM_KEYS * KEY_TIME);
+
+    std::vector<VectorTrack> tracks;
+    std::vector<Legacy::LinearTrack> linearTracks(NUM_CLIPS);
+    std::vector<FastVectorTrack> fastTracks;
+    std::vector<float> offsets;
+    tracks.reserve(NUM_CLIPS);
+    fastTracks.reserve(NUM_CLIPS);
+    for(std::size_t i = 0; i < NUM_CLIPS; ++i)
+    {
+        tracks.push_back(CreateTrack(random));
+        CopyKeys(tracks.back(), linearTracks[i]);
+        fastTracks.push_back(OptimizeTrack(tracks.back()));
+        offsets.push_back(offset(random));
+    }
+
+    std::printf("%zu clips, %zu keys, %zu frames, %zu iterations\n", NUM_CLIPS, NUM_KEYS, NUM_FRAMES, ITERATIONS);
+
+    std::vector<glm::vec3> values(NUM_CLIPS);
+    double linear = Benchmark::Measure("Track, linear scan", ITERATIONS, [&]
+    {
+        for(std::size_t frame = 0; frame < NUM_FRAMES; ++frame)
+        {
+            for(std::size_t i = 0; i < NUM_CLIPS; ++i)
+                values[i] = linearTracks[i].Sample(offsets[i] + frame * FRAME_TIME, true);
+            Benchmark::DoNotOptimize(values);
+        }
+    });
+    double binary = Benchmark::Measure("Track, binary search", ITERATIONS, [&]
+    {
+        for(std::size_t frame = 0; frame < NUM_FRAMES; ++frame)
+        {
+            for(std::size_t i = 0; i < NUM_CLIPS; ++i)
+                values[i] = tracks[i].Sample(offsets[i] + frame * FRAME_TIME, true);
+            Benchmark::DoNotOptimize(values);
+        }
+    });
+    double fast = Benchmark::Measure("FastTrack", ITERATIONS, [&]
+    {
+        for(std::size_t frame = 0; frame < NUM_FRAMES; ++frame)
+        {
+            for(std::size_t i = 0; i < NUM_CLIPS; ++i)
+                values[i] = fastTracks[i].Sample(offsets[i] + frame * FRAME_TIME, true);
+            Benchmark::DoNotOptimize(values);
+        }
+    });
+    double cursor = Benchmark::Measure("Track, cursor", ITERATIONS, [&]
+    {
+        // a new playback for every run, like a clip that is started again
+        std::vector<TrackCursor> cursors(NUM_CLIPS);
+        for(std::size_t frame = 0; frame < NUM_FRAMES; ++frame)
+        {
+            for(std::size_t i = 0; i < NUM_CLIPS; ++i)
+                values[i] = tracks[i].Sample(offsets[i] + frame * FRAME_TIME, true, &cursors[i]);
+            Benchmark::DoNotOptimize(values);
+        }
+    });
+    Benchmark::Speedup("binary search speedup", linear, binary);
+    Benchmark::Speedup("FastTrack speedup", linear, fast);
+    Benchmark::Speedup("cursor speedup", linear, cursor);
+
+    std::size_t mismatches = 0;
+    std::vector<TrackCursor> cursors(NUM_CLIPS);
+    for(std::size_t frame = 0; frame < NUM_FRAMES; ++frame)
+    {
+        for(std::size_t i = 0; i < NUM_CLIPS; ++i)
+        {
+            float time = offsets[i] + frame * FRAME_TIME;
+            glm::vec3 expected = linearTracks[i].Sample(time, true);
+            mismatches += tracks[i].Sample(time, true) != expected;
+            mismatches += fastTracks[i].Sample(time, true) != expected;
+            mismatches += tracks[i].Sample(time, true, &cursors[i]) != expected;
+        }
+    }
+
+    if(mismatches > 0)
+    {
+        std::printf("the lookups disagree on %zu samples\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -10,6 +10,8 @@
 
 #include <sstream>
 #include <string>
+#include <map>
+#include <algorithm>
 
 #include <magic_enum.hpp>
 #include <fmt/format.h>
@@ -18,6 +20,14 @@ using namespace std::literals;
 
 namespace RIS::Game
 {
+    namespace
+    {
+        std::string FormatSize(std::size_t bytes)
+        {
+            return fmt::format("{:.2f} MB", bytes / (1024.0f * 1024.0f));
+        }
+    }
+
     void GameLoop::RegisterFuncs()
     {
         auto &console = GetConsole();
@@ -56,6 +66,73 @@ namespace RIS::Game
             return ""s;
         });
 
+        console.BindFunc("cache_usage", [](const auto&)
+        {
+            const auto &cache = Loader::GetCache();
+
+            struct TypeUsage
+            {
+                std::size_t count = 0;
+                std::size_t evictable = 0;
+                Loader::AssetFootprint footprint;
+            };
+
+            std::map<std::string_view, TypeUsage> types;
+            for(const auto &asset : cache.GetUsage())
+            {
+                auto &type = types[asset.type];
+                type.count++;
+                type.evictable += asset.evictable ? 1 : 0;
+                type.footprint += asset.footprint;
+            }
+
+            std::stringstream msg;
+            for(const auto &[name, type] : types)
+                msg << fmt::format("{}: {} assets ({} unused), cpu {}, gpu {}\n", name, type.count, type.evictable, FormatSize(type.footprint.cpu), FormatSize(type.footprint.gpu));
+
+            std::size_t budget = cache.GetBudget();
+            msg << fmt::format("total {} of {}", FormatSize(cache.GetTotalSize()), budget > 0 ? FormatSize(budget) : "unlimited"s);
+            return msg.str();
+        });
+
+        console.BindFunc("cache_list", [](const std::vector<std::string> &params)
+        {
+            auto usage = Loader::GetCache().GetUsage();
+            std::sort(std::begin(usage), std::end(usage), [](const auto &a, const auto &b){ return a.footprint.Total() > b.footprint.Total(); });
+
+            std::string filter = params.size() > 0 ? lowerCase(params.at(0)) : "";
+
+            std::stringstream msg;
+            for(const auto &asset : usage)
+            {
+                if(!filter.empty() && lowerCase(std::string(asset.type)) != filter)
+                    continue;
+                msg << fmt::format("{} [{}] cpu {}, gpu {}, handles {}{}\n", asset.name, asset.type, FormatSize(asset.footprint.cpu), FormatSize(asset.footprint.gpu), asset.handles, asset.evictable ? ", unused" : "");
+            }
+            return msg.str();
+        });
+
+        console.BindFunc("cache_budget", [](const std::vector<std::string> &params)
+        {
+            auto &cache = Loader::GetCache();
+            if(params.size() == 0)
+                return fmt::format("{} MB", cache.GetBudget() / (1024 * 1024));
+
+            try
+            {
+                int value = std::stoi(params.at(0));
+                if(value < 0)
+                    return "Invalid Value"s;
+                GetConfig().SetValue("cache_budget_mb", value);
+                cache.SetBudget(static_cast<std::size_t>(value) * 1024 * 1024);
+            }
+            catch(const std::exception&)
+            {
+                return "Invalid Value"s;
+            }
+            return ""s;
+        });
+
         console.BindFunc("bind", [this](const std::vector<std::string> &params)
         {
             if(params.size() != 2)
@@ -6,6 +6,8 @@
 #include "audio/AudioEngine.hpp"
 #include "ui/Userinterface.hpp"
 #include "input/Input.hpp"
+#include "loader/AsyncLoader.hpp"
+#include "loader/Loader.hpp"
 
 #include "window/Paths.hpp"
 
@@ -15,6 +17,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 using namespace std::literals;
 
 namespace RIS::Game
@@ -54,6 +58,11 @@ namespace RIS::Game
 
         float accumulator = 0.0f;
         float delta = 1.0f / config.GetValue("g_physfps", 144.0f);
+        float uploadBudget = config.GetValue("ld_uploadbudget", 4.0f);
+
+        auto &asyncLoader = Loader::GetAsyncLoader();
+        auto &cache = Loader::GetCache();
+        cache.SetBudget(static_cast<std::size_t>(std::max(config.GetValue("cache_budget_mb", 512), 0)) * 1024 * 1024);
 
         std::visit([&](auto &&s){ s.Start(); }, state);
 
@@ -63,6 +72,8 @@ namespace RIS::Game
             input.Update();
             interface.Update(timer);
             inputMapper.Update();
+            asyncLoader.Update(std::chrono::duration<float, std::milli>(uploadBudget));
+            cache.Trim();
 
             auto nextState = std::visit([](auto &&s){ return s.GetNextState(); }, state);
             if(nextState)
@@ -20,8 +20,11 @@ namespace RIS::Game
 
     void LoadScene::Start()
     {
-        sceneData.mapVertexShader = Loader::Load<Graphics::Shader>("shaders/mapVertex.glsl", resourcePack, Graphics::ShaderType::VERTEX);
-        sceneData.mapFragmentShader = Loader::Load<Graphics::Shader>("shaders/mapFragment.glsl", resourcePack, Graphics::ShaderType::FRAGMENT);
+        std::string entityFile = fmt::format("{}.entity", mapName);
+
+        mapVertexShaderFuture = Loader::LoadAsync<Graphics::Shader>("shaders/mapVertex.glsl", resourcePack, Graphics::ShaderType::VERTEX);
+        mapFragmentShaderFuture = Loader::LoadAsync<Graphics::Shader>("shaders/mapFragment.glsl", resourcePack, Graphics::ShaderType::FRAGMENT);
+        mapEntitiesFuture = Loader::LoadAsync<MapEntities>(entityFile, resourcePack);
     }
 
     void LoadScene::End()
@@ -36,17 +39,33 @@ namespace RIS::Game
 
     void LoadScene::Update(const Timer &timer, float timeStep)
     {
-        if(!sceneData.mapMesh)
+        if(doneLoading)
+            return;
+
+        // the map mesh and the world solids take the entity geometry and brushes, so they have to wait for the entities
+        if(!mapMeshFuture.valid())
         {
+            if(!Loader::IsReady(mapEntitiesFuture))
+                return;
+            if(!(sceneData.mapEntities = mapEntitiesFuture.get())) throw RISException(fmt::format("Could not load entity file {}.entity", mapName));
+
             std::string polyFile = fmt::format("{}.poly", mapName);
             std::string solidsFile = fmt::format("{}.brush", mapName);
-            std::string entityFile = fmt::format("{}.entity", mapName);
-            if(!(sceneData.mapMesh = Loader::Load<Graphics::MapMesh>(polyFile, resourcePack))) throw RISException(fmt::format("Could not load poly file {}", polyFile));
-            if(!(sceneData.worldSolids = Loader::Load<Physics::WorldSolids>(solidsFile, resourcePack))) throw RISException(fmt::format("Could not load solids file {}", solidsFile));
-            if(!(sceneData.mapEntities = Loader::Load<MapEntities>(entityFile, resourcePack))) throw RISException(fmt::format("Could not load entity file {}", entityFile));
-
-            doneLoading = true;
+            mapMeshFuture = Loader::LoadAsync<Graphics::MapMesh>(polyFile, resourcePack, sceneData.mapEntities);
+            worldSolidsFuture = Loader::LoadAsync<Physics::WorldSolids>(solidsFile, resourcePack, sceneData.mapEntities);
         }
+
+        bool allReady = Loader::IsReady(mapMeshFuture) && Loader::IsReady(worldSolidsFuture) && Loader::IsReady(mapEntitiesFuture) 
+                        && Loader::IsReady(mapVertexShaderFuture) && Loader::IsReady(mapFragmentShaderFuture);
+        if(!allReady)
+            return;
+
+        if(!(sceneData.mapMesh = mapMeshFuture.get())) throw RISException(fmt::format("Could not load poly file {}.poly", mapName));
+        if(!(sceneData.worldSolids = worldSolidsFuture.get())) throw RISException(fmt::format("Could not load solids file {}.brush", mapName));
+        sceneData.mapVertexShader = mapVertexShaderFuture.get();
+        sceneData.mapFragmentShader = mapFragmentShaderFuture.get();
+
+        doneLoading = true;
     }
 
     void LoadScene::Draw(float interpol)
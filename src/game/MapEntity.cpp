@@ -2,8 +2,8 @@
 
 namespace RIS::Game
 {
-    MapEntity::MapEntity(const std::string &classname, MapProps &&props)
-        : classname(classname), props(std::move(props))
+    MapEntity::MapEntity(const std::string &classname, MapProps &&props, MapEntityMesh &&mesh, std::vector<Physics::Brush> &&brushes)
+        : classname(classname), props(std::move(props)), mesh(std::move(mesh)), brushes(std::move(brushes))
     {}
 
     std::string_view MapEntity::Classname() const
@@ -15,4 +15,14 @@ namespace RIS::Game
     {
         return props;
     }
+
+    const MapEntityMesh& MapEntity::Mesh() const
+    {
+        return mesh;
+    }
+
+    const std::vector<Physics::Brush>& MapEntity::Brushes() const
+    {
+        return brushes;
+    }
 }
@@ -2,24 +2,50 @@
 
 #include "game/MapProps.hpp"
 
+#include "graphics/VertexTypes.hpp"
+#include "physics/Brush.hpp"
+
 #include <string>
 #include <string_view>
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 namespace RIS::Game
 {
+    // a range of the entity indices drawn with one texture
+    struct MapEntitySection
+    {
+        std::string texture;
+        std::uint32_t indexOffset;
+        std::uint32_t indexCount;
+    };
+
+    // entity local geometry, indices are relative to the first vertex of the entity.
+    // the map mesh packs the geometry of all entities into its own buffers and keeps where each one ended up,
+    // the cached entities are only read so the map mesh can be loaded again
+    struct MapEntityMesh
+    {
+        std::vector<VertexType::MapVertex> vertices;
+        std::vector<std::uint32_t> indices;
+        std::vector<MapEntitySection> sections;
+    };
+
     class MapEntity
     {
     public:
-        MapEntity(const std::string &classname, MapProps &&props);
+        MapEntity(const std::string &classname, MapProps &&props, MapEntityMesh &&mesh = {}, std::vector<Physics::Brush> &&brushes = {});
 
         std::string_view Classname() const;
         const MapProps& Props() const;
+        const MapEntityMesh& Mesh() const;
+        const std::vector<Physics::Brush>& Brushes() const;
 
     private:
         std::string classname;
         MapProps props;
+        MapEntityMesh mesh;
+        std::vector<Physics::Brush> brushes;
 
     };
 
@@ -84,6 +84,16 @@ namespace RIS::Game
             camera.SetYaw(props.GetOrDefault("angle", 0.0f));
         }
 
+        // triggers are volumes the player walks through, their brushes only mark where they are
+        for(std::size_t i = 0; i < entities.size(); ++i)
+        {
+            std::uint32_t firstBrush = sceneData.worldSolids->EntityFirstBrush(i);
+            if(entities[i].Classname().substr(0, 8) != "trigger_" || firstBrush == UINT32_MAX)
+                continue;
+            for(std::size_t j = 0; j < entities[i].Brushes().size(); ++j)
+                sceneData.worldSolids->SetSolid(firstBrush + static_cast<std::uint32_t>(j), false);
+        }
+
         //camera.Position() = glm::vec3(0, 40, 0); // (-256 -256 40)
         //camera.SetYaw(glm::radians(180.0f));
         camera.SetPitch(0);
@@ -136,14 +146,7 @@ namespace RIS::Game
         movement += camera.Right() * camVelocity.x * timeStep;
         movement += glm::vec3(0, 1, 0) * camVelocity.y * timeStep;
         
-        pos.x = sceneData.worldSolids->Collides(oldPos + glm::vec3(movement.x, 0, 0), camRadius) ? oldPos.x : oldPos.x + movement.x;
-        pos.y = sceneData.worldSolids->Collides(oldPos + glm::vec3(0, movement.y, 0), camRadius) ? oldPos.y : oldPos.y + movement.y;
-        pos.z = sceneData.worldSolids->Collides(oldPos + glm::vec3(0, 0, movement.z), camRadius) ? oldPos.z : oldPos.z + movement.z;
-
-        //glm::vec3 resolv;
-        //pos.x = sceneData.worldSolids->Collides(oldPos, oldPos + glm::vec3(movement.x, 0, 0), camRadius, resolv) ? resolv.x : oldPos.x + movement.x;
-        //pos.y = sceneData.worldSolids->Collides(oldPos, oldPos + glm::vec3(0, movement.y, 0), camRadius, resolv) ? resolv.y : oldPos.y + movement.y;
-        //pos.z = sceneData.worldSolids->Collides(oldPos, oldPos + glm::vec3(0, 0, movement.z), camRadius, resolv) ? resolv.z : oldPos.z + movement.z;
+        pos = sceneData.worldSolids->SlideMove(oldPos, movement, camRadius);
 
         camera.Position() = pos;
 
@@ -186,6 +189,7 @@ namespace RIS::Game
         mapLayout.Bind();
         sceneData.mapMesh->Bind(mapLayout);
         sceneData.mapMesh->Draw();
+        sceneData.mapMesh->DrawEntities();
     }
 
     std::optional<State> PlayScene::GetNextState() const
@@ -10,6 +10,7 @@
 
 #include "misc/Timer.hpp"
 #include "loader/ResourcePack.hpp"
+#include "loader/Loader.hpp"
 
 #include "input/InputMapper.hpp"
 
@@ -99,5 +100,11 @@ namespace RIS::Game
         std::string mapName;
         SceneData sceneData;
 
+        Loader::AssetFuture<Graphics::MapMesh> mapMeshFuture;
+        Loader::AssetFuture<Physics::WorldSolids> worldSolidsFuture;
+        Loader::AssetFuture<MapEntities> mapEntitiesFuture;
+        Loader::AssetFuture<Graphics::Shader> mapVertexShaderFuture;
+        Loader::AssetFuture<Graphics::Shader> mapFragmentShaderFuture;
+
     };
 }
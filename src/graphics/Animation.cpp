@@ -2,7 +2,7 @@
 
 namespace RIS::Graphics::Animation
 {
-    Animation::Animation(std::vector<FastClip> &&newClips)
+    Animation::Animation(std::vector<ClipType> &&newClips)
     {
         clips = std::move(newClips);
         for(std::size_t i = 0; i < clips.size(); ++i)
@@ -12,43 +12,48 @@ namespace RIS::Graphics::Animation
         }
     }
 
-    FastClip& Animation::GetByName(const std::string &clipName)
+    Animation::ClipType& Animation::GetByName(const std::string &clipName)
     {
         return clips.at(nameToIndex.at(clipName));
     }
 
-    const FastClip& Animation::GetByName(const std::string &clipName) const
+    const Animation::ClipType& Animation::GetByName(const std::string &clipName) const
     {
         return clips.at(nameToIndex.at(clipName));
     }
 
-    FastClip& Animation::GetByIndex(std::size_t index)
+    Animation::ClipType& Animation::GetByIndex(std::size_t index)
     {
         return clips.at(index);
     }
 
-    const FastClip& Animation::GetByIndex(std::size_t index) const
+    const Animation::ClipType& Animation::GetByIndex(std::size_t index) const
     {
         return clips.at(index);
     }
 
-    FastClip& Animation::operator[](const std::string &clipName)
+    Animation::ClipType& Animation::operator[](const std::string &clipName)
     {
         return GetByName(clipName);
     }
 
-    const FastClip& Animation::operator[](const std::string &clipName) const
+    const Animation::ClipType& Animation::operator[](const std::string &clipName) const
     {
         return GetByName(clipName);
     }
 
-    FastClip& Animation::operator[](std::size_t index)
+    Animation::ClipType& Animation::operator[](std::size_t index)
     {
         return GetByIndex(index);
     }
 
-    const FastClip& Animation::operator[](std::size_t index) const
+    const Animation::ClipType& Animation::operator[](std::size_t index) const
     {
         return GetByIndex(index);
     }
+
+    std::size_t Animation::Size() const
+    {
+        return clips.size();
+    }
 }
@@ -5,11 +5,14 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include <gsl/span>
+
 #include <array>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <cstdint>
 
 namespace RIS::Graphics::Animation
 {
@@ -33,6 +36,13 @@ namespace RIS::Graphics::Animation
     using VectorFrame       = Frame<3>;
     using QuaternionFrame   = Frame<4>;
 
+    // remembers the key a track was sampled at last, so playing forward finds the next key in constant time.
+    // every playback of a track needs its own cursor
+    struct TrackCursor
+    {
+        int frame = -1;
+    };
+
     template<typename T, unsigned int N>
     class Track
     {
@@ -46,16 +56,17 @@ namespace RIS::Graphics::Animation
         float GetStartTime() const;
         float GetEndTime() const;
 
-        T Sample(float time, bool looping) const;
+        T Sample(float time, bool looping, TrackCursor *cursor = nullptr) const;
         Frame<N>& operator[](std::size_t index);
         const Frame<N>& operator[](std::size_t index) const;
 
         float AdjustTimeToFitTrack(float time, bool looping) const;
 
     private:
-        T SampleConstant(float time, bool looping) const;
-        T SampleLinear(float time, bool looping) const;
-        T SampleCubic(float time, bool looping) const;
+        int FindFrame(float time, bool looping, TrackCursor *cursor) const;
+        T SampleConstant(float time, bool looping, TrackCursor *cursor) const;
+        T SampleLinear(float time, bool looping, TrackCursor *cursor) const;
+        T SampleCubic(float time, bool looping, TrackCursor *cursor) const;
         T Hermite(float t, const T &p1, const T &s1, const T &p2, const T &s2) const;
 
         T Cast(const float *value) const;
@@ -99,6 +110,13 @@ namespace RIS::Graphics::Animation
     class TTransformTrack
     {
     public:
+        struct Cursor
+        {
+            TrackCursor position;
+            TrackCursor rotation;
+            TrackCursor scale;
+        };
+
         TTransformTrack();
 
         unsigned int GetId() const;
@@ -116,7 +134,7 @@ namespace RIS::Graphics::Animation
 
         bool IsValid() const;
 
-        Transform Sample(const Transform &ref, float time, bool looping) const;
+        Transform Sample(const Transform &ref, float time, bool looping, Cursor *cursor = nullptr) const;
 
     private:
         unsigned int id;
@@ -153,21 +171,117 @@ namespace RIS::Graphics::Animation
         Transform GetGlobalTransform(std::size_t index) const;
         Transform operator[](std::size_t index) const;
 
+        // all global transforms in one pass, every joint is combined with its parent only once
+        void GetGlobalTransforms(std::vector<Transform> &out) const;
         void GetMatrixPalette(std::vector<glm::mat4> &out) const;
+        // out has room for Size() matrices
+        void GetMatrixPalette(gsl::span<glm::mat4> out) const;
+
+        // true if every parent comes before its children
+        bool IsTopological() const;
+
+        // keeps the global transforms until a local transform or parent changes.
+        // a pose with the cache enabled must not be read from several threads at once
+        void SetCacheGlobals(bool cache);
 
         bool operator==(const Pose &other) const;
         bool operator!=(const Pose &other) const;
 
+    private:
+        const std::vector<Transform>& CachedGlobals() const;
+
     private:
         std::vector<Transform> joints;
         std::vector<int> parents;
 
+        bool cacheGlobals = false;
+        mutable bool globalsDirty = true;
+        mutable std::vector<Transform> globals;
+
+    };
+
+    // per joint weights in [0, 1] for layers and partial blends. an empty mask covers every joint fully,
+    // joints with a weight of 0 aren't sampled at all
+    class BoneMask
+    {
+    public:
+        BoneMask() = default;
+        BoneMask(std::size_t numJoints, float weight = 0.0f);
+
+        void Set(std::size_t joint, float weight);
+        // sets joint and every joint below it
+        void SetChain(const Pose &pose, std::size_t joint, float weight);
+        float Get(std::size_t joint) const;
+        bool Includes(std::size_t joint) const;
+        bool IsEmpty() const;
+
+    private:
+        std::vector<float> weights;
+
+    };
+
+    // out = mix of a and b per joint, the mask scales t. out may be a or b
+    void Blend(Pose &out, const Pose &a, const Pose &b, float t, const BoneMask *mask = nullptr);
+    // adds weight times the difference between additive and additiveBase on top of in
+    void BlendAdditive(Pose &out, const Pose &in, const Pose &additive, const Pose &additiveBase, float weight, const BoneMask *mask = nullptr);
+
+    // pose with every component in its own stream of floats, four joints per 16 byte block,
+    // so blending works on four joints at a time. the padding joints at the end are identity transforms
+    class SoAPose
+    {
+    public:
+        struct alignas(16) Float4
+        {
+            float v[4];
+        };
+
+        SoAPose() = default;
+        SoAPose(std::size_t numJoints);
+        explicit SoAPose(const Pose &pose);
+
+        void Resize(std::size_t size);
+        std::size_t Size() const;
+        int GetParent(std::size_t index) const;
+        void SetParent(std::size_t index, int parent);
+
+        Transform GetLocalTransform(std::size_t index) const;
+        void SetLocalTransform(std::size_t index, const Transform &transform);
+
+        void FromPose(const Pose &pose);
+        void ToPose(Pose &out) const;
+
+        // model space transforms of all joints, parents have to come before their children
+        void LocalToModel(SoAPose &out) const;
+        void GetMatrixPalette(std::vector<glm::mat4> &out) const;
+        // out has room for Size() matrices
+        void GetMatrixPalette(gsl::span<glm::mat4> out) const;
+
+        // same results as the Pose versions. out may be a or b, or in for the additive blend
+        friend void Blend(SoAPose &out, const SoAPose &a, const SoAPose &b, float t, const BoneMask *mask);
+        friend void BlendAdditive(SoAPose &out, const SoAPose &in, const SoAPose &additive, const SoAPose &additiveBase, float weight, const BoneMask *mask);
+
+    private:
+        void WriteMatrices(gsl::span<glm::mat4> out) const;
+
+    private:
+        std::vector<Float4> positionX, positionY, positionZ;
+        std::vector<Float4> rotationX, rotationY, rotationZ, rotationW;
+        std::vector<Float4> scaleX, scaleY, scaleZ;
+        std::vector<int> parents;
+        std::size_t size = 0;
+
     };
 
+    void Blend(SoAPose &out, const SoAPose &a, const SoAPose &b, float t, const BoneMask *mask = nullptr);
+    void BlendAdditive(SoAPose &out, const SoAPose &in, const SoAPose &additive, const SoAPose &additiveBase, float weight, const BoneMask *mask = nullptr);
+
     template<typename TRACK>
     class TClip
     {
     public:
+        // one cursor per track, keep one around per playback of the clip
+        using Cursor = std::vector<typename TRACK::Cursor>;
+
         TClip();
 
         std::size_t GetIdAtIndex(std::size_t index) const;
@@ -175,6 +289,10 @@ namespace RIS::Graphics::Animation
         std::size_t Size() const;
 
         float Sample(Pose &outPose, float inTime) const;
+        // only samples the joints in mask
+        float Sample(Pose &outPose, float inTime, Cursor &cursor, const BoneMask *mask = nullptr) const;
+        float Sample(SoAPose &outPose, float inTime) const;
+        float Sample(SoAPose &outPose, float inTime, Cursor &cursor, const BoneMask *mask = nullptr) const;
         TRACK& operator[](std::size_t index);
         const TRACK& operator[](std::size_t index) const;
 
@@ -190,6 +308,8 @@ namespace RIS::Graphics::Animation
 
     private:
         float AdjustTimeToFitRange(float inTime) const;
+        template<typename POSE>
+        float SampleTracks(POSE &outPose, float inTime, typename TRACK::Cursor *cursors, const BoneMask *mask) const;
 
     private:
         std::vector<TRACK> tracks;
@@ -205,6 +325,127 @@ namespace RIS::Graphics::Animation
 
     FastClip OptimizeClip(const Clip &input);
 
+    struct CompressionSettings
+    {
+        float sampleRate = 30.0f;
+        float positionTolerance = 0.001f;
+        float rotationTolerance = 0.001f;   // radians
+        float scaleTolerance = 0.001f;
+        // a higher rate up to this one is used if it puts every key on a sample
+        // or if a channel doesn't stay within its tolerance between the samples otherwise
+        float maxSampleRate = 120.0f;
+    };
+
+    // clip resampled at a fixed rate with quantized keys. keys that linear interpolation
+    // can rebuild within the tolerances are dropped, the rest keep their sample index instead of a time.
+    // the error is checked at the samples, at the keys of the source and between the samples of cubic tracks
+    class CompressedClip
+    {
+    public:
+        // smallest three: index of the largest component and the other three in 15 bits each
+        struct PackedQuat
+        {
+            std::uint16_t bits[3];
+        };
+
+        // each component quantized to 16 bits in the range of its key
+        struct PackedVec3
+        {
+            std::uint16_t bits[3];
+        };
+
+        // the keys from firstSample up to the next range are quantized in it
+        struct Range
+        {
+            glm::vec3 min = glm::vec3(0.0f);
+            glm::vec3 extent = glm::vec3(0.0f);
+            std::uint16_t firstSample = 0;
+        };
+
+        template<typename KEY>
+        struct Stream
+        {
+            std::vector<KEY> keys;              // empty if the channel isn't animated
+            std::vector<std::uint16_t> samples; // sample index of every key, empty if every sample has a key
+            bool step = false;                  // constant interpolation
+        };
+
+        // a stream is split into more ranges only where its values spread so far
+        // that a 16 bit step would be larger than the tolerance
+        struct VectorStream : Stream<PackedVec3>
+        {
+            std::vector<Range> ranges;
+        };
+
+        using RotationStream = Stream<PackedQuat>;
+
+        struct Track
+        {
+            unsigned int id = 0;
+            VectorStream position;
+            RotationStream rotation;
+            VectorStream scale;
+        };
+
+        using Cursor = std::vector<TransformTrack::Cursor>;
+
+        CompressedClip();
+
+        float Sample(Pose &outPose, float inTime) const;
+        // only samples the joints in mask
+        float Sample(Pose &outPose, float inTime, Cursor &cursor, const BoneMask *mask = nullptr) const;
+        float Sample(SoAPose &outPose, float inTime) const;
+        float Sample(SoAPose &outPose, float inTime, Cursor &cursor, const BoneMask *mask = nullptr) const;
+        // the transform of the track at index, channels without keys are taken from ref
+        Transform SampleTrack(std::size_t index, const Transform &ref, float time, TransformTrack::Cursor *cursor = nullptr) const;
+
+        std::size_t GetIdAtIndex(std::size_t index) const;
+        std::size_t Size() const;
+
+        const std::string& GetName() const;
+        float GetDuration() const;
+        float GetStartTime() const;
+        float GetEndTime() const;
+        bool GetLooping() const;
+        void SetLooping(bool newLooping);
+
+        // false if some channel is off by more than its tolerance between two samples even at the
+        // highest sample rate, e.g. a step between the samples
+        bool WithinTolerance() const;
+        // bytes used by the keys and tables of all tracks
+        std::size_t MemorySize() const;
+
+    private:
+        float AdjustTimeToFitRange(float inTime) const;
+        template<typename POSE>
+        float SampleTracks(POSE &outPose, float inTime, TransformTrack::Cursor *cursors, const BoneMask *mask) const;
+
+        friend CompressedClip CompressClip(const Clip &input, const CompressionSettings &settings);
+
+    private:
+        std::vector<Track> tracks;
+        std::string name;
+        float startTime;
+        float endTime;
+        float sampleRate;
+        std::uint32_t numSamples;
+        bool looping;
+        bool withinTolerance;
+
+    };
+
+    CompressedClip CompressClip(const Clip &input, const CompressionSettings &settings = {});
+
+    struct CompressionError
+    {
+        float position = 0.0f;
+        float rotation = 0.0f;  // radians
+        float scale = 0.0f;
+    };
+
+    // largest difference between the source clip and its compressed version, checked checkRate times per second
+    CompressionError MeasureCompressionError(const Clip &source, const CompressedClip &compressed, float checkRate = 120.0f);
+
     class Skeleton
     {
     public:
@@ -241,7 +482,7 @@ namespace RIS::Graphics::Animation
         using ClipType = FastClip;
         using Ptr = std::shared_ptr<Animation>;
 
-        Animation(std::vector<FastClip> &&clips);
+        Animation(std::vector<ClipType> &&clips);
 
         ClipType& GetByName(const std::string &clipName);
         const ClipType& GetByName(const std::string &clipName) const;
@@ -254,6 +495,8 @@ namespace RIS::Graphics::Animation
         ClipType& operator[](std::size_t index);
         const ClipType& operator[](std::size_t index) const;
 
+        std::size_t Size() const;
+
     private:
         std::vector<ClipType> clips;
         std::unordered_map<std::string, std::size_t> nameToIndex;
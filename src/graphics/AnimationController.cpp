@@ -0,0 +1,344 @@
+#include "graphics/AnimationController.hpp"
+#include "RisExcept.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace RIS::Graphics::Animation
+{
+    void BlendSpace::Add(std::size_t clip, float x)
+    {
+        entries.push_back({ clip, glm::vec2(x, 0.0f) });
+    }
+
+    void BlendSpace::Add(std::size_t clip, float x, float y)
+    {
+        entries.push_back({ clip, glm::vec2(x, y) });
+        is2D = true;
+    }
+
+    bool BlendSpace::Is2D() const
+    {
+        return is2D;
+    }
+
+    std::size_t BlendSpace::Size() const
+    {
+        return entries.size();
+    }
+
+    const BlendSpace::Entry& BlendSpace::operator[](std::size_t index) const
+    {
+        return entries.at(index);
+    }
+
+    void BlendSpace::GetWeights(const glm::vec2 &parameters, float *weights) const
+    {
+        std::size_t size = entries.size();
+        std::fill(weights, weights + size, 0.0f);
+        if(size == 0)
+            return;
+
+        if(!is2D)
+        {
+            // the closest entry on each side, outside of the range the last one on that side
+            std::size_t below = size, above = size;
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                float x = entries[i].position.x;
+                if(x <= parameters.x && (below == size || x > entries[below].position.x))
+                    below = i;
+                if(x >= parameters.x && (above == size || x < entries[above].position.x))
+                    above = i;
+            }
+
+            if(below == size || above == size || below == above)
+            {
+                weights[below == size ? above : below] = 1.0f;
+                return;
+            }
+
+            float t = (parameters.x - entries[below].position.x) / (entries[above].position.x - entries[below].position.x);
+            weights[below] = 1.0f - t;
+            weights[above] = t;
+            return;
+        }
+
+        // inverse squared distance, an entry right at the parameters gets everything
+        float total = 0.0f;
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            glm::vec2 delta = entries[i].position - parameters;
+            float distance = glm::dot(delta, delta);
+            if(distance < 1e-8f)
+            {
+                std::fill(weights, weights + size, 0.0f);
+                weights[i] = 1.0f;
+                return;
+            }
+            weights[i] = 1.0f / distance;
+            total += weights[i];
+        }
+        for(std::size_t i = 0; i < size; ++i)
+            weights[i] /= total;
+    }
+
+    AnimationController::AnimationController(Skeleton::Ptr skeleton, Animation::Ptr animation)
+        : skeleton(std::move(skeleton)), animation(std::move(animation))
+    {
+        if(!this->skeleton || !this->animation)
+            throw RISException("Animation controller needs a skeleton and an animation");
+
+        const Pose &rest = this->skeleton->GetRestPose();
+        if(!rest.IsTopological())
+            throw RISException("Animation controller needs a skeleton with parents before their children");
+
+        restPose.FromPose(rest);
+        pose = restPose;
+        for(auto &p : scratch)
+            p = pose;
+    }
+
+    void AnimationController::Play(const std::string &clipName, float fadeTime, float speed)
+    {
+        for(std::size_t i = 0; i < animation->Size(); ++i)
+        {
+            if(animation->GetByIndex(i).GetName() == clipName)
+            {
+                Play(i, fadeTime, speed);
+                return;
+            }
+        }
+        throw RISException(fmt::format("Animation has no clip {}", clipName));
+    }
+
+    void AnimationController::Play(std::size_t clip, float fadeTime, float speed)
+    {
+        if(clip >= animation->Size())
+            throw RISException(fmt::format("Animation has no clip {}", clip));
+
+        Motion &motion = StartMotion(fadeTime, speed);
+        motion.isBlendSpace = false;
+        motion.clip = clip;
+        // one cursor per track up front, so sampling never has to grow them
+        motion.cursors.resize(1);
+        motion.cursors[0].assign(animation->GetByIndex(clip).Size(), {});
+    }
+
+    void AnimationController::Play(const BlendSpace &blendSpace, float fadeTime, float speed)
+    {
+        for(std::size_t i = 0; i < blendSpace.Size(); ++i)
+        {
+            if(blendSpace[i].clip >= animation->Size())
+                throw RISException(fmt::format("Animation has no clip {}", blendSpace[i].clip));
+        }
+
+        Motion &motion = StartMotion(fadeTime, speed);
+        motion.isBlendSpace = true;
+        motion.blendSpace = blendSpace;
+        motion.weights.resize(blendSpace.Size());
+        motion.cursors.resize(blendSpace.Size());
+        for(std::size_t i = 0; i < blendSpace.Size(); ++i)
+            motion.cursors[i].assign(animation->GetByIndex(blendSpace[i].clip).Size(), {});
+    }
+
+    void AnimationController::SetParameters(const glm::vec2 &newParameters)
+    {
+        parameters = newParameters;
+    }
+
+    AnimationController::LayerId AnimationController::AddLayer(std::size_t clip, LayerMode mode, BoneMask &&mask, float weight)
+    {
+        if(clip >= animation->Size())
+            throw RISException(fmt::format("Animation has no clip {}", clip));
+
+        Layer layer = { clip, mode, std::move(mask), std::clamp(weight, 0.0f, 1.0f) };
+        layer.base = restPose;
+        layer.cursor.assign(animation->GetByIndex(clip).Size(), {});
+        if(mode == LayerMode::ADDITIVE)
+        {
+            const auto &additive = animation->GetByIndex(clip);
+            additive.Sample(layer.base, additive.GetStartTime());
+        }
+        layers.push_back(std::move(layer));
+        return layers.size() - 1;
+    }
+
+    void AnimationController::SetLayerWeight(LayerId layer, float weight)
+    {
+        layers.at(layer).weight = std::clamp(weight, 0.0f, 1.0f);
+    }
+
+    void AnimationController::SetLayerSpeed(LayerId layer, float speed)
+    {
+        layers.at(layer).speed = speed;
+    }
+
+    void AnimationController::Update(float deltaTime)
+    {
+        for(std::size_t i = 0; i < numMotions; ++i)
+            AdvanceMotion(motions[i], deltaTime);
+
+        // everything older than a motion that is faded in completely can't be seen anymore
+        std::size_t first = 0;
+        for(std::size_t i = 1; i < numMotions; ++i)
+        {
+            if(FadeWeight(motions[i]) >= 1.0f)
+                first = i;
+        }
+        if(first > 0)
+        {
+            std::rotate(std::begin(motions), std::begin(motions) + first, std::begin(motions) + numMotions);
+            numMotions -= first;
+        }
+
+        for(auto &layer : layers)
+            layer.time += deltaTime * layer.speed;
+
+        Evaluate();
+    }
+
+    const SoAPose& AnimationController::GetPose() const
+    {
+        return pose;
+    }
+
+    void AnimationController::GetSkinningPalette(std::vector<glm::mat4> &out) const
+    {
+        out.resize(pose.Size());
+        GetSkinningPalette(gsl::span<glm::mat4>(out));
+    }
+
+    void AnimationController::GetSkinningPalette(gsl::span<glm::mat4> out) const
+    {
+        pose.GetMatrixPalette(out);
+        const auto &invBindPose = skeleton->GetInvBindPose();
+        std::size_t size = std::min(pose.Size(), invBindPose.size());
+        for(std::size_t i = 0; i < size; ++i)
+            out[i] = out[i] * invBindPose[i];
+    }
+
+    std::size_t AnimationController::NumJoints() const
+    {
+        return pose.Size();
+    }
+
+    AnimationController::Motion& AnimationController::StartMotion(float fadeTime, float speed)
+    {
+        // out of slots, the oldest motion is cut off
+        if(numMotions == MAX_FADES)
+        {
+            std::rotate(std::begin(motions), std::begin(motions) + 1, std::end(motions));
+            numMotions--;
+        }
+
+        Motion &motion = motions[numMotions++];
+        motion.time = 0.0f;
+        motion.speed = speed;
+        motion.fadeTime = numMotions == 1 ? 0.0f : fadeTime;
+        motion.fadeElapsed = 0.0f;
+        return motion;
+    }
+
+    float AnimationController::FadeWeight(const Motion &motion) const
+    {
+        if(motion.fadeTime <= 0.0f)
+            return 1.0f;
+        return std::min(motion.fadeElapsed / motion.fadeTime, 1.0f);
+    }
+
+    void AnimationController::AdvanceMotion(Motion &motion, float deltaTime)
+    {
+        motion.fadeElapsed += deltaTime;
+        if(!motion.isBlendSpace)
+        {
+            // the clip wraps or clamps the time when it's sampled
+            motion.time += deltaTime * motion.speed;
+            return;
+        }
+
+        // all clips of a blend space run in sync, the phase moves with their weighted duration
+        motion.blendSpace.GetWeights(parameters, motion.weights.data());
+        float duration = 0.0f;
+        bool looping = true;
+        for(std::size_t i = 0; i < motion.blendSpace.Size(); ++i)
+        {
+            const auto &clip = animation->GetByIndex(motion.blendSpace[i].clip);
+            duration += motion.weights[i] * clip.GetDuration();
+            looping &= clip.GetLooping();
+        }
+        if(duration <= 0.0f)
+            return;
+
+        motion.time += deltaTime * motion.speed / duration;
+        motion.time = looping ? motion.time - std::floor(motion.time) : std::clamp(motion.time, 0.0f, 1.0f);
+    }
+
+    void AnimationController::EvaluateMotion(Motion &motion, SoAPose &out)
+    {
+        // copying into a pose that already has the right size doesn't allocate
+        out = restPose;
+        if(!motion.isBlendSpace)
+        {
+            motion.time = animation->GetByIndex(motion.clip).Sample(out, motion.time, motion.cursors[0]);
+            return;
+        }
+
+        SoAPose &clipPose = scratch[1];
+        float total = 0.0f;
+        for(std::size_t i = 0; i < motion.blendSpace.Size(); ++i)
+        {
+            float weight = motion.weights[i];
+            if(weight < MIN_WEIGHT)
+                continue;
+
+            const auto &clip = animation->GetByIndex(motion.blendSpace[i].clip);
+            float time = clip.GetStartTime() + motion.time * clip.GetDuration();
+            if(total == 0.0f)
+            {
+                clip.Sample(out, time, motion.cursors[i]);
+            }
+            else
+            {
+                clipPose = restPose;
+                clip.Sample(clipPose, time, motion.cursors[i]);
+                Blend(out, out, clipPose, weight / (total + weight));
+            }
+            total += weight;
+        }
+    }
+
+    void AnimationController::Evaluate()
+    {
+        if(numMotions == 0)
+        {
+            pose = restPose;
+        }
+        else
+        {
+            EvaluateMotion(motions[0], pose);
+            for(std::size_t i = 1; i < numMotions; ++i)
+            {
+                EvaluateMotion(motions[i], scratch[0]);
+                Blend(pose, pose, scratch[0], FadeWeight(motions[i]));
+            }
+        }
+
+        // layers only sample the joints in their mask
+        SoAPose &layerPose = scratch[0];
+        for(auto &layer : layers)
+        {
+            if(layer.weight < MIN_WEIGHT)
+                continue;
+
+            layerPose = restPose;
+            layer.time = animation->GetByIndex(layer.clip).Sample(layerPose, layer.time, layer.cursor, &layer.mask);
+            if(layer.mode == LayerMode::OVERRIDE)
+                Blend(pose, pose, layerPose, layer.weight, &layer.mask);
+            else
+                BlendAdditive(pose, pose, layerPose, layer.base, layer.weight, &layer.mask);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "graphics/Animation.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace RIS::Graphics::Animation
+{
+    // clips placed along one or two parameters, the clips around the current parameters get blended
+    class BlendSpace
+    {
+    public:
+        struct Entry
+        {
+            std::size_t clip;
+            glm::vec2 position;
+        };
+
+        void Add(std::size_t clip, float x);
+        void Add(std::size_t clip, float x, float y);
+
+        bool Is2D() const;
+        std::size_t Size() const;
+        const Entry& operator[](std::size_t index) const;
+
+        // weight of every entry for the given parameters, weights has room for Size() values and they sum up to 1
+        void GetWeights(const glm::vec2 &parameters, float *weights) const;
+
+    private:
+        std::vector<Entry> entries;
+        bool is2D = false;
+
+    };
+
+    // plays clips and blend spaces of one animation on a skeleton, fades between them
+    // and puts layers on top. all poses are allocated up front, updating doesn't allocate.
+    // poses are kept as SoAPose so blending and the palette work on four joints at a time,
+    // the skeleton has to list parents before their children
+    class AnimationController
+    {
+    public:
+        using Ptr = std::shared_ptr<AnimationController>;
+        using LayerId = std::size_t;
+
+        enum class LayerMode
+        {
+            OVERRIDE,
+            ADDITIVE
+        };
+
+        AnimationController(Skeleton::Ptr skeleton, Animation::Ptr animation);
+
+        // fades from everything that is playing to the new motion in fadeTime seconds
+        void Play(const std::string &clipName, float fadeTime = 0.0f, float speed = 1.0f);
+        void Play(std::size_t clip, float fadeTime = 0.0f, float speed = 1.0f);
+        void Play(const BlendSpace &blendSpace, float fadeTime = 0.0f, float speed = 1.0f);
+        void SetParameters(const glm::vec2 &parameters);
+
+        // additive clips are applied relative to their first frame, weights are clamped to [0, 1]
+        LayerId AddLayer(std::size_t clip, LayerMode mode, BoneMask &&mask = {}, float weight = 1.0f);
+        void SetLayerWeight(LayerId layer, float weight);
+        void SetLayerSpeed(LayerId layer, float speed);
+
+        void Update(float deltaTime);
+
+        const SoAPose& GetPose() const;
+        // model space matrices with the inverse bind pose applied, ready for skinning
+        void GetSkinningPalette(std::vector<glm::mat4> &out) const;
+        void GetSkinningPalette(gsl::span<glm::mat4> out) const;
+        std::size_t NumJoints() const;
+
+    private:
+        using Cursor = Animation::ClipType::Cursor;
+
+        static constexpr std::size_t MAX_FADES = 4;
+        static constexpr float MIN_WEIGHT = 0.001f;
+
+        struct Motion
+        {
+            std::size_t clip = 0;
+            BlendSpace blendSpace;
+            bool isBlendSpace = false;
+            float time = 0.0f;      // seconds for a clip, normalized phase for a blend space
+            float speed = 1.0f;
+            float fadeTime = 0.0f;
+            float fadeElapsed = 0.0f;
+            std::vector<float> weights;
+            std::vector<Cursor> cursors;
+        };
+
+        struct Layer
+        {
+            std::size_t clip;
+            LayerMode mode;
+            BoneMask mask;
+            float weight;
+            float speed = 1.0f;
+            float time = 0.0f;
+            SoAPose base;
+            Cursor cursor;
+        };
+
+        Motion& StartMotion(float fadeTime, float speed);
+        float FadeWeight(const Motion &motion) const;
+        void AdvanceMotion(Motion &motion, float deltaTime);
+        void EvaluateMotion(Motion &motion, SoAPose &out);
+        void Evaluate();
+
+    private:
+        Skeleton::Ptr skeleton;
+        Animation::Ptr animation;
+        glm::vec2 parameters = glm::vec2(0.0f);
+
+        // the newest motion is last, older ones are dropped as soon as it is faded in completely
+        std::array<Motion, MAX_FADES> motions;
+        std::size_t numMotions = 0;
+        std::vector<Layer> layers;
+
+        SoAPose restPose;
+        SoAPose pose;
+        std::array<SoAPose, 2> scratch;
+
+    };
+}
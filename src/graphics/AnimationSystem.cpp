@@ -0,0 +1,114 @@
+#include "graphics/AnimationSystem.hpp"
+#include "RisExcept.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+namespace RIS::Graphics::Animation
+{
+    AnimationSystem::AnimationSystem(WorkerPool &pool)
+        : pool(pool)
+    {}
+
+    AnimationSystem::InstanceId AnimationSystem::Add(AnimationController::Ptr controller)
+    {
+        if(!controller)
+            throw RISException("Animation system can't add an empty controller");
+
+        layoutDirty = true;
+        if(!freeIds.empty())
+        {
+            InstanceId id = freeIds.back();
+            freeIds.pop_back();
+            instances[id].controller = std::move(controller);
+            return id;
+        }
+
+        instances.push_back({ std::move(controller) });
+        return instances.size() - 1;
+    }
+
+    void AnimationSystem::Remove(InstanceId instance)
+    {
+        GetInstance(instance);
+        instances[instance] = {};
+        freeIds.push_back(instance);
+        layoutDirty = true;
+    }
+
+    AnimationController& AnimationSystem::Get(InstanceId instance)
+    {
+        return *GetInstance(instance).controller;
+    }
+
+    void AnimationSystem::Update(float deltaTime)
+    {
+        if(layoutDirty)
+            Layout();
+
+        // the calling thread takes batches too, exceptions of the workers are rethrown here
+        std::size_t numBatches = (active.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+        pool.ParallelFor(numBatches, [this, deltaTime](std::size_t batch){ UpdateBatch(batch, deltaTime); });
+    }
+
+    gsl::span<const glm::mat4> AnimationSystem::GetPalettes() const
+    {
+        return palettes;
+    }
+
+    std::size_t AnimationSystem::GetPaletteOffset(InstanceId instance) const
+    {
+        return GetInstance(instance).paletteOffset;
+    }
+
+    std::size_t AnimationSystem::NumInstances() const
+    {
+        return instances.size() - freeIds.size();
+    }
+
+    std::size_t AnimationSystem::NumWorkers() const
+    {
+        return pool.NumWorkers();
+    }
+
+    const AnimationSystem::Instance& AnimationSystem::GetInstance(InstanceId instance) const
+    {
+        if(instance >= instances.size() || !instances[instance].controller)
+            throw RISException(fmt::format("Animation system has no instance {}", instance));
+        return instances[instance];
+    }
+
+    void AnimationSystem::Layout()
+    {
+        // palettes are packed in id order, so the buffer can be uploaded as it is
+        active.clear();
+        std::size_t offset = 0;
+        for(InstanceId id = 0; id < instances.size(); ++id)
+        {
+            Instance &instance = instances[id];
+            if(!instance.controller)
+                continue;
+
+            instance.paletteOffset = offset;
+            instance.numJoints = instance.controller->NumJoints();
+            offset += instance.numJoints;
+            active.push_back(id);
+        }
+
+        palettes.resize(offset);
+        layoutDirty = false;
+    }
+
+    void AnimationSystem::UpdateBatch(std::size_t batch, float deltaTime)
+    {
+        std::size_t begin = batch * BATCH_SIZE;
+        std::size_t end = std::min(begin + BATCH_SIZE, active.size());
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            Instance &instance = instances[active[i]];
+            instance.controller->Update(deltaTime);
+            instance.controller->GetSkinningPalette(gsl::span<glm::mat4>(palettes.data() + instance.paletteOffset, instance.numJoints));
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "graphics/AnimationController.hpp"
+#include "misc/WorkerPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <gsl/span>
+
+#include <vector>
+#include <cstdint>
+
+namespace RIS::Graphics::Animation
+{
+    // updates every animated instance once per frame on the workers of a pool. the skinning palettes
+    // of all instances end up next to each other in one buffer, so they can be uploaded at once
+    class AnimationSystem
+    {
+    public:
+        using InstanceId = std::size_t;
+
+        AnimationSystem(WorkerPool &pool);
+
+        AnimationSystem(const AnimationSystem&) = delete;
+        AnimationSystem& operator=(const AnimationSystem&) = delete;
+        AnimationSystem(AnimationSystem&&) = delete;
+        AnimationSystem& operator=(AnimationSystem&&) = delete;
+
+        // a controller must only be added once, workers update instances concurrently
+        InstanceId Add(AnimationController::Ptr controller);
+        void Remove(InstanceId instance);
+        AnimationController& Get(InstanceId instance);
+
+        // advances all controllers and writes their palettes, returns when every instance is done
+        void Update(float deltaTime);
+
+        // valid until the next Update, the palette of an instance starts at its offset
+        gsl::span<const glm::mat4> GetPalettes() const;
+        std::size_t GetPaletteOffset(InstanceId instance) const;
+
+        std::size_t NumInstances() const;
+        std::size_t NumWorkers() const;
+
+    private:
+        // instances a thread takes at once, small enough to even out different skeletons
+        static constexpr std::size_t BATCH_SIZE = 4;
+
+        struct Instance
+        {
+            AnimationController::Ptr controller;
+            std::size_t paletteOffset = 0;
+            std::size_t numJoints = 0;
+        };
+
+        const Instance& GetInstance(InstanceId instance) const;
+        void Layout();
+        void UpdateBatch(std::size_t batch, float deltaTime);
+
+    private:
+        WorkerPool &pool;
+
+        std::vector<Instance> instances;    // removed instances keep their slot without a controller
+        std::vector<InstanceId> freeIds;
+        std::vector<InstanceId> active;
+        bool layoutDirty = false;
+
+        std::vector<glm::mat4> palettes;
+
+    };
+}
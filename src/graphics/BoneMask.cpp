@@ -0,0 +1,49 @@
+#include "graphics/Animation.hpp"
+
+#include <algorithm>
+
+namespace RIS::Graphics::Animation
+{
+    BoneMask::BoneMask(std::size_t numJoints, float weight)
+        : weights(numJoints, std::clamp(weight, 0.0f, 1.0f))
+    {}
+
+    void BoneMask::Set(std::size_t joint, float weight)
+    {
+        weights.at(joint) = std::clamp(weight, 0.0f, 1.0f);
+    }
+
+    void BoneMask::SetChain(const Pose &pose, std::size_t joint, float weight)
+    {
+        weight = std::clamp(weight, 0.0f, 1.0f);
+        std::size_t size = std::min(pose.Size(), weights.size());
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            for(int j = static_cast<int>(i); j >= 0; j = pose.GetParent(j))
+            {
+                if(static_cast<std::size_t>(j) == joint)
+                {
+                    weights[i] = weight;
+                    break;
+                }
+            }
+        }
+    }
+
+    float BoneMask::Get(std::size_t joint) const
+    {
+        if(weights.empty())
+            return 1.0f;
+        return joint < weights.size() ? weights[joint] : 0.0f;
+    }
+
+    bool BoneMask::Includes(std::size_t joint) const
+    {
+        return Get(joint) > 0.0f;
+    }
+
+    bool BoneMask::IsEmpty() const
+    {
+        return weights.empty();
+    }
+}
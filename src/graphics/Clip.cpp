@@ -13,17 +13,48 @@ namespace RIS::Graphics::Animation
 
     template<typename TRACK>
     float TClip<TRACK>::Sample(Pose &outPose, float time) const
+    {
+        return SampleTracks(outPose, time, nullptr, nullptr);
+    }
+
+    template<typename TRACK>
+    float TClip<TRACK>::Sample(Pose &outPose, float time, Cursor &cursor, const BoneMask *mask) const
+    {
+        if(cursor.size() != tracks.size())
+            cursor.resize(tracks.size());
+        return SampleTracks(outPose, time, cursor.data(), mask);
+    }
+
+    template<typename TRACK>
+    float TClip<TRACK>::Sample(SoAPose &outPose, float time) const
+    {
+        return SampleTracks(outPose, time, nullptr, nullptr);
+    }
+
+    template<typename TRACK>
+    float TClip<TRACK>::Sample(SoAPose &outPose, float time, Cursor &cursor, const BoneMask *mask) const
+    {
+        if(cursor.size() != tracks.size())
+            cursor.resize(tracks.size());
+        return SampleTracks(outPose, time, cursor.data(), mask);
+    }
+
+    template<typename TRACK>
+    template<typename POSE>
+    float TClip<TRACK>::SampleTracks(POSE &outPose, float time, typename TRACK::Cursor *cursors, const BoneMask *mask) const
     {
         if(GetDuration() == 0.0f)
             return 0.0f;
 
         time = AdjustTimeToFitRange(time);
 
-        for(auto it = tracks.begin(); it != tracks.end(); ++it)
+        for(std::size_t i = 0; i < tracks.size(); ++i)
         {
-            std::size_t id = (*it).GetId();
+            std::size_t id = tracks[i].GetId();
+            if(mask && !mask->Includes(id))
+                continue;
             Transform local = outPose.GetLocalTransform(id);
-            Transform animated = (*it).Sample(local, time, looping);
+            Transform animated = tracks[i].Sample(local, time, looping, cursors ? &cursors[i] : nullptr);
             outPose.SetLocalTransform(id, animated);
         }
         return time;
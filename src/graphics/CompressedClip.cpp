@@ -0,0 +1,750 @@
+#include "graphics/Animation.hpp"
+
+#include "misc/MathHelper.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace RIS::Graphics::Animation
+{
+    namespace
+    {
+        using PackedQuat = CompressedClip::PackedQuat;
+        using PackedVec3 = CompressedClip::PackedVec3;
+        using VectorStream = CompressedClip::VectorStream;
+        using RotationStream = CompressedClip::RotationStream;
+        using Range = CompressedClip::Range;
+
+        constexpr float SQRT2 = 1.41421356f;
+        constexpr float QUAT_RANGE = 32767.0f;
+        constexpr float VEC_RANGE = 65535.0f;
+        // a key closer to a sample than this, in samples, is on the sample
+        constexpr float ON_SAMPLE = 1e-3f;
+        // checks between two samples of a cubic track
+        constexpr int CUBIC_CHECKS = 4;
+
+        PackedQuat PackQuat(glm::quat q)
+        {
+            q = glm::normalize(q);
+            float c[4] = { q.x, q.y, q.z, q.w };
+            int largest = 0;
+            for(int i = 1; i < 4; ++i)
+            {
+                if(std::abs(c[i]) > std::abs(c[largest]))
+                    largest = i;
+            }
+
+            // q and -q are the same rotation, flip it so the dropped component is positive
+            float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+            std::uint64_t bits = static_cast<std::uint64_t>(largest) << 45;
+            int shift = 30;
+            for(int i = 0; i < 4; ++i)
+            {
+                if(i == largest)
+                    continue;
+                // the other three are never larger than 1 / sqrt(2)
+                float v = Clamp(-1.0f, 1.0f, c[i] * sign * SQRT2);
+                bits |= static_cast<std::uint64_t>(std::lround((v * 0.5f + 0.5f) * QUAT_RANGE)) << shift;
+                shift -= 15;
+            }
+            return { { static_cast<std::uint16_t>(bits >> 32), static_cast<std::uint16_t>(bits >> 16), static_cast<std::uint16_t>(bits) } };
+        }
+
+        glm::quat UnpackQuat(const PackedQuat &packed)
+        {
+            std::uint64_t bits = (static_cast<std::uint64_t>(packed.bits[0]) << 32) | (static_cast<std::uint64_t>(packed.bits[1]) << 16) | packed.bits[2];
+            int largest = static_cast<int>((bits >> 45) & 3);
+
+            float c[4];
+            float sum = 0.0f;
+            int shift = 30;
+            for(int i = 0; i < 4; ++i)
+            {
+                if(i == largest)
+                    continue;
+                float v = static_cast<float>((bits >> shift) & 0x7FFF) / QUAT_RANGE;
+                c[i] = (v * 2.0f - 1.0f) / SQRT2;
+                sum += c[i] * c[i];
+                shift -= 15;
+            }
+            c[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+            return glm::normalize(glm::quat(c[3], c[0], c[1], c[2]));
+        }
+
+        PackedVec3 PackVec3(const glm::vec3 &v, const glm::vec3 &min, const glm::vec3 &extent)
+        {
+            PackedVec3 packed;
+            for(int i = 0; i < 3; ++i)
+            {
+                float t = extent[i] > 0.0f ? Clamp(0.0f, 1.0f, (v[i] - min[i]) / extent[i]) : 0.0f;
+                packed.bits[i] = static_cast<std::uint16_t>(std::lround(t * VEC_RANGE));
+            }
+            return packed;
+        }
+
+        glm::vec3 UnpackVec3(const PackedVec3 &packed, const glm::vec3 &min, const glm::vec3 &extent)
+        {
+            return min + extent * (glm::vec3(packed.bits[0], packed.bits[1], packed.bits[2]) / VEC_RANGE);
+        }
+
+        glm::quat Nlerp(const glm::quat &a, glm::quat b, float t)
+        {
+            if(glm::dot(a, b) < 0.0f)
+                b = -b;
+            return glm::normalize(glm::lerp(a, b, t));
+        }
+
+        // angle of the rotation from a to b. acos of the dot product only resolves about 7e-4 radians
+        // near 0 in floats, the half angle between the two unit quaternions stays exact for small angles
+        float AngleBetween(const glm::quat &a, glm::quat b)
+        {
+            glm::quat na = glm::normalize(a);
+            b = glm::normalize(b);
+            if(glm::dot(na, b) < 0.0f)
+                b = -b;
+            return 4.0f * std::atan2(glm::length(na - b), glm::length(na + b));
+        }
+
+        struct KeyPair
+        {
+            std::size_t first;
+            std::size_t second;
+            float t;
+        };
+
+        // the keys around a (fractional) sample index, the cursor skips the search while playing forward
+        template<typename KEY>
+        KeyPair FindKeys(const CompressedClip::Stream<KEY> &stream, float sample, TrackCursor *cursor)
+        {
+            std::size_t numKeys = stream.keys.size();
+            if(numKeys == 1)
+                return { 0, 0, 0.0f };
+
+            KeyPair pair;
+            if(stream.samples.empty())
+            {
+                float clamped = Clamp(0.0f, static_cast<float>(numKeys - 1), sample);
+                pair.first = std::min(static_cast<std::size_t>(clamped), numKeys - 2);
+                pair.second = pair.first + 1;
+                pair.t = clamped - static_cast<float>(pair.first);
+            }
+            else
+            {
+                const auto &samples = stream.samples;
+                int frame = cursor ? cursor->frame : -1;
+                if(frame >= 0 && frame + 1 < static_cast<int>(numKeys) && samples[frame] <= sample && sample < samples[frame + 1])
+                {
+                    pair.first = frame;
+                }
+                else if(frame >= 0 && frame + 2 < static_cast<int>(numKeys) && samples[frame + 1] <= sample && sample < samples[frame + 2])
+                {
+                    pair.first = frame + 1;
+                }
+                else
+                {
+                    auto it = std::upper_bound(std::begin(samples), std::end(samples), sample, [](float s, std::uint16_t key){ return s < key; });
+                    std::ptrdiff_t index = std::distance(std::begin(samples), it) - 1;
+                    pair.first = static_cast<std::size_t>(Clamp<std::ptrdiff_t>(0, static_cast<std::ptrdiff_t>(numKeys) - 2, index));
+                }
+                if(cursor)
+                    cursor->frame = static_cast<int>(pair.first);
+                pair.second = pair.first + 1;
+                float a = stream.samples[pair.first];
+                float b = stream.samples[pair.second];
+                pair.t = Clamp(0.0f, 1.0f, (sample - a) / (b - a));
+            }
+
+            if(stream.step)
+                pair.t = pair.t >= 1.0f ? 1.0f : 0.0f;
+            return pair;
+        }
+
+        template<typename KEY>
+        std::size_t KeySample(const CompressedClip::Stream<KEY> &stream, std::size_t key)
+        {
+            return stream.samples.empty() ? key : stream.samples[key];
+        }
+
+        glm::vec3 UnpackKey(const VectorStream &stream, std::size_t key)
+        {
+            auto range = std::begin(stream.ranges);
+            if(stream.ranges.size() > 1)
+            {
+                std::size_t sample = KeySample(stream, key);
+                range = std::upper_bound(std::begin(stream.ranges), std::end(stream.ranges), sample, [](std::size_t s, const Range &r){ return s < r.firstSample; }) - 1;
+            }
+            return UnpackVec3(stream.keys[key], range->min, range->extent);
+        }
+
+        glm::vec3 SampleStream(const VectorStream &stream, float sample, TrackCursor *cursor)
+        {
+            KeyPair keys = FindKeys(stream, sample, cursor);
+            return Lerp(UnpackKey(stream, keys.first), UnpackKey(stream, keys.second), keys.t);
+        }
+
+        glm::quat SampleStream(const RotationStream &stream, float sample, TrackCursor *cursor)
+        {
+            KeyPair keys = FindKeys(stream, sample, cursor);
+            return Nlerp(UnpackQuat(stream.keys[keys.first]), UnpackQuat(stream.keys[keys.second]), keys.t);
+        }
+
+        // the source at a fractional sample index between two samples
+        template<typename VALUE>
+        struct Check
+        {
+            float sample;
+            VALUE value;
+        };
+
+        // indices of the samples that have to stay keys so interpolating between them stays within tolerance
+        // of the source, at the samples and at the checks between them. always keeps the first and the last
+        // sample. fits is false if even two neighbouring samples can't rebuild the checks between them
+        template<typename VALUE, typename LERP, typename ERROR>
+        std::vector<std::uint16_t> ReduceKeys(const std::vector<VALUE> &decoded, const std::vector<VALUE> &source, const std::vector<Check<VALUE>> &checks,
+            bool step, float tolerance, LERP &&lerp, ERROR &&error, bool &fits)
+        {
+            std::size_t numSamples = decoded.size();
+            auto segmentFits = [&](std::size_t first, std::size_t last)
+            {
+                // the same t as FindKeys
+                auto interpolate = [&](float sample)
+                {
+                    float t = step ? 0.0f : (sample - static_cast<float>(first)) / static_cast<float>(last - first);
+                    return lerp(decoded[first], decoded[last], t);
+                };
+                for(std::size_t k = first + 1; k < last; ++k)
+                {
+                    if(error(interpolate(static_cast<float>(k)), source[k]) > tolerance)
+                        return false;
+                }
+                auto check = std::upper_bound(std::begin(checks), std::end(checks), static_cast<float>(first), [](float s, const Check<VALUE> &c){ return s < c.sample; });
+                for(; check != std::end(checks) && check->sample < static_cast<float>(last); ++check)
+                {
+                    if(error(interpolate(check->sample), check->value) > tolerance)
+                        return false;
+                }
+                return true;
+            };
+
+            std::vector<std::uint16_t> kept = { 0 };
+            std::size_t first = 0;
+            while(first + 1 < numSamples)
+            {
+                std::size_t last = first + 1;
+                if(!segmentFits(first, last))
+                    fits = false;
+                while(last + 1 < numSamples && segmentFits(first, last + 1))
+                    ++last;
+                kept.push_back(static_cast<std::uint16_t>(last));
+                first = last;
+            }
+
+            // the whole channel is one value
+            auto fitsFront = [&](const VALUE &value){ return error(decoded.front(), value) <= tolerance; };
+            if(std::all_of(std::begin(source), std::end(source), fitsFront) && std::all_of(std::begin(checks), std::end(checks), [&](const Check<VALUE> &c){ return fitsFront(c.value); }))
+            {
+                kept.resize(1);
+                fits = true;
+            }
+            return kept;
+        }
+
+        // uses the sample indices only if they make the stream smaller
+        template<typename KEY>
+        void StoreKeys(CompressedClip::Stream<KEY> &stream, const std::vector<KEY> &packed, const std::vector<std::uint16_t> &kept)
+        {
+            if(kept.size() == 1)
+            {
+                stream.keys = { packed.front() };
+                return;
+            }
+
+            std::size_t reducedSize = kept.size() * (sizeof(KEY) + sizeof(std::uint16_t));
+            if(reducedSize >= packed.size() * sizeof(KEY))
+            {
+                stream.keys = packed;
+                return;
+            }
+
+            stream.samples = kept;
+            stream.keys.reserve(kept.size());
+            for(std::uint16_t sample : kept)
+                stream.keys.push_back(packed[sample]);
+        }
+
+        // the samples a clip is resampled at
+        struct Grid
+        {
+            float startTime = 0.0f;
+            float sampleRate = 0.0f;
+            bool looping = false;
+            std::vector<float> times;
+        };
+
+        float SamplePosition(const Grid &grid, float time)
+        {
+            return (time - grid.startTime) * grid.sampleRate;
+        }
+
+        // every time a key of the track plays in the clip, a track shorter than a looping clip repeats its keys
+        template<typename TRACK, typename F>
+        void ForEachKeyTime(const TRACK &track, float startTime, float endTime, bool looping, F &&f)
+        {
+            if(track.Size() <= 1)
+                return;
+
+            float duration = track.GetEndTime() - track.GetStartTime();
+            for(std::size_t k = 0; k < track.Size(); ++k)
+            {
+                float time = track[k].time;
+                if(!looping || duration <= 0.0f)
+                {
+                    if(time >= startTime && time <= endTime)
+                        f(time);
+                    continue;
+                }
+
+                float first = time - std::floor((time - startTime) / duration) * duration;
+                for(int repeat = 0; first + static_cast<float>(repeat) * duration <= endTime; ++repeat)
+                {
+                    float repeated = first + static_cast<float>(repeat) * duration;
+                    if(repeated >= startTime)
+                        f(repeated);
+                }
+            }
+        }
+
+        // the source between the samples. linear and constant tracks only change direction or jump at their keys,
+        // cubic tracks can bulge out anywhere so they are also checked a few times between every two samples
+        template<typename TRACK, typename VALUE>
+        std::vector<Check<VALUE>> BetweenChecks(const TRACK &track, const Grid &grid, float endTime)
+        {
+            std::vector<Check<VALUE>> checks;
+            float last = static_cast<float>(grid.times.size() - 1);
+            ForEachKeyTime(track, grid.startTime, endTime, grid.looping, [&](float time)
+            {
+                float sample = SamplePosition(grid, time);
+                if(sample > 0.0f && sample < last && std::abs(sample - std::round(sample)) > ON_SAMPLE)
+                    checks.push_back({ sample, track.Sample(time, grid.looping) });
+            });
+
+            if(track.GetInterpolation() == Interpolation::CUBIC && grid.sampleRate > 0.0f)
+            {
+                for(std::size_t i = 0; i + 1 < grid.times.size(); ++i)
+                {
+                    for(int j = 1; j < CUBIC_CHECKS; ++j)
+                    {
+                        float sample = static_cast<float>(i) + static_cast<float>(j) / static_cast<float>(CUBIC_CHECKS);
+                        checks.push_back({ sample, track.Sample(grid.startTime + sample / grid.sampleRate, grid.looping) });
+                    }
+                }
+            }
+
+            std::sort(std::begin(checks), std::end(checks), [](const Check<VALUE> &a, const Check<VALUE> &b){ return a.sample < b.sample; });
+            return checks;
+        }
+
+        // starts a new range where the values spread further than 65535 times the tolerance,
+        // so rounding to 16 bits is off by at most half the tolerance per component
+        std::vector<Range> QuantizationRanges(const std::vector<glm::vec3> &source, float tolerance)
+        {
+            float maxExtent = tolerance * VEC_RANGE;
+            std::vector<Range> ranges(1);
+            ranges[0].min = source.front();
+            glm::vec3 max = source.front();
+            for(std::size_t i = 1; i < source.size(); ++i)
+            {
+                glm::vec3 min = glm::min(ranges.back().min, source[i]);
+                glm::vec3 spread = glm::max(max, source[i]) - min;
+                if(tolerance > 0.0f && std::max({ spread.x, spread.y, spread.z }) > maxExtent)
+                {
+                    ranges.back().extent = max - ranges.back().min;
+                    ranges.push_back({ source[i], glm::vec3(0.0f), static_cast<std::uint16_t>(i) });
+                    max = source[i];
+                    continue;
+                }
+                ranges.back().min = min;
+                max = glm::max(max, source[i]);
+            }
+            ranges.back().extent = max - ranges.back().min;
+            return ranges;
+        }
+
+        // drops the ranges that lost all of their keys to the reduction
+        void PruneRanges(VectorStream &stream)
+        {
+            std::vector<Range> used;
+            std::size_t key = 0;
+            for(std::size_t r = 0; r < stream.ranges.size(); ++r)
+            {
+                std::size_t end = r + 1 < stream.ranges.size() ? stream.ranges[r + 1].firstSample : std::numeric_limits<std::size_t>::max();
+                bool hasKeys = false;
+                for(; key < stream.keys.size() && KeySample(stream, key) < end; ++key)
+                    hasKeys = true;
+                if(hasKeys)
+                    used.push_back(stream.ranges[r]);
+            }
+            stream.ranges = std::move(used);
+        }
+
+        // false if the channel doesn't stay within tolerance between two of the samples
+        template<typename TRACK>
+        bool CompressVectorTrack(VectorStream &stream, const TRACK &track, const Grid &grid, float endTime, float tolerance)
+        {
+            if(track.Size() <= 1)
+                return true;
+
+            const auto &times = grid.times;
+            std::vector<glm::vec3> source(times.size());
+            for(std::size_t i = 0; i < times.size(); ++i)
+                source[i] = track.Sample(times[i], grid.looping);
+            stream.ranges = QuantizationRanges(source, tolerance);
+            stream.step = track.GetInterpolation() == Interpolation::CONSTANT;
+
+            std::vector<PackedVec3> packed(source.size());
+            std::vector<glm::vec3> decoded(source.size());
+            std::size_t range = 0;
+            for(std::size_t i = 0; i < source.size(); ++i)
+            {
+                if(range + 1 < stream.ranges.size() && stream.ranges[range + 1].firstSample == i)
+                    ++range;
+                const Range &r = stream.ranges[range];
+                packed[i] = PackVec3(source[i], r.min, r.extent);
+                decoded[i] = UnpackVec3(packed[i], r.min, r.extent);
+            }
+
+            bool fits = true;
+            auto kept = ReduceKeys(decoded, source, BetweenChecks<TRACK, glm::vec3>(track, grid, endTime), stream.step, tolerance,
+                [](const glm::vec3 &a, const glm::vec3 &b, float t){ return Lerp(a, b, t); },
+                [](const glm::vec3 &a, const glm::vec3 &b){ return glm::length(a - b); }, fits);
+            StoreKeys(stream, packed, kept);
+            PruneRanges(stream);
+            return fits;
+        }
+
+        template<typename TRACK>
+        bool CompressRotationTrack(RotationStream &stream, const TRACK &track, const Grid &grid, float endTime, float tolerance)
+        {
+            if(track.Size() <= 1)
+                return true;
+
+            const auto &times = grid.times;
+            std::vector<glm::quat> source(times.size());
+            std::vector<PackedQuat> packed(times.size());
+            std::vector<glm::quat> decoded(times.size());
+            for(std::size_t i = 0; i < times.size(); ++i)
+            {
+                source[i] = track.Sample(times[i], grid.looping);
+                packed[i] = PackQuat(source[i]);
+                decoded[i] = UnpackQuat(packed[i]);
+            }
+            stream.step = track.GetInterpolation() == Interpolation::CONSTANT;
+
+            bool fits = true;
+            auto kept = ReduceKeys(decoded, source, BetweenChecks<TRACK, glm::quat>(track, grid, endTime), stream.step, tolerance, Nlerp, AngleBetween, fits);
+            StoreKeys(stream, packed, kept);
+            return fits;
+        }
+
+        template<typename KEY>
+        std::size_t StreamSize(const CompressedClip::Stream<KEY> &stream)
+        {
+            return stream.keys.size() * sizeof(KEY) + stream.samples.size() * sizeof(std::uint16_t);
+        }
+
+        std::size_t StreamSize(const VectorStream &stream)
+        {
+            return StreamSize<PackedVec3>(stream) + stream.ranges.size() * sizeof(Range);
+        }
+
+        // time of sample index out of count evenly spread over the clip. a looping clip wraps around
+        // before it reaches its end, so its last sample is the value just before the end
+        float SampleTime(float startTime, float duration, std::size_t index, std::size_t count, bool looping)
+        {
+            if(count <= 1)
+                return startTime;
+            if(looping && index == count - 1)
+                return std::nextafter(startTime + duration, startTime);
+            return startTime + duration * (static_cast<float>(index) / static_cast<float>(count - 1));
+        }
+
+        // the sample index of a key has to fit in 16 bits
+        std::size_t Intervals(float duration, float sampleRate)
+        {
+            return static_cast<std::size_t>(Clamp(0.0f, 65535.0f, std::ceil(duration * sampleRate)));
+        }
+
+        Grid MakeGrid(float startTime, float endTime, std::size_t intervals, bool looping)
+        {
+            float duration = endTime - startTime;
+            std::size_t numSamples = intervals + 1;
+
+            Grid grid;
+            grid.startTime = startTime;
+            grid.sampleRate = duration > 0.0f ? static_cast<float>(intervals) / duration : 0.0f;
+            grid.looping = looping;
+            grid.times.resize(numSamples);
+            for(std::size_t i = 0; i < numSamples; ++i)
+                grid.times[i] = SampleTime(startTime, duration, i, numSamples, looping);
+            return grid;
+        }
+
+        // every time a key of the clip plays
+        std::vector<float> KeyTimes(const Clip &input, float startTime, float endTime, bool looping)
+        {
+            std::vector<float> times;
+            auto add = [&times](float time){ times.push_back(time); };
+            for(std::size_t i = 0; i < input.Size(); ++i)
+            {
+                const TransformTrack &track = input[input.GetIdAtIndex(i)];
+                ForEachKeyTime(track.GetPositionTrack(), startTime, endTime, looping, add);
+                ForEachKeyTime(track.GetRotationTrack(), startTime, endTime, looping, add);
+                ForEachKeyTime(track.GetScaleTrack(), startTime, endTime, looping, add);
+            }
+            std::sort(std::begin(times), std::end(times));
+            times.erase(std::unique(std::begin(times), std::end(times)), std::end(times));
+            return times;
+        }
+
+        bool OnSamples(const Grid &grid, const std::vector<float> &keyTimes)
+        {
+            return std::all_of(std::begin(keyTimes), std::end(keyTimes), [&grid](float time)
+            {
+                float sample = SamplePosition(grid, time);
+                return std::abs(sample - std::round(sample)) <= ON_SAMPLE;
+            });
+        }
+
+        // moves the samples that are only rounding away from a key onto it, so a step at the key is sampled after it
+        void SnapToKeys(Grid &grid, const std::vector<float> &keyTimes)
+        {
+            std::size_t numSamples = grid.times.size();
+            for(float time : keyTimes)
+            {
+                float sample = SamplePosition(grid, time);
+                float nearest = std::round(sample);
+                if(std::abs(sample - nearest) > ON_SAMPLE || nearest < 1.0f)
+                    continue;
+
+                // the last sample of a looping clip stays just before the end
+                std::size_t index = static_cast<std::size_t>(nearest);
+                if(index < numSamples && !(grid.looping && index == numSamples - 1))
+                    grid.times[index] = std::max(grid.times[index], time);
+            }
+        }
+    }
+
+    CompressedClip::CompressedClip()
+        : name("No Name"), startTime(0.0f), endTime(0.0f), sampleRate(0.0f), numSamples(1), looping(true), withinTolerance(true)
+    {}
+
+    float CompressedClip::Sample(Pose &outPose, float time) const
+    {
+        return SampleTracks(outPose, time, nullptr, nullptr);
+    }
+
+    float CompressedClip::Sample(Pose &outPose, float time, Cursor &cursor, const BoneMask *mask) const
+    {
+        if(cursor.size() != tracks.size())
+            cursor.resize(tracks.size());
+        return SampleTracks(outPose, time, cursor.data(), mask);
+    }
+
+    float CompressedClip::Sample(SoAPose &outPose, float time) const
+    {
+        return SampleTracks(outPose, time, nullptr, nullptr);
+    }
+
+    float CompressedClip::Sample(SoAPose &outPose, float time, Cursor &cursor, const BoneMask *mask) const
+    {
+        if(cursor.size() != tracks.size())
+            cursor.resize(tracks.size());
+        return SampleTracks(outPose, time, cursor.data(), mask);
+    }
+
+    template<typename POSE>
+    float CompressedClip::SampleTracks(POSE &outPose, float time, TransformTrack::Cursor *cursors, const BoneMask *mask) const
+    {
+        if(GetDuration() == 0.0f)
+            return 0.0f;
+
+        time = AdjustTimeToFitRange(time);
+
+        for(std::size_t i = 0; i < tracks.size(); ++i)
+        {
+            std::size_t id = tracks[i].id;
+            if(mask && !mask->Includes(id))
+                continue;
+            Transform local = outPose.GetLocalTransform(id);
+            outPose.SetLocalTransform(id, SampleTrack(i, local, time, cursors ? &cursors[i] : nullptr));
+        }
+        return time;
+    }
+
+    Transform CompressedClip::SampleTrack(std::size_t index, const Transform &ref, float time, TransformTrack::Cursor *cursor) const
+    {
+        const Track &track = tracks.at(index);
+        float sample = (time - startTime) * sampleRate;
+
+        Transform result = ref;
+        if(!track.position.keys.empty())
+            result.position = SampleStream(track.position, sample, cursor ? &cursor->position : nullptr);
+        if(!track.rotation.keys.empty())
+            result.rotation = SampleStream(track.rotation, sample, cursor ? &cursor->rotation : nullptr);
+        if(!track.scale.keys.empty())
+            result.scale = SampleStream(track.scale, sample, cursor ? &cursor->scale : nullptr);
+        return result;
+    }
+
+    float CompressedClip::AdjustTimeToFitRange(float inTime) const
+    {
+        if(looping)
+        {
+            float duration = endTime - startTime;
+            if(duration <= 0)
+                return 0.0f;
+            inTime = std::fmod(inTime - startTime, duration);
+            if(inTime < 0.0f)
+                inTime += duration;
+            inTime += startTime;
+        }
+        else
+        {
+            inTime = Clamp(startTime, endTime, inTime);
+        }
+        return inTime;
+    }
+
+    std::size_t CompressedClip::GetIdAtIndex(std::size_t index) const
+    {
+        return tracks.at(index).id;
+    }
+
+    std::size_t CompressedClip::Size() const
+    {
+        return tracks.size();
+    }
+
+    const std::string& CompressedClip::GetName() const
+    {
+        return name;
+    }
+
+    float CompressedClip::GetDuration() const
+    {
+        return endTime - startTime;
+    }
+
+    float CompressedClip::GetStartTime() const
+    {
+        return startTime;
+    }
+
+    float CompressedClip::GetEndTime() const
+    {
+        return endTime;
+    }
+
+    bool CompressedClip::GetLooping() const
+    {
+        return looping;
+    }
+
+    void CompressedClip::SetLooping(bool newLooping)
+    {
+        looping = newLooping;
+    }
+
+    bool CompressedClip::WithinTolerance() const
+    {
+        return withinTolerance;
+    }
+
+    std::size_t CompressedClip::MemorySize() const
+    {
+        std::size_t size = tracks.size() * sizeof(Track);
+        for(const auto &track : tracks)
+            size += StreamSize(track.position) + StreamSize(track.rotation) + StreamSize(track.scale);
+        return size;
+    }
+
+    CompressedClip CompressClip(const Clip &input, const CompressionSettings &settings)
+    {
+        CompressedClip result;
+        result.name = input.GetName();
+        result.looping = input.GetLooping();
+        result.startTime = input.GetStartTime();
+        result.endTime = std::max(input.GetEndTime(), input.GetStartTime());
+
+        // keys between the samples lose their corners and steps, so the grid is the first one from sampleRate
+        // up to maxSampleRate that puts every key on a sample. it gets finer while some channel doesn't stay
+        // within its tolerance between two samples, WithinTolerance reports clips that don't fit even then
+        float duration = result.GetDuration();
+        std::vector<float> keyTimes = KeyTimes(input, result.startTime, result.endTime, result.looping);
+        std::size_t minIntervals = Intervals(duration, settings.sampleRate);
+        std::size_t maxIntervals = std::max(Intervals(duration, settings.maxSampleRate), minIntervals);
+        std::size_t intervals = minIntervals;
+        for(std::size_t n = minIntervals; n <= maxIntervals; ++n)
+        {
+            Grid grid;
+            grid.startTime = result.startTime;
+            grid.sampleRate = duration > 0.0f ? static_cast<float>(n) / duration : 0.0f;
+            if(OnSamples(grid, keyTimes))
+            {
+                intervals = n;
+                break;
+            }
+        }
+
+        std::size_t size = input.Size();
+        for(std::size_t step = intervals;; intervals += step)
+        {
+            Grid grid = MakeGrid(result.startTime, result.endTime, intervals, result.looping);
+            SnapToKeys(grid, keyTimes);
+            result.numSamples = static_cast<std::uint32_t>(grid.times.size());
+            result.sampleRate = grid.sampleRate;
+
+            bool fits = true;
+            result.tracks.assign(size, {});
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                std::size_t joint = input.GetIdAtIndex(i);
+                const TransformTrack &track = input[joint];
+                CompressedClip::Track &compressed = result.tracks[i];
+                compressed.id = static_cast<unsigned int>(joint);
+                fits &= CompressVectorTrack(compressed.position, track.GetPositionTrack(), grid, result.endTime, settings.positionTolerance);
+                fits &= CompressRotationTrack(compressed.rotation, track.GetRotationTrack(), grid, result.endTime, settings.rotationTolerance);
+                fits &= CompressVectorTrack(compressed.scale, track.GetScaleTrack(), grid, result.endTime, settings.scaleTolerance);
+            }
+
+            result.withinTolerance = fits;
+            if(fits || step == 0 || intervals + step > maxIntervals)
+                break;
+        }
+        return result;
+    }
+
+    CompressionError MeasureCompressionError(const Clip &source, const CompressedClip &compressed, float checkRate)
+    {
+        CompressionError error;
+        float duration = compressed.GetDuration();
+        std::size_t numChecks = static_cast<std::size_t>(std::ceil(std::max(duration, 0.0f) * checkRate)) + 1;
+
+        for(std::size_t i = 0; i < compressed.Size(); ++i)
+        {
+            const TransformTrack &track = source[compressed.GetIdAtIndex(i)];
+            for(std::size_t c = 0; c < numChecks; ++c)
+            {
+                float time = SampleTime(compressed.GetStartTime(), duration, c, numChecks, source.GetLooping());
+                Transform expected = track.Sample(Transform(), time, source.GetLooping());
+                Transform actual = compressed.SampleTrack(i, Transform(), time);
+
+                error.position = std::max(error.position, glm::length(expected.position - actual.position));
+                error.rotation = std::max(error.rotation, AngleBetween(expected.rotation, actual.rotation));
+                error.scale = std::max(error.scale, glm::length(expected.scale - actual.scale));
+            }
+        }
+        return error;
+    }
+}
@@ -1,36 +1,34 @@
 #include "graphics/Animation.hpp"
 
 #include <cmath>
+#include <algorithm>
 
 namespace RIS::Graphics::Animation
 {
     template<typename T, unsigned int N>
     void FastTrack<T, N>::UpdateIndexLookupTable()
     {
+        sampledFrames.clear();
         std::size_t numFrames = this->frames.size();
         if(numFrames <= 1)
             return;
 
-        float duration = this->GetEndTime() - this->GetStartTime();
-        std::size_t numSamples = static_cast<std::size_t>(duration * SAMPLES_PER_SECOND);
-        sampledFrames.resize(numSamples);
+        float startTime = this->GetStartTime();
+        float duration = this->GetEndTime() - startTime;
+        if(duration <= 0.0f)
+            return;
 
-        for(std::size_t i = 0; i < numSamples; ++i)
-        {
-            float t = static_cast<float>(i) / static_cast<float>(numSamples - 1);
-            float time = t * duration + this->GetStartTime();
+        // one entry per sample from start to end, both included. the samples and the frames
+        // are both sorted by time so a single walk over the frames fills the whole table
+        std::size_t numSamples = std::max<std::size_t>(static_cast<std::size_t>(duration * SAMPLES_PER_SECOND), 1);
+        sampledFrames.resize(numSamples + 1);
 
-            std::size_t frameIndex = 0;
-            for(std::size_t j = numFrames - 1; j >= 0; --j)
-            {
-                if(time >= this->frames.at(j).time)
-                {
-                    frameIndex = j;
-                    if(frameIndex >= numFrames - 2)
-                        frameIndex = numFrames - 2;
-                    break;
-                }
-            }
+        std::size_t frameIndex = 0;
+        for(std::size_t i = 0; i <= numSamples; ++i)
+        {
+            float time = startTime + duration * (static_cast<float>(i) / static_cast<float>(numSamples));
+            while(frameIndex + 2 < numFrames && this->frames[frameIndex + 1].time <= time)
+                ++frameIndex;
             sampledFrames[i] = frameIndex;
         }
     }
@@ -41,6 +39,8 @@ namespace RIS::Graphics::Animation
         std::size_t size = this->frames.size();
         if(size <= 1)
             return -1;
+        if(sampledFrames.empty())
+            return Track<T, N>::FrameIndex(time, looping);
 
         if(looping)
         {
@@ -63,12 +63,17 @@ namespace RIS::Graphics::Animation
         
         float duration = this->GetEndTime() - this->GetStartTime();
         float t = (time - this->GetStartTime()) / duration;
-
-        std::size_t numSamples = static_cast<std::size_t>(duration * SAMPLES_PER_SECOND);
-        std::size_t index = static_cast<std::size_t>(t * numSamples);
-        if(index >= sampledFrames.size())
+        if(!(t >= 0.0f))
             return -1;
-        return static_cast<int>(sampledFrames.at(index));
+
+        std::size_t numSamples = sampledFrames.size() - 1;
+        std::size_t index = std::min(static_cast<std::size_t>(t * numSamples), numSamples);
+        std::size_t frameIndex = sampledFrames[index];
+
+        // a key can lie between two samples, step to the one that actually starts the interval
+        while(frameIndex + 2 < size && this->frames[frameIndex + 1].time <= time)
+            ++frameIndex;
+        return static_cast<int>(frameIndex);
     }
 
     template class FastTrack<float, 1>;
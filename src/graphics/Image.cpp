@@ -6,7 +6,7 @@
 
 namespace RIS::Graphics
 {
-    Image::Image(const std::vector<std::byte> &data)
+    Image::Image(gsl::span<const std::byte> data)
     {
         texture = gli::load(reinterpret_cast<const char*>(data.data()), data.size());
         if(texture.empty() || texture.format() != gli::format::FORMAT_RGBA8_UNORM_PACK8)
@@ -3,6 +3,8 @@
 #include <vector>
 #include <cstdint>
 
+#include <gsl/span>
+
 #include <gli/gli.hpp>
 
 namespace RIS::Graphics
@@ -12,7 +14,7 @@ namespace RIS::Graphics
     class Image
     {
     public:
-        Image(const std::vector<std::byte> &data);
+        Image(gsl::span<const std::byte> data);
 
         int GetWidth() const;
         int GetHeight() const;
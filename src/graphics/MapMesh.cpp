@@ -2,10 +2,12 @@
 
 namespace RIS::Graphics
 {
-    MapMesh::MapMesh(Buffer &&vertexBuffer, Buffer &&indexBuffer, std::vector<MapSection> &&sections)
+    MapMesh::MapMesh(Buffer &&vertexBuffer, Buffer &&indexBuffer, std::vector<MapSection> &&sections, std::vector<MapEntityBatch> &&entityBatches, std::vector<MapEntityRange> &&entityRanges)
         : vertexBuffer(std::move(vertexBuffer))
         , indexBuffer(std::move(indexBuffer))
         , sections(std::move(sections))
+        , entityBatches(std::move(entityBatches))
+        , entityRanges(std::move(entityRanges))
     {}
 
     void MapMesh::Bind(VertexArray &vao) const
@@ -19,7 +21,55 @@ namespace RIS::Graphics
         for(const auto &section : sections)
         {
             section.texture->Bind(0);
-            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(section.count), GL_UNSIGNED_SHORT, reinterpret_cast<void*>(section.offset * sizeof(std::uint16_t)));
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(section.count), GL_UNSIGNED_INT, reinterpret_cast<void*>(section.offset * sizeof(std::uint32_t)));
         }
     }
+
+    // entity indices are relative to their own first vertex, so they are drawn with a base vertex
+    void MapMesh::DrawEntities() const
+    {
+        for(const auto &batch : entityBatches)
+        {
+            batch.texture->Bind(0);
+            glMultiDrawElementsBaseVertex(GL_TRIANGLES, batch.counts.data(), GL_UNSIGNED_INT, batch.offsets.data(), static_cast<GLsizei>(batch.counts.size()), batch.baseVertices.data());
+        }
+    }
+
+    void MapMesh::DrawEntitySection(std::uint32_t batch, std::uint32_t draw) const
+    {
+        const auto &entityBatch = entityBatches.at(batch);
+        entityBatch.texture->Bind(0);
+        glDrawElementsBaseVertex(GL_TRIANGLES, entityBatch.indexCounts.at(draw), GL_UNSIGNED_INT, entityBatch.offsets.at(draw), entityBatch.baseVertices.at(draw));
+    }
+
+    void MapMesh::SetEntitySectionVisible(std::uint32_t batch, std::uint32_t draw, bool visible)
+    {
+        auto &entityBatch = entityBatches.at(batch);
+        entityBatch.counts.at(draw) = visible ? entityBatch.indexCounts.at(draw) : 0;
+    }
+
+    const Buffer& MapMesh::GetVertexBuffer() const
+    {
+        return vertexBuffer;
+    }
+
+    const Buffer& MapMesh::GetIndexBuffer() const
+    {
+        return indexBuffer;
+    }
+
+    const std::vector<MapSection>& MapMesh::GetSections() const
+    {
+        return sections;
+    }
+
+    const std::vector<MapEntityBatch>& MapMesh::GetEntityBatches() const
+    {
+        return entityBatches;
+    }
+
+    const std::vector<MapEntityRange>& MapMesh::GetEntityRanges() const
+    {
+        return entityRanges;
+    }
 }
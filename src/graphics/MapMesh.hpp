@@ -6,6 +6,7 @@
 #include "graphics/Texture.hpp"
 
 #include <vector>
+#include <cstdint>
 
 namespace RIS::Graphics
 {
@@ -16,12 +17,40 @@ namespace RIS::Graphics
         size_t offset;
     };
 
+    // all entity sections with the same texture, drawn with one multi draw.
+    // a hidden section keeps its draw with a count of 0, indexCounts has the real counts
+    struct MapEntityBatch
+    {
+        Texture::Ptr texture;
+        std::vector<GLsizei> counts;
+        std::vector<const void*> offsets;
+        std::vector<GLint> baseVertices;
+        std::vector<GLsizei> indexCounts;
+    };
+
+    // the draw of one entity section, an entity batch and the draw in it
+    struct MapEntityDraw
+    {
+        std::uint32_t batch;
+        std::uint32_t draw;
+    };
+
+    // where the geometry of one map entity ended up in the buffers of the map mesh
+    struct MapEntityRange
+    {
+        std::int32_t baseVertex = -1;   // -1 if the entity has no geometry
+        std::uint32_t vertexCount = 0;
+        std::uint32_t firstIndex = 0;   // section offsets are relative to it
+        std::uint32_t indexCount = 0;
+        std::vector<MapEntityDraw> draws;   // one per section of the entity, in the same order
+    };
+
     class MapMesh
     {
     public:
         using Ptr = std::shared_ptr<MapMesh>;
 
-        MapMesh(Buffer &&vertexBuffer, Buffer &&indexBuffer, std::vector<MapSection> &&sections);
+        MapMesh(Buffer &&vertexBuffer, Buffer &&indexBuffer, std::vector<MapSection> &&sections, std::vector<MapEntityBatch> &&entityBatches = {}, std::vector<MapEntityRange> &&entityRanges = {});
 
         MapMesh(const MapMesh &) = delete;
         MapMesh(MapMesh &&) = default;
@@ -30,11 +59,24 @@ namespace RIS::Graphics
 
         void Bind(VertexArray &vao) const;
         void Draw() const;
+        void DrawEntities() const;
+        // one section of an entity on its own, e.g. for an entity that moves and is hidden from the batches
+        void DrawEntitySection(std::uint32_t batch, std::uint32_t draw) const;
+        void SetEntitySectionVisible(std::uint32_t batch, std::uint32_t draw, bool visible);
+
+        const Buffer& GetVertexBuffer() const;
+        const Buffer& GetIndexBuffer() const;
+        const std::vector<MapSection>& GetSections() const;
+        const std::vector<MapEntityBatch>& GetEntityBatches() const;
+        // one range per map entity the mesh was loaded with, in the order of the entities
+        const std::vector<MapEntityRange>& GetEntityRanges() const;
 
     private:
         Buffer vertexBuffer;
         Buffer indexBuffer;
         std::vector<MapSection> sections;
+        std::vector<MapEntityBatch> entityBatches;
+        std::vector<MapEntityRange> entityRanges;
 
     };
 }
@@ -2,13 +2,21 @@
 
 #include <glad2/gl.h>
 
+#include <algorithm>
+
 namespace RIS::Graphics
 {
-    Mesh::Mesh(Buffer &&vertexBuffer, Buffer &&indexBuffer, int numIndices)
+    Mesh::Mesh(Buffer &&vertexBuffer, Buffer &&indexBuffer, std::vector<SubMesh> &&subMeshes, std::size_t indexSize, const Bounds &bounds)
         : vertexBuffer(std::move(vertexBuffer))
         , indexBuffer(std::move(indexBuffer))
-        , numIndices(numIndices)
-    {}
+        , numIndices(0)
+        , indexSize(indexSize)
+        , subMeshes(std::move(subMeshes))
+        , bounds(bounds)
+    {
+        for(const auto &subMesh : this->subMeshes)
+            numIndices = std::max(numIndices, static_cast<int>(subMesh.offset + subMesh.count));
+    }
 
     void Mesh::Bind(VertexArray &vao) const
     {
@@ -31,9 +39,31 @@ namespace RIS::Graphics
         return numIndices;
     }
 
+    std::size_t Mesh::GetIndexSize() const
+    {
+        return indexSize;
+    }
+
+    const std::vector<SubMesh>& Mesh::GetSubMeshes() const
+    {
+        return subMeshes;
+    }
+
+    const Bounds& Mesh::GetBounds() const
+    {
+        return bounds;
+    }
+
     void Mesh::Draw(int count, int offset) const
     {
         count = count == -1 ? numIndices : count;
-        glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_SHORT, reinterpret_cast<void*>(offset * sizeof(std::uint16_t)));
+        GLenum type = indexSize == sizeof(std::uint32_t) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+        glDrawElements(GL_TRIANGLES, count, type, reinterpret_cast<void*>(offset * indexSize));
+    }
+
+    void Mesh::DrawSubMesh(std::size_t index) const
+    {
+        const auto &subMesh = subMeshes.at(index);
+        Draw(static_cast<int>(subMesh.count), static_cast<int>(subMesh.offset));
     }
 }
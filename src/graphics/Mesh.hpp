@@ -4,16 +4,34 @@
 #include "graphics/VertexTypes.hpp"
 #include "graphics/VertexArray.hpp"
 
+#include <glm/glm.hpp>
+
 #include <memory>
+#include <vector>
+#include <cstdint>
 
 namespace RIS::Graphics
 {
+    struct Bounds
+    {
+        glm::vec3 min = glm::vec3(0.0f);
+        glm::vec3 max = glm::vec3(0.0f);
+    };
+
+    // a range of the index buffer drawn with one material
+    struct SubMesh
+    {
+        std::size_t offset;
+        std::size_t count;
+        int material;
+    };
+
     class Mesh
     {
     public:
         using Ptr = std::shared_ptr<Mesh>;
 
-        Mesh(Buffer &&vertexBuffer, Buffer &&indexBuffer, int numIndices);
+        Mesh(Buffer &&vertexBuffer, Buffer &&indexBuffer, std::vector<SubMesh> &&subMeshes, std::size_t indexSize, const Bounds &bounds = {});
 
         Mesh() = default;
         Mesh(const Mesh &) = delete;
@@ -23,14 +41,21 @@ namespace RIS::Graphics
 
         void Bind(VertexArray &vao) const;
         void Draw(int count = -1, int offset = 0) const;
+        void DrawSubMesh(std::size_t index) const;
 
         const Buffer& GetVertexBuffer() const;
         const Buffer& GetIndexBuffer() const;
         int NumIndices() const;
+        std::size_t GetIndexSize() const;
+        const std::vector<SubMesh>& GetSubMeshes() const;
+        const Bounds& GetBounds() const;
 
     private:
         Buffer vertexBuffer;
         Buffer indexBuffer;
-        int numIndices;
+        int numIndices = 0;
+        std::size_t indexSize = sizeof(std::uint16_t);
+        std::vector<SubMesh> subMeshes;
+        Bounds bounds;
     };
 }
@@ -6,12 +6,12 @@ namespace RIS::Graphics
         : mesh(mesh), texture(texture)
     {}
 
-    Mesh::Ptr Model::GetMesh()
+    Mesh::Ptr Model::GetMesh() const
     {
         return mesh;
     }
 
-    Texture::Ptr Model::GetTexture()
+    Texture::Ptr Model::GetTexture() const
     {
         return texture;
     }
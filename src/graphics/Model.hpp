@@ -22,8 +22,8 @@ namespace RIS::Graphics
         Model(Model&&) = default;
         Model& operator=(Model&&) = default;
 
-        Mesh::Ptr GetMesh();
-        Texture::Ptr GetTexture();
+        Mesh::Ptr GetMesh() const;
+        Texture::Ptr GetTexture() const;
 
         void Bind(VertexArray &vao) const;
         void Draw() const;
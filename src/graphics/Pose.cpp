@@ -1,4 +1,9 @@
 #include "graphics/Animation.hpp"
+#include "RisExcept.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
 
 namespace RIS::Graphics::Animation
 {
@@ -10,6 +15,7 @@ namespace RIS::Graphics::Animation
     {
         parents.resize(size, -1);
         joints.resize(size);
+        globalsDirty = true;
     }
 
     std::size_t Pose::Size() const
@@ -25,10 +31,14 @@ namespace RIS::Graphics::Animation
     void Pose::SetLocalTransform(std::size_t index, const Transform &transform)
     {
         joints[index] = transform;
+        globalsDirty = true;
     }
 
     Transform Pose::GetGlobalTransform(std::size_t index) const
     {
+        if(cacheGlobals)
+            return CachedGlobals().at(index);
+
         Transform result = joints.at(index);
         for(int p = parents.at(index); p >= 0; p = parents.at(p))
         {
@@ -43,17 +53,95 @@ namespace RIS::Graphics::Animation
         return GetGlobalTransform(index);
     }
 
+    void Pose::GetGlobalTransforms(std::vector<Transform> &out) const
+    {
+        std::size_t size = Size();
+        out.resize(size);
+
+        if(IsTopological())
+        {
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                int p = parents[i];
+                out[i] = p >= 0 ? Combine(out[p], joints[i]) : joints[i];
+            }
+            return;
+        }
+
+        // parents after their children, resolve every chain from the top down and remember what's done
+        std::vector<bool> done(size, false);
+        std::vector<std::size_t> chain;
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            chain.clear();
+            for(int j = static_cast<int>(i); j >= 0 && !done.at(j); j = parents.at(j))
+            {
+                if(chain.size() == size)
+                    throw RISException("Pose joint hierarchy has a cycle");
+                chain.push_back(j);
+            }
+
+            for(auto it = chain.rbegin(); it != chain.rend(); ++it)
+            {
+                int p = parents[*it];
+                out[*it] = p >= 0 ? Combine(out[p], joints[*it]) : joints[*it];
+                done[*it] = true;
+            }
+        }
+    }
+
     void Pose::GetMatrixPalette(std::vector<glm::mat4> &out) const
     {
         std::size_t size = Size();
         if(out.size() != size)
             out.resize(size);
-        
+        GetMatrixPalette(gsl::span<glm::mat4>(out));
+    }
+
+    void Pose::GetMatrixPalette(gsl::span<glm::mat4> out) const
+    {
+        std::size_t size = Size();
+        if(static_cast<std::size_t>(out.size()) < size)
+            throw RISException(fmt::format("Palette has room for {} of {} joints", out.size(), size));
+
+        // reused between calls so skinning every frame doesn't allocate
+        thread_local std::vector<Transform> scratch;
+        const std::vector<Transform> *transforms = &scratch;
+        if(cacheGlobals)
+            transforms = &CachedGlobals();
+        else
+            GetGlobalTransforms(scratch);
+
         for(std::size_t i = 0; i < size; ++i)
+            out[i] = TransformToMat4((*transforms)[i]);
+    }
+
+    bool Pose::IsTopological() const
+    {
+        for(std::size_t i = 0; i < parents.size(); ++i)
         {
-            Transform t = GetGlobalTransform(i);
-            out[i] = TransformToMat4(t);
+            if(parents[i] >= static_cast<int>(i))
+                return false;
         }
+        return true;
+    }
+
+    void Pose::SetCacheGlobals(bool cache)
+    {
+        cacheGlobals = cache;
+        globalsDirty = true;
+        if(!cache)
+            globals = {};
+    }
+
+    const std::vector<Transform>& Pose::CachedGlobals() const
+    {
+        if(globalsDirty)
+        {
+            GetGlobalTransforms(globals);
+            globalsDirty = false;
+        }
+        return globals;
     }
 
     int Pose::GetParent(std::size_t index) const
@@ -64,6 +152,59 @@ namespace RIS::Graphics::Animation
     void Pose::SetParent(std::size_t index, int parent)
     {
         parents[index] = parent;
+        globalsDirty = true;
+    }
+
+    void Blend(Pose &out, const Pose &a, const Pose &b, float t, const BoneMask *mask)
+    {
+        std::size_t size = a.Size();
+        if(b.Size() != size)
+            throw RISException(fmt::format("Pose sizes don't match ({} and {} joints)", size, b.Size()));
+        if(&out != &a && &out != &b)
+            out = a;
+
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            // glm::lerp of quaternions only takes weights in [0, 1]
+            float weight = std::min(mask ? t * mask->Get(i) : t, 1.0f);
+            if(weight <= 0.0f)
+            {
+                if(&out != &a)
+                    out.SetLocalTransform(i, a.GetLocalTransform(i));
+                continue;
+            }
+            out.SetLocalTransform(i, Mix(a.GetLocalTransform(i), b.GetLocalTransform(i), weight));
+        }
+    }
+
+    void BlendAdditive(Pose &out, const Pose &in, const Pose &additive, const Pose &additiveBase, float weight, const BoneMask *mask)
+    {
+        std::size_t size = in.Size();
+        if(additive.Size() != size || additiveBase.Size() != size)
+            throw RISException(fmt::format("Pose sizes don't match ({}, {} and {} joints)", size, additive.Size(), additiveBase.Size()));
+        if(&out != &in)
+            out = in;
+
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            float w = std::min(mask ? weight * mask->Get(i) : weight, 1.0f);
+            if(w <= 0.0f)
+                continue;
+
+            Transform current = in.GetLocalTransform(i);
+            Transform add = additive.GetLocalTransform(i);
+            Transform base = additiveBase.GetLocalTransform(i);
+
+            current.position += (add.position - base.position) * w;
+            current.scale += (add.scale - base.scale) * w;
+            // the rotation from the base to the additive pose, weighted against no rotation at all
+            glm::quat delta = glm::inverse(base.rotation) * add.rotation;
+            glm::quat identity(1.0f, 0.0f, 0.0f, 0.0f);
+            if(glm::dot(identity, delta) < 0.0f)
+                delta = -delta;
+            current.rotation = glm::normalize(current.rotation * glm::normalize(glm::lerp(identity, delta, w)));
+            out.SetLocalTransform(i, current);
+        }
     }
 
     bool Pose::operator==(const Pose &other) const
@@ -21,11 +21,10 @@ namespace RIS::Graphics::Animation
         std::size_t size = bindPose.Size();
         invBindPose.resize(size);
 
+        std::vector<Transform> world;
+        bindPose.GetGlobalTransforms(world);
         for(std::size_t i = 0; i < size; ++i)
-        {
-            Transform world = bindPose.GetGlobalTransform(i);
-            invBindPose[i] = glm::inverse(TransformToMat4(world));
-        }
+            invBindPose[i] = glm::inverse(TransformToMat4(world[i]));
     }
 
     Pose& Skeleton::GetBindPose()
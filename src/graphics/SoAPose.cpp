@@ -0,0 +1,374 @@
+#include "graphics/Animation.hpp"
+#include "RisExcept.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define RIS_POSE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace RIS::Graphics::Animation
+{
+    namespace
+    {
+        using Float4 = SoAPose::Float4;
+
+        // four floats at once, with sse or a plain loop. both do the same operations in the same order
+#ifdef RIS_POSE_SSE
+        struct Lane
+        {
+            __m128 v;
+        };
+
+        inline Lane Load(const Float4 &f) { return { _mm_load_ps(f.v) }; }
+        inline void Store(Float4 &f, Lane a) { _mm_store_ps(f.v, a.v); }
+        inline Lane Set(float s) { return { _mm_set1_ps(s) }; }
+        inline Lane operator+(Lane a, Lane b) { return { _mm_add_ps(a.v, b.v) }; }
+        inline Lane operator-(Lane a, Lane b) { return { _mm_sub_ps(a.v, b.v) }; }
+        inline Lane operator*(Lane a, Lane b) { return { _mm_mul_ps(a.v, b.v) }; }
+        inline Lane operator/(Lane a, Lane b) { return { _mm_div_ps(a.v, b.v) }; }
+        inline Lane Sqrt(Lane a) { return { _mm_sqrt_ps(a.v) }; }
+        inline Lane Max(Lane a, Lane b) { return { _mm_max_ps(a.v, b.v) }; }
+        // x where a < b, otherwise y
+        inline Lane SelectLess(Lane a, Lane b, Lane x, Lane y)
+        {
+            __m128 mask = _mm_cmplt_ps(a.v, b.v);
+            return { _mm_or_ps(_mm_and_ps(mask, x.v), _mm_andnot_ps(mask, y.v)) };
+        }
+#else
+        struct Lane
+        {
+            float v[4];
+        };
+
+        template<typename F>
+        inline Lane Apply(Lane a, Lane b, F &&f)
+        {
+            Lane r;
+            for(int i = 0; i < 4; ++i)
+                r.v[i] = f(a.v[i], b.v[i]);
+            return r;
+        }
+
+        inline Lane Load(const Float4 &f) { return { { f.v[0], f.v[1], f.v[2], f.v[3] } }; }
+        inline void Store(Float4 &f, Lane a) { for(int i = 0; i < 4; ++i) f.v[i] = a.v[i]; }
+        inline Lane Set(float s) { return { { s, s, s, s } }; }
+        inline Lane operator+(Lane a, Lane b) { return Apply(a, b, [](float x, float y){ return x + y; }); }
+        inline Lane operator-(Lane a, Lane b) { return Apply(a, b, [](float x, float y){ return x - y; }); }
+        inline Lane operator*(Lane a, Lane b) { return Apply(a, b, [](float x, float y){ return x * y; }); }
+        inline Lane operator/(Lane a, Lane b) { return Apply(a, b, [](float x, float y){ return x / y; }); }
+        inline Lane Sqrt(Lane a) { return Apply(a, a, [](float x, float){ return std::sqrt(x); }); }
+        inline Lane Max(Lane a, Lane b) { return Apply(a, b, [](float x, float y){ return x > y ? x : y; }); }
+        // x where a < b, otherwise y
+        inline Lane SelectLess(Lane a, Lane b, Lane x, Lane y)
+        {
+            Lane r;
+            for(int i = 0; i < 4; ++i)
+                r.v[i] = a.v[i] < b.v[i] ? x.v[i] : y.v[i];
+            return r;
+        }
+#endif
+
+        struct Quat4
+        {
+            Lane x, y, z, w;
+        };
+
+        inline Quat4 Multiply(const Quat4 &a, const Quat4 &b)
+        {
+            return {
+                a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
+                a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x,
+                a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+            };
+        }
+
+        inline Quat4 Normalize(const Quat4 &q)
+        {
+            Lane length = Sqrt(Max(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w, Set(1e-24f)));
+            return { q.x / length, q.y / length, q.z / length, q.w / length };
+        }
+
+        inline Lane Mix(Lane a, Lane b, Lane t, Lane invT)
+        {
+            return a * invT + b * t;
+        }
+
+        // the weight of the four joints in block b like the Pose blends: t scaled by the mask and
+        // clamped to 1. the padding gets 0 so it stays an identity transform
+        Lane JointWeights(std::size_t b, std::size_t size, float t, const BoneMask *mask)
+        {
+            Float4 weights;
+            for(std::size_t l = 0; l < 4; ++l)
+            {
+                std::size_t joint = b * 4 + l;
+                float weight = mask ? t * mask->Get(joint) : t;
+                weights.v[l] = joint < size ? std::min(weight, 1.0f) : 0.0f;
+            }
+            return Load(weights);
+        }
+
+        void CheckSizes(std::size_t a, std::size_t b)
+        {
+            if(a != b)
+                throw RISException(fmt::format("Pose sizes don't match ({} and {} joints)", a, b));
+        }
+    }
+
+    SoAPose::SoAPose(std::size_t numJoints)
+    {
+        Resize(numJoints);
+    }
+
+    SoAPose::SoAPose(const Pose &pose)
+    {
+        FromPose(pose);
+    }
+
+    void SoAPose::Resize(std::size_t newSize)
+    {
+        std::size_t blocks = (newSize + 3) / 4;
+        const Float4 zero = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+        const Float4 one = { { 1.0f, 1.0f, 1.0f, 1.0f } };
+        for(auto *stream : { &positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ })
+            stream->resize(blocks, zero);
+        for(auto *stream : { &rotationW, &scaleX, &scaleY, &scaleZ })
+            stream->resize(blocks, one);
+        parents.resize(newSize, -1);
+
+        // joints cut off by shrinking become identity padding again
+        for(std::size_t i = newSize; i < size && i < blocks * 4; ++i)
+            SetLocalTransform(i, Transform());
+        size = newSize;
+    }
+
+    std::size_t SoAPose::Size() const
+    {
+        return size;
+    }
+
+    int SoAPose::GetParent(std::size_t index) const
+    {
+        return parents.at(index);
+    }
+
+    void SoAPose::SetParent(std::size_t index, int parent)
+    {
+        parents.at(index) = parent;
+    }
+
+    Transform SoAPose::GetLocalTransform(std::size_t index) const
+    {
+        std::size_t b = index / 4, l = index % 4;
+        return Transform(
+            glm::vec3(positionX[b].v[l], positionY[b].v[l], positionZ[b].v[l]),
+            glm::quat(rotationW[b].v[l], rotationX[b].v[l], rotationY[b].v[l], rotationZ[b].v[l]),
+            glm::vec3(scaleX[b].v[l], scaleY[b].v[l], scaleZ[b].v[l]));
+    }
+
+    void SoAPose::SetLocalTransform(std::size_t index, const Transform &transform)
+    {
+        std::size_t b = index / 4, l = index % 4;
+        positionX[b].v[l] = transform.position.x;
+        positionY[b].v[l] = transform.position.y;
+        positionZ[b].v[l] = transform.position.z;
+        rotationX[b].v[l] = transform.rotation.x;
+        rotationY[b].v[l] = transform.rotation.y;
+        rotationZ[b].v[l] = transform.rotation.z;
+        rotationW[b].v[l] = transform.rotation.w;
+        scaleX[b].v[l] = transform.scale.x;
+        scaleY[b].v[l] = transform.scale.y;
+        scaleZ[b].v[l] = transform.scale.z;
+    }
+
+    void SoAPose::FromPose(const Pose &pose)
+    {
+        Resize(pose.Size());
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            SetLocalTransform(i, pose.GetLocalTransform(i));
+            parents[i] = pose.GetParent(i);
+        }
+    }
+
+    void SoAPose::ToPose(Pose &out) const
+    {
+        out.Resize(size);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            out.SetLocalTransform(i, GetLocalTransform(i));
+            out.SetParent(i, parents[i]);
+        }
+    }
+
+    // every joint depends on its parent so this one goes joint by joint, same math as Combine
+    void SoAPose::LocalToModel(SoAPose &out) const
+    {
+        if(&out != this)
+        {
+            out.Resize(size);
+            out.parents = parents;
+        }
+
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            int p = parents[i];
+            if(p >= static_cast<int>(i))
+                throw RISException(fmt::format("Joint {} comes before its parent {}", i, p));
+
+            Transform local = GetLocalTransform(i);
+            out.SetLocalTransform(i, p >= 0 ? Combine(out.GetLocalTransform(p), local) : local);
+        }
+    }
+
+    void SoAPose::GetMatrixPalette(std::vector<glm::mat4> &out) const
+    {
+        out.resize(size);
+        GetMatrixPalette(gsl::span<glm::mat4>(out));
+    }
+
+    void SoAPose::GetMatrixPalette(gsl::span<glm::mat4> out) const
+    {
+        if(static_cast<std::size_t>(out.size()) < size)
+            throw RISException(fmt::format("Palette has room for {} of {} joints", out.size(), size));
+
+        // reused between calls so skinning every frame doesn't allocate
+        thread_local SoAPose model;
+        LocalToModel(model);
+        model.WriteMatrices(out);
+    }
+
+    // same columns as TransformToMat4, four joints at a time
+    void SoAPose::WriteMatrices(gsl::span<glm::mat4> out) const
+    {
+        const Lane one = Set(1.0f);
+        const Lane two = Set(2.0f);
+        for(std::size_t b = 0; b < positionX.size(); ++b)
+        {
+            Lane x = Load(rotationX[b]), y = Load(rotationY[b]), z = Load(rotationZ[b]), w = Load(rotationW[b]);
+            Lane sx = Load(scaleX[b]), sy = Load(scaleY[b]), sz = Load(scaleZ[b]);
+
+            Lane xx = x * x, yy = y * y, zz = z * z;
+            Lane xy = x * y, xz = x * z, yz = y * z;
+            Lane wx = w * x, wy = w * y, wz = w * z;
+
+            Float4 m[12];
+            Store(m[0], (one - two * (yy + zz)) * sx);
+            Store(m[1], two * (xy + wz) * sx);
+            Store(m[2], two * (xz - wy) * sx);
+            Store(m[3], two * (xy - wz) * sy);
+            Store(m[4], (one - two * (xx + zz)) * sy);
+            Store(m[5], two * (yz + wx) * sy);
+            Store(m[6], two * (xz + wy) * sz);
+            Store(m[7], two * (yz - wx) * sz);
+            Store(m[8], (one - two * (xx + yy)) * sz);
+            m[9] = positionX[b];
+            m[10] = positionY[b];
+            m[11] = positionZ[b];
+
+            for(std::size_t l = 0; l < 4 && b * 4 + l < size; ++l)
+            {
+                out[b * 4 + l] = glm::mat4(
+                    m[0].v[l], m[1].v[l], m[2].v[l], 0.0f,
+                    m[3].v[l], m[4].v[l], m[5].v[l], 0.0f,
+                    m[6].v[l], m[7].v[l], m[8].v[l], 0.0f,
+                    m[9].v[l], m[10].v[l], m[11].v[l], 1.0f);
+            }
+        }
+    }
+
+    // same as Mix for every joint: lerp for position and scale, nlerp in the same hemisphere for rotation.
+    // joints with a weight of 0 keep a
+    void Blend(SoAPose &out, const SoAPose &a, const SoAPose &b, float t, const BoneMask *mask)
+    {
+        CheckSizes(a.size, b.size);
+        if(&out != &a && &out != &b)
+        {
+            out.Resize(a.size);
+            out.parents = a.parents;
+        }
+        CheckSizes(out.size, a.size);
+
+        const Lane zero = Set(0.0f);
+        const Lane one = Set(1.0f);
+        for(std::size_t i = 0; i < a.positionX.size(); ++i)
+        {
+            Lane lt = JointWeights(i, a.size, t, mask);
+            Lane invT = one - lt;
+            auto mix = [&](Float4 &o, const Float4 &x, const Float4 &y)
+            {
+                Lane lx = Load(x);
+                Store(o, SelectLess(zero, lt, Mix(lx, Load(y), lt, invT), lx));
+            };
+            mix(out.positionX[i], a.positionX[i], b.positionX[i]);
+            mix(out.positionY[i], a.positionY[i], b.positionY[i]);
+            mix(out.positionZ[i], a.positionZ[i], b.positionZ[i]);
+            mix(out.scaleX[i], a.scaleX[i], b.scaleX[i]);
+            mix(out.scaleY[i], a.scaleY[i], b.scaleY[i]);
+            mix(out.scaleZ[i], a.scaleZ[i], b.scaleZ[i]);
+
+            Quat4 qa = { Load(a.rotationX[i]), Load(a.rotationY[i]), Load(a.rotationZ[i]), Load(a.rotationW[i]) };
+            Quat4 qb = { Load(b.rotationX[i]), Load(b.rotationY[i]), Load(b.rotationZ[i]), Load(b.rotationW[i]) };
+            Lane dot = qa.x * qb.x + qa.y * qb.y + qa.z * qb.z + qa.w * qb.w;
+            Lane sign = SelectLess(dot, zero, Set(-1.0f), one);
+            Quat4 q = Normalize({
+                Mix(qa.x, qb.x * sign, lt, invT),
+                Mix(qa.y, qb.y * sign, lt, invT),
+                Mix(qa.z, qb.z * sign, lt, invT),
+                Mix(qa.w, qb.w * sign, lt, invT) });
+            Store(out.rotationX[i], SelectLess(zero, lt, q.x, qa.x));
+            Store(out.rotationY[i], SelectLess(zero, lt, q.y, qa.y));
+            Store(out.rotationZ[i], SelectLess(zero, lt, q.z, qa.z));
+            Store(out.rotationW[i], SelectLess(zero, lt, q.w, qa.w));
+        }
+    }
+
+    // same as the Pose version: the rotation from additiveBase to additive is weighted against no rotation
+    void BlendAdditive(SoAPose &out, const SoAPose &in, const SoAPose &additive, const SoAPose &additiveBase, float weight, const BoneMask *mask)
+    {
+        CheckSizes(in.size, additive.size);
+        CheckSizes(in.size, additiveBase.size);
+        if(&out != &in)
+        {
+            out.Resize(in.size);
+            out.parents = in.parents;
+        }
+
+        const Lane zero = Set(0.0f);
+        const Lane one = Set(1.0f);
+        const Lane minus = Set(-1.0f);
+        for(std::size_t i = 0; i < in.positionX.size(); ++i)
+        {
+            Lane w = JointWeights(i, in.size, weight, mask);
+            auto add = [&](Float4 &o, const Float4 &x, const Float4 &a, const Float4 &b)
+            {
+                Lane lx = Load(x);
+                Store(o, SelectLess(zero, w, lx + (Load(a) - Load(b)) * w, lx));
+            };
+            add(out.positionX[i], in.positionX[i], additive.positionX[i], additiveBase.positionX[i]);
+            add(out.positionY[i], in.positionY[i], additive.positionY[i], additiveBase.positionY[i]);
+            add(out.positionZ[i], in.positionZ[i], additive.positionZ[i], additiveBase.positionZ[i]);
+            add(out.scaleX[i], in.scaleX[i], additive.scaleX[i], additiveBase.scaleX[i]);
+            add(out.scaleY[i], in.scaleY[i], additive.scaleY[i], additiveBase.scaleY[i]);
+            add(out.scaleZ[i], in.scaleZ[i], additive.scaleZ[i], additiveBase.scaleZ[i]);
+
+            // delta = inverse(base) * additive, the rotations are unit so the inverse is the conjugate
+            Quat4 base = { Load(additiveBase.rotationX[i]) * minus, Load(additiveBase.rotationY[i]) * minus, Load(additiveBase.rotationZ[i]) * minus, Load(additiveBase.rotationW[i]) };
+            Quat4 delta = Multiply(base, { Load(additive.rotationX[i]), Load(additive.rotationY[i]), Load(additive.rotationZ[i]), Load(additive.rotationW[i]) });
+            Lane sign = SelectLess(delta.w, zero, minus, one);
+            Lane ws = w * sign;
+            Quat4 partial = Normalize({ delta.x * ws, delta.y * ws, delta.z * ws, (one - w) + delta.w * ws });
+            Quat4 current = { Load(in.rotationX[i]), Load(in.rotationY[i]), Load(in.rotationZ[i]), Load(in.rotationW[i]) };
+            Quat4 q = Normalize(Multiply(current, partial));
+            Store(out.rotationX[i], SelectLess(zero, w, q.x, current.x));
+            Store(out.rotationY[i], SelectLess(zero, w, q.y, current.y));
+            Store(out.rotationZ[i], SelectLess(zero, w, q.z, current.z));
+            Store(out.rotationW[i], SelectLess(zero, w, q.w, current.w));
+        }
+    }
+}
@@ -12,14 +12,25 @@ namespace RIS::Graphics
     {
     }
 
-    Texture::Texture(const std::vector<std::byte> &data, bool flip)
+    namespace
+    {
+        gli::texture LoadTexture(gsl::span<const std::byte> data, bool flip)
+        {
+            gli::texture texture = gli::load(reinterpret_cast<const char*>(data.data()), data.size());
+            if(flip && !texture.empty())
+                texture = gli::flip(texture);
+            return texture;
+        }
+    }
+
+    Texture::Texture(gsl::span<const std::byte> data, bool flip)
+        : Texture(LoadTexture(data, flip))
+    {}
+
+    Texture::Texture(const gli::texture &texture)
     {
-        gli::texture texture = gli::load(reinterpret_cast<const char*>(data.data()), data.size());
         if(texture.empty())
             return;
-        
-        if(flip)
-            texture = gli::flip(texture);
 
         gli::gl gl(gli::gl::PROFILE_GL33);
         const gli::gl::format format = gl.translate(texture.format(), texture.swizzles());
@@ -57,9 +68,11 @@ namespace RIS::Graphics
                 glTextureSubImage2D(id, static_cast<GLint>(level), 0, 0, extent.x, extent.y, static_cast<GLenum>(format.External), static_cast<GLenum>(format.Type), texture.data(0, face, level));
         }
         
+        size = texture.size();
         if(texture.levels() == 1)
         {
             glGenerateTextureMipmap(id);
+            size += size / 3;
         }
     }
 
@@ -69,6 +82,8 @@ namespace RIS::Graphics
         glTextureStorage2D(id, 1, GL_RGBA8, width, height);
         glTextureSubImage2D(id, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rawData);
         glGenerateTextureMipmap(id);
+        size = static_cast<std::size_t>(width) * height * 4;
+        size += size / 3;
     }
 
     Texture::Texture(TextureFormat format, int width, int height)
@@ -84,6 +99,7 @@ namespace RIS::Graphics
         glCreateTextures(GL_TEXTURE_2D, 1, &id);
         glTextureStorage2D(id, 1, GL_RGBA8, 1, 1);
         glTextureSubImage2D(id, 0, 0, 0, 1, 1, GL_RGBA, GL_FLOAT, glm::value_ptr(color));
+        size = 4;
     }
 
     Texture::Texture(GLenum type)
@@ -94,11 +110,13 @@ namespace RIS::Graphics
     Texture::Texture(Texture &&other)
     {
         std::swap(id, other.id);
+        std::swap(size, other.size);
     }
 
     Texture& Texture::operator=(Texture &&other)
     {
         std::swap(id, other.id);
+        std::swap(size, other.size);
         return *this;
     }
 
@@ -112,6 +130,11 @@ namespace RIS::Graphics
         glBindTextureUnit(textureUnit, id);
     }
 
+    std::size_t Texture::GetSize() const
+    {
+        return size;
+    }
+
     void Texture::SetBuffer(const Buffer &buffer, TextureFormat format)
     {
         glTextureBuffer(id, static_cast<GLenum>(format), buffer.GetId());
@@ -10,6 +10,10 @@
 
 #include <memory>
 
+#include <gsl/span>
+
+namespace gli { class texture; }
+
 namespace RIS::Graphics
 {
     enum class TextureFormat
@@ -84,7 +88,8 @@ namespace RIS::Graphics
         using Ptr = std::shared_ptr<Texture>;
 
         Texture();
-        Texture(const std::vector<std::byte> &data, bool flip = false);
+        Texture(gsl::span<const std::byte> data, bool flip = false);
+        Texture(const gli::texture &texture);
         Texture(const std::byte *rawData, int width, int height);
         Texture(TextureFormat format, int width, int height);
         Texture(const glm::vec4 color);
@@ -101,5 +106,11 @@ namespace RIS::Graphics
 
         void Bind(GLuint textureUnit) const;
 
+        // approximate size of the texture storage in bytes
+        std::size_t GetSize() const;
+
+    private:
+        std::size_t size = 0;
+
     };
 }
@@ -3,6 +3,9 @@
 #include "misc/MathHelper.hpp"
 
 #include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -72,13 +75,13 @@ namespace RIS::Graphics::Animation
     }
 
     template<typename T, unsigned int N>
-    T Track<T, N>::Sample(float time, bool looping) const
+    T Track<T, N>::Sample(float time, bool looping, TrackCursor *cursor) const
     {
         switch(interpolation)
         {
-        case Interpolation::CONSTANT: return SampleConstant(time, looping);
-        case Interpolation::LINEAR: return SampleLinear(time, looping);
-        case Interpolation::CUBIC: return SampleCubic(time, looping);
+        case Interpolation::CONSTANT: return SampleConstant(time, looping, cursor);
+        case Interpolation::LINEAR: return SampleLinear(time, looping, cursor);
+        case Interpolation::CUBIC: return SampleCubic(time, looping, cursor);
         }
         return T(); // should never reach
     }
@@ -163,14 +166,36 @@ namespace RIS::Graphics::Animation
                 return static_cast<int>(size) - 2;
         }
         
-        int index = static_cast<int>(size) - 1;
-        for(auto it = frames.rbegin(); it != frames.rend(); ++it)
+        if(!(time >= frames.front().time))
+            return -1;
+
+        // last frame that starts at or before time
+        auto it = std::upper_bound(std::begin(frames), std::end(frames), time, [](float t, const Frame<N> &frame){ return t < frame.time; });
+        return static_cast<int>(std::distance(std::begin(frames), it)) - 1;
+    }
+
+    template<typename T, unsigned int N>
+    int Track<T, N>::FindFrame(float time, bool looping, TrackCursor *cursor) const
+    {
+        if(cursor)
         {
-            if(time >= (*it).time)
-                return index;
-            index--;
+            // most of the time we are still in the same interval or just moved on to the next one
+            int frame = cursor->frame;
+            int size = static_cast<int>(frames.size());
+            if(frame >= 0 && frame < size - 1)
+            {
+                float trackTime = AdjustTimeToFitTrack(time, looping);
+                if(frames[frame].time <= trackTime && trackTime < frames[frame + 1].time)
+                    return frame;
+                if(frame + 2 < size && frames[frame + 1].time <= trackTime && trackTime < frames[frame + 2].time)
+                    return ++cursor->frame;
+            }
         }
-        return -1;
+
+        int frame = FrameIndex(time, looping);
+        if(cursor)
+            cursor->frame = frame;
+        return frame;
     }
 
     template<typename T, unsigned int N>
@@ -221,18 +246,18 @@ namespace RIS::Graphics::Animation
     }
 
     template<typename T, unsigned int N>
-    T Track<T, N>::SampleConstant(float time, bool looping) const
+    T Track<T, N>::SampleConstant(float time, bool looping, TrackCursor *cursor) const
     {
-        int frame = FrameIndex(time, looping);
+        int frame = FindFrame(time, looping, cursor);
         if(frame < 0 || frame >= static_cast<int>(frames.size()))
             return T();
         return Cast(frames.at(frame).value.data());
     }
 
     template<typename T, unsigned int N>
-    T Track<T, N>::SampleLinear(float time, bool looping) const
+    T Track<T, N>::SampleLinear(float time, bool looping, TrackCursor *cursor) const
     {
-        int thisFrame = FrameIndex(time, looping);
+        int thisFrame = FindFrame(time, looping, cursor);
         if(thisFrame < 0 || thisFrame >= static_cast<int>(frames.size() - 1))
             return T();
 
@@ -254,9 +279,9 @@ namespace RIS::Graphics::Animation
     }
 
     template<typename T, unsigned int N>
-    T Track<T, N>::SampleCubic(float time, bool looping) const
+    T Track<T, N>::SampleCubic(float time, bool looping, TrackCursor *cursor) const
     {
-        int thisFrame = FrameIndex(time, looping);
+        int thisFrame = FindFrame(time, looping, cursor);
         if(thisFrame < 0 || thisFrame >= static_cast<int>(frames.size() - 1))
             return T();
 
@@ -126,15 +126,15 @@ namespace RIS::Graphics::Animation
     }
 
     template<typename VTRACK, typename QTRACK>
-    Transform TTransformTrack<VTRACK, QTRACK>::Sample(const Transform &ref, float time, bool looping) const
+    Transform TTransformTrack<VTRACK, QTRACK>::Sample(const Transform &ref, float time, bool looping, Cursor *cursor) const
     {
         Transform result = ref;
         if(positionTrack.Size() > 1)
-            result.position = positionTrack.Sample(time, looping);
+            result.position = positionTrack.Sample(time, looping, cursor ? &cursor->position : nullptr);
         if(rotationTrack.Size() > 1)
-            result.rotation = rotationTrack.Sample(time, looping);
+            result.rotation = rotationTrack.Sample(time, looping, cursor ? &cursor->rotation : nullptr);
         if(scaleTrack.Size() > 1)
-            result.scale = scaleTrack.Sample(time, looping);
+            result.scale = scaleTrack.Sample(time, looping, cursor ? &cursor->scale : nullptr);
         return result;
     }
 
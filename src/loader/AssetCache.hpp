@@ -1,112 +1,446 @@
 #pragma once
 
 #include "loader/Loaders.hpp"
+#include "loader/AssetId.hpp"
+#include "loader/AssetFootprint.hpp"
 
 #include <variant>
 #include <unordered_map>
-#include <experimental/unordered_map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <algorithm>
-#include <typeinfo>
+#include <type_traits>
 #include <vector>
+#include <array>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <optional>
+#include <exception>
 
-#include <fmt/format.h>
-
-namespace RIS
+namespace RIS::Loader
 {
-    namespace Game
+    template<typename AssetType>
+    using AssetFuture = std::shared_future<std::shared_ptr<AssetType>>;
+
+    template<typename AssetType>
+    struct AssetClaim
     {
-        class MapEntity;
-        using MapEntities = std::vector<MapEntity>;
-    }
+        std::shared_ptr<AssetType> asset;   // already cached
+        AssetFuture<AssetType> future;      // set while the asset is being loaded
+        bool isOwner = false;               // the claimer has to load the asset and call Complete or Fail
+    };
 
-    namespace Physics
+    struct AssetUsage
     {
-        class WorldSolids;
-    }
+        std::string_view type;
+        std::string name;
+        AssetFootprint footprint;
+        long handles;       // shared_ptrs held outside of the cache
+        bool evictable;
+    };
 
-    namespace Graphics
+    // loads started while another asset is loading on the same thread are recorded as its dependencies
+    class DependencyScope
     {
-        class Model;
-        class Mesh;
-        class Font;
-        class Image;
-        class Shader;
-        class Texture;
-        class MapMesh;
-        namespace Animation
-        {
-            class Animation;
-            class Skeleton;
-        }
-    }
-    
-}
+    public:
+        DependencyScope() : parent(current) { current = this; }
+        ~DependencyScope() { current = parent; }
+
+        DependencyScope(const DependencyScope&) = delete;
+        DependencyScope& operator=(const DependencyScope&) = delete;
+
+        static void Record(AssetId id)
+        {
+            if(current)
+                current->dependencies.push_back(id);
+        }
+
+        std::vector<AssetId> Take()
+        {
+            return std::move(dependencies);
+        }
+
+    private:
+        DependencyScope *parent;
+        std::vector<AssetId> dependencies;
+
+        inline static thread_local DependencyScope *current = nullptr;
+
+    };
 
-namespace RIS::Loader
-{
     template<typename... AssetTypes>
     class TAssetCache
     {
     private:
         using TVariant = std::variant<std::shared_ptr<AssetTypes>...>;
+        using TPromiseVariant = std::variant<std::promise<std::shared_ptr<AssetTypes>>...>;
+        using TFutureVariant = std::variant<AssetFuture<AssetTypes>...>;
+
         struct RefCount
         {
             TVariant asset;
-            int count;
+            std::atomic<int> count = 0;
+            std::atomic<std::uint64_t> lastUse = 0;
+            AssetFootprint footprint;
+            std::string_view type;
+            std::string name;
+            std::vector<AssetId> dependencies;
+        };
+
+        struct Pending
+        {
+            TPromiseVariant promise;
+            TFutureVariant future;
+            int waiters;
         };
 
+        struct Shard
+        {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<AssetId, RefCount> assets;
+            std::unordered_map<AssetId, Pending> pending;
+        };
+
+        static constexpr std::size_t NUM_SHARDS = 16;
+
     public:
         template<typename AssetType>
-        bool IsCached(const std::string &name) const
+        static constexpr AssetId GetId(const AssetPath &path)
+        {
+            return MakeAssetId(path.hash, TypeIndex<AssetType>());
+        }
+
+        template<typename AssetType>
+        bool IsCached(const AssetPath &path) const
         {
-            return assets.count(GetTypeName<AssetType>(name)) > 0;
+            AssetId key = GetId<AssetType>(path);
+            const auto &shard = GetShard(key);
+            std::shared_lock lock(shard.mutex);
+            return shard.assets.count(key) > 0;
         }
 
+        // returns the cached asset and adds a reference to it, or nullptr if it is not cached
         template<typename AssetType>
-        void AddRef(const std::string &name)
+        std::shared_ptr<AssetType> Find(const AssetPath &path)
         {
-            auto tname = GetTypeName<AssetType>(name);
-            if(IsCached<AssetType>(name))
-                assets.at(tname).count++;
+            AssetId key = GetId<AssetType>(path);
+            auto &shard = GetShard(key);
+            std::vector<AssetId> dependencies;
+            std::shared_ptr<AssetType> asset;
+            {
+                std::shared_lock lock(shard.mutex);
+                asset = FindLocked<AssetType>(shard, key, dependencies);
+            }
+            ReferenceDependencies(std::move(dependencies), 1);
+            return asset;
         }
 
+        // only the first claim for an uncached asset becomes the owner, everyone else gets the owners future
         template<typename AssetType>
-        void Cache(const std::string &name, std::shared_ptr<AssetType> asset)
+        AssetClaim<AssetType> Claim(const AssetPath &path)
         {
-            RefCount rc{ asset, 1 };
-            assets.insert_or_assign(GetTypeName<AssetType>(name), rc);
+            AssetId key = GetId<AssetType>(path);
+            auto &shard = GetShard(key);
+            std::vector<AssetId> dependencies;
+            {
+                std::shared_lock lock(shard.mutex);
+                if(auto asset = FindLocked<AssetType>(shard, key, dependencies))
+                {
+                    lock.unlock();
+                    ReferenceDependencies(std::move(dependencies), 1);
+                    return { asset, {}, false };
+                }
+            }
+
+            std::unique_lock lock(shard.mutex);
+            if(auto asset = FindLocked<AssetType>(shard, key, dependencies))
+            {
+                lock.unlock();
+                ReferenceDependencies(std::move(dependencies), 1);
+                return { asset, {}, false };
+            }
+
+            auto found = shard.pending.find(key);
+            if(found != std::end(shard.pending))
+            {
+                auto &pending = found->second;
+                pending.waiters++;
+                return { nullptr, std::get<AssetFuture<AssetType>>(pending.future), false };
+            }
+
+            std::promise<std::shared_ptr<AssetType>> promise;
+            AssetFuture<AssetType> future = promise.get_future().share();
+            shard.pending.try_emplace(key, Pending{ std::move(promise), future, 0 });
+            return { nullptr, future, true };
+        }
+
+        // dependencies are the assets that were loaded as part of this one, they are referenced together with it
+        template<typename AssetType>
+        void Complete(const AssetPath &path, std::shared_ptr<AssetType> asset, std::vector<AssetId> dependencies = {})
+        {
+            AssetId key = GetId<AssetType>(path);
+            auto &shard = GetShard(key);
+
+            AssetFootprint footprint;
+            if(asset)
+                footprint = GetFootprint(*asset);
+
+            std::unique_lock lock(shard.mutex);
+            int refs = 1;
+            std::optional<Pending> pending = TakePending(shard, key);
+            if(pending)
+                refs += pending->waiters;
+
+            if(asset)
+            {
+                auto &rc = shard.assets[key];
+                totalSize -= rc.footprint.Total();
+                totalSize += footprint.Total();
+                rc.asset = asset;
+                rc.count = refs;
+                rc.lastUse = ++useClock;
+                rc.footprint = footprint;
+                rc.type = ASSET_TYPE_NAME<AssetType>;
+                rc.name = path.path;
+                rc.dependencies = dependencies;
+            }
+            lock.unlock();
+
+            // the dependencies were referenced once by their own loads, everyone who waited for this asset needs them too
+            if(asset && refs > 1)
+                ReferenceDependencies(std::move(dependencies), refs - 1);
+
+            if(pending)
+                std::get<std::promise<std::shared_ptr<AssetType>>>(pending->promise).set_value(asset);
+        }
+
+        template<typename AssetType>
+        void Fail(const AssetPath &path, std::exception_ptr error)
+        {
+            AssetId key = GetId<AssetType>(path);
+            auto &shard = GetShard(key);
+
+            std::unique_lock lock(shard.mutex);
+            std::optional<Pending> pending = TakePending(shard, key);
+            lock.unlock();
+
+            if(pending)
+                std::get<std::promise<std::shared_ptr<AssetType>>>(pending->promise).set_exception(error);
         }
 
         template<typename AssetType>
-        std::shared_ptr<AssetType> Get(const std::string &name)
+        void Cache(const AssetPath &path, std::shared_ptr<AssetType> asset)
         {
-            std::shared_ptr<AssetType> weakptr = std::get<std::shared_ptr<AssetType>>(assets.at(GetTypeName<AssetType>(name)).asset);
-            //return weakptr.lock();
-            return weakptr;
+            Complete<AssetType>(path, asset);
         }
 
+        // without a budget unused assets are dropped right away, with one they stay cached until Trim needs the space
         void Cleanup()
         {
-            std::for_each(std::begin(assets), std::end(assets), [](auto &value){ value.second.count--; });
-            std::experimental::erase_if(assets, [](const auto &value){ return value.second.count <= 0; });
+            bool keepUnused = budget > 0;
+            for(auto &shard : shards)
+            {
+                std::unique_lock lock(shard.mutex);
+                // assets kept for the budget are already unused, their count stays at 0
+                std::for_each(std::begin(shard.assets), std::end(shard.assets), [](auto &value){ if(value.second.count > 0) value.second.count--; });
+                if(keepUnused)
+                    continue;
+
+                for(auto it = std::begin(shard.assets); it != std::end(shard.assets);)
+                {
+                    if(it->second.count <= 0)
+                        it = EraseLocked(shard, it);
+                    else
+                        ++it;
+                }
+            }
+
+            if(keepUnused)
+                Trim();
         }
 
         void Clear()
         {
-            assets.clear();
+            for(auto &shard : shards)
+            {
+                std::unique_lock lock(shard.mutex);
+                for(const auto &[key, rc] : shard.assets)
+                    totalSize -= rc.footprint.Total();
+                shard.assets.clear();
+            }
+        }
+
+        // evicts the least recently used assets that are unused until the cache fits into the budget.
+        // evicting can destroy gl objects, so this has to be called on the render thread (once per frame by the game loop)
+        void Trim()
+        {
+            std::size_t limit = budget;
+            if(limit == 0 || totalSize <= limit)
+                return;
+
+            std::unique_lock trimLock(trimMutex, std::try_to_lock);
+            if(!trimLock)
+                return;
+
+            struct Candidate
+            {
+                std::uint64_t lastUse;
+                AssetId key;
+            };
+
+            std::vector<Candidate> candidates;
+            for(const auto &shard : shards)
+            {
+                std::shared_lock lock(shard.mutex);
+                for(const auto &[key, rc] : shard.assets)
+                {
+                    if(IsEvictable(rc))
+                        candidates.push_back({ rc.lastUse, key });
+                }
+            }
+            std::sort(std::begin(candidates), std::end(candidates), [](const auto &a, const auto &b){ return a.lastUse < b.lastUse; });
+
+            for(const auto &candidate : candidates)
+            {
+                if(totalSize <= limit)
+                    break;
+
+                auto &shard = GetShard(candidate.key);
+                std::unique_lock lock(shard.mutex);
+                auto found = shard.assets.find(candidate.key);
+                if(found != std::end(shard.assets) && IsEvictable(found->second))
+                    EraseLocked(shard, found);
+            }
+        }
+
+        // budget in bytes, 0 disables eviction
+        void SetBudget(std::size_t bytes)
+        {
+            budget = bytes;
+            Trim();
+        }
+
+        std::size_t GetBudget() const
+        {
+            return budget;
+        }
+
+        std::size_t GetTotalSize() const
+        {
+            return totalSize;
+        }
+
+        std::vector<AssetUsage> GetUsage() const
+        {
+            std::vector<AssetUsage> usage;
+            for(const auto &shard : shards)
+            {
+                std::shared_lock lock(shard.mutex);
+                for(const auto &[key, rc] : shard.assets)
+                {
+                    long handles = std::visit([](const auto &asset){ return asset.use_count() - 1; }, rc.asset);
+                    usage.push_back({ rc.type, rc.name, rc.footprint, handles, IsEvictable(rc) });
+                }
+            }
+            return usage;
         }
 
     private:
         template<typename AssetType>
-        std::string GetTypeName(const std::string &name) const
+        static constexpr std::size_t TypeIndex()
+        {
+            static_assert((std::is_same_v<AssetType, AssetTypes> || ...), "asset type is not cacheable");
+
+            constexpr bool matches[] = { std::is_same_v<AssetType, AssetTypes>... };
+            std::size_t index = 0;
+            while(!matches[index])
+                ++index;
+            return index;
+        }
+
+        Shard& GetShard(AssetId key)
+        {
+            return shards[key % NUM_SHARDS];
+        }
+
+        const Shard& GetShard(AssetId key) const
+        {
+            return shards[key % NUM_SHARDS];
+        }
+
+        template<typename AssetType>
+        std::shared_ptr<AssetType> FindLocked(Shard &shard, AssetId key, std::vector<AssetId> &dependencies)
         {
-            return fmt::format("{}|{}", name, typeid(AssetType).name());
+            auto found = shard.assets.find(key);
+            if(found == std::end(shard.assets))
+                return nullptr;
+
+            auto &rc = found->second;
+            rc.count++;
+            rc.lastUse = ++useClock;
+            dependencies = rc.dependencies;
+            return std::get<std::shared_ptr<AssetType>>(rc.asset);
+        }
+
+        // walks the dependency graph one shard at a time, so no two shard locks are held together
+        void ReferenceDependencies(std::vector<AssetId> dependencies, int refs)
+        {
+            std::vector<AssetId> visited;
+            while(!dependencies.empty())
+            {
+                AssetId key = dependencies.back();
+                dependencies.pop_back();
+                if(std::find(std::begin(visited), std::end(visited), key) != std::end(visited))
+                    continue;
+                visited.push_back(key);
+
+                auto &shard = GetShard(key);
+                std::shared_lock lock(shard.mutex);
+                auto found = shard.assets.find(key);
+                if(found == std::end(shard.assets))
+                    continue;
+
+                auto &rc = found->second;
+                rc.count += refs;
+                rc.lastUse = ++useClock;
+                dependencies.insert(std::end(dependencies), std::begin(rc.dependencies), std::end(rc.dependencies));
+            }
+        }
+
+        // unused by the current scene and nobody else holds the asset
+        static bool IsEvictable(const RefCount &rc)
+        {
+            return rc.count <= 0 && std::visit([](const auto &asset){ return asset.use_count() == 1; }, rc.asset);
+        }
+
+        auto EraseLocked(Shard &shard, typename std::unordered_map<AssetId, RefCount>::iterator it)
+        {
+            totalSize -= it->second.footprint.Total();
+            return shard.assets.erase(it);
+        }
+
+        std::optional<Pending> TakePending(Shard &shard, AssetId key)
+        {
+            auto found = shard.pending.find(key);
+            if(found == std::end(shard.pending))
+                return std::nullopt;
+
+            std::optional<Pending> pending(std::move(found->second));
+            shard.pending.erase(found);
+            return pending;
         }
 
     private:
-        std::unordered_map<std::string, RefCount> assets;
+        std::array<Shard, NUM_SHARDS> shards;
+
+        std::atomic<std::uint64_t> useClock = 0;
+        std::atomic<std::size_t> budget = 0;
+        std::atomic<std::size_t> totalSize = 0;
+        std::mutex trimMutex;
 
     };
 
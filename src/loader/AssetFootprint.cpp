@@ -0,0 +1,138 @@
+#include "loader/AssetFootprint.hpp"
+
+#include "graphics/Font.hpp"
+#include "graphics/Mesh.hpp"
+#include "graphics/Model.hpp"
+#include "graphics/Shader.hpp"
+#include "graphics/Texture.hpp"
+#include "graphics/Image.hpp"
+#include "graphics/Animation.hpp"
+#include "graphics/MapMesh.hpp"
+#include "physics/WorldSolids.hpp"
+#include "game/MapEntity.hpp"
+
+namespace RIS::Loader
+{
+    namespace
+    {
+        std::size_t PoseSize(const Graphics::Animation::Pose &pose)
+        {
+            return pose.Size() * (sizeof(Graphics::Transform) + sizeof(int));
+        }
+
+        template<typename TRACK>
+        std::size_t TrackSize(const TRACK &track)
+        {
+            return sizeof(TRACK) + track.Size() * sizeof(track[0]);
+        }
+
+        template<typename TRACK>
+        std::size_t ClipSize(const Graphics::Animation::TClip<TRACK> &clip)
+        {
+            std::size_t size = 0;
+            for(std::size_t i = 0; i < clip.Size(); ++i)
+            {
+                const auto &track = clip[clip.GetIdAtIndex(i)];
+                size += TrackSize(track.GetPositionTrack()) + TrackSize(track.GetRotationTrack()) + TrackSize(track.GetScaleTrack());
+            }
+            return size;
+        }
+
+        std::size_t ClipSize(const Graphics::Animation::CompressedClip &clip)
+        {
+            return clip.MemorySize();
+        }
+    }
+
+    AssetFootprint GetFootprint(const Graphics::Font &font)
+    {
+        // the texture is cached on its own
+        return { sizeof(Graphics::Font) + font.NumGlyphs() * sizeof(Graphics::Glyph), 0 };
+    }
+
+    AssetFootprint GetFootprint(const Graphics::Mesh &mesh)
+    {
+        return { sizeof(Graphics::Mesh) + mesh.GetSubMeshes().size() * sizeof(Graphics::SubMesh), mesh.GetVertexBuffer().GetSize() + mesh.GetIndexBuffer().GetSize() };
+    }
+
+    AssetFootprint GetFootprint(const Graphics::Model &model)
+    {
+        // mesh and texture are cached on their own
+        return { sizeof(Graphics::Model), 0 };
+    }
+
+    AssetFootprint GetFootprint(const Graphics::Shader &shader)
+    {
+        return { sizeof(Graphics::Shader), 0 };
+    }
+
+    AssetFootprint GetFootprint(const Graphics::Texture &texture)
+    {
+        return { sizeof(Graphics::Texture), texture.GetSize() };
+    }
+
+    AssetFootprint GetFootprint(const Graphics::Image &image)
+    {
+        return { sizeof(Graphics::Image) + static_cast<std::size_t>(image.GetWidth()) * image.GetHeight() * sizeof(std::uint32_t), 0 };
+    }
+
+    AssetFootprint GetFootprint(const Graphics::Animation::Skeleton &skeleton)
+    {
+        std::size_t size = sizeof(Graphics::Animation::Skeleton);
+        size += PoseSize(skeleton.GetRestPose()) + PoseSize(skeleton.GetBindPose());
+        size += skeleton.GetInvBindPose().size() * sizeof(glm::mat4);
+        for(const auto &name : skeleton.GetJointNames())
+            size += sizeof(name) + name.capacity();
+        return { size, 0 };
+    }
+
+    AssetFootprint GetFootprint(const Graphics::Animation::Animation &animation)
+    {
+        std::size_t size = sizeof(Graphics::Animation::Animation);
+        for(std::size_t i = 0; i < animation.Size(); ++i)
+        {
+            const auto &clip = animation[i];
+            size += sizeof(clip) + clip.GetName().capacity();
+            size += ClipSize(clip);
+        }
+        return { size, 0 };
+    }
+
+    AssetFootprint GetFootprint(const Graphics::MapMesh &mapMesh)
+    {
+        // the section textures are cached on their own
+        std::size_t size = sizeof(Graphics::MapMesh) + mapMesh.GetSections().size() * sizeof(Graphics::MapSection);
+        for(const auto &batch : mapMesh.GetEntityBatches())
+            size += sizeof(batch) + batch.counts.size() * (sizeof(GLsizei) + sizeof(const void*) + sizeof(GLint));
+        for(const auto &range : mapMesh.GetEntityRanges())
+            size += sizeof(range) + range.draws.size() * sizeof(Graphics::MapEntityDraw);
+        return { size, mapMesh.GetVertexBuffer().GetSize() + mapMesh.GetIndexBuffer().GetSize() };
+    }
+
+    AssetFootprint GetFootprint(const Physics::WorldSolids &worldSolids)
+    {
+        std::size_t size = sizeof(Physics::WorldSolids);
+        for(const auto &brush : worldSolids.GetBrushes())
+            size += sizeof(brush) + brush.planes.size() * sizeof(Physics::Plane);
+        return { size, 0 };
+    }
+
+    AssetFootprint GetFootprint(const Game::MapEntities &mapEntities)
+    {
+        std::size_t size = sizeof(Game::MapEntities) + mapEntities.size() * sizeof(Game::MapEntity);
+        for(const auto &entity : mapEntities)
+        {
+            const auto &mesh = entity.Mesh();
+            size += entity.Classname().size();
+            size += mesh.vertices.size() * sizeof(VertexType::MapVertex) + mesh.indices.size() * sizeof(std::uint32_t) + mesh.sections.size() * sizeof(Game::MapEntitySection);
+            for(const auto &brush : entity.Brushes())
+                size += sizeof(brush) + brush.planes.size() * sizeof(Physics::Plane);
+        }
+        return { size, 0 };
+    }
+
+    AssetFootprint GetFootprint(const std::string &text)
+    {
+        return { sizeof(text) + text.capacity(), 0 };
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace RIS
+{
+    namespace Game
+    {
+        class MapEntity;
+        using MapEntities = std::vector<MapEntity>;
+    }
+
+    namespace Physics
+    {
+        class WorldSolids;
+    }
+
+    namespace Graphics
+    {
+        class Model;
+        class Mesh;
+        class Font;
+        class Image;
+        class Shader;
+        class Texture;
+        class MapMesh;
+        namespace Animation
+        {
+            class Animation;
+            class Skeleton;
+        }
+    }
+}
+
+namespace RIS::Loader
+{
+    // memory used by an asset, split into system and video memory
+    struct AssetFootprint
+    {
+        std::size_t cpu = 0;
+        std::size_t gpu = 0;
+
+        std::size_t Total() const { return cpu + gpu; }
+
+        AssetFootprint& operator+=(const AssetFootprint &other)
+        {
+            cpu += other.cpu;
+            gpu += other.gpu;
+            return *this;
+        }
+    };
+
+    AssetFootprint GetFootprint(const Graphics::Font &font);
+    AssetFootprint GetFootprint(const Graphics::Mesh &mesh);
+    AssetFootprint GetFootprint(const Graphics::Model &model);
+    AssetFootprint GetFootprint(const Graphics::Shader &shader);
+    AssetFootprint GetFootprint(const Graphics::Texture &texture);
+    AssetFootprint GetFootprint(const Graphics::Image &image);
+    AssetFootprint GetFootprint(const Graphics::Animation::Skeleton &skeleton);
+    AssetFootprint GetFootprint(const Graphics::Animation::Animation &animation);
+    AssetFootprint GetFootprint(const Graphics::MapMesh &mapMesh);
+    AssetFootprint GetFootprint(const Physics::WorldSolids &worldSolids);
+    AssetFootprint GetFootprint(const Game::MapEntities &mapEntities);
+    AssetFootprint GetFootprint(const std::string &text);
+
+    template<typename AssetType>
+    constexpr std::string_view ASSET_TYPE_NAME = "Unknown";
+
+    template<> constexpr std::string_view ASSET_TYPE_NAME<Graphics::Font> = "Font";
+    template<> constexpr std::string_view ASSET_TYPE_NAME<Graphics::Mesh> = "Mesh";
+    template<> constexpr std::string_view ASSET_TYPE_NAME<Graphics::Model> = "Model";
+    template<> constexpr std::string_view ASSET_TYPE_NAME<Graphics::Shader> = "Shader";
+    template<> constexpr std::string_view ASSET_TYPE_NAME<Graphics::Texture> = "Texture";
+    template<> constexpr std::string_view ASSET_TYPE_NAME<Graphics::Image> = "Image";
+    template<> constexpr std::string_view ASSET_TYPE_NAME<Graphics::Animation::Skeleton> = "Skeleton";
+    template<> constexpr std::string_view ASSET_TYPE_NAME<Graphics::Animation::Animation> = "Animation";
+    template<> constexpr std::string_view ASSET_TYPE_NAME<Graphics::MapMesh> = "MapMesh";
+    template<> constexpr std::string_view ASSET_TYPE_NAME<Physics::WorldSolids> = "WorldSolids";
+    template<> constexpr std::string_view ASSET_TYPE_NAME<Game::MapEntities> = "MapEntities";
+    template<> constexpr std::string_view ASSET_TYPE_NAME<std::string> = "Text";
+}
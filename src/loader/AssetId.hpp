@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace RIS::Loader
+{
+    using AssetId = std::uint64_t;
+
+    // 64 bit FNV-1a
+    constexpr std::uint64_t HashPath(std::string_view path)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for(char c : path)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    constexpr AssetId MakeAssetId(std::uint64_t pathHash, std::size_t typeIndex)
+    {
+        // the same file can be cached as different asset types
+        return pathHash ^ ((typeIndex + 1) * 0x9e3779b97f4a7c15ull);
+    }
+
+    // a resource path with its hash. constexpr paths hash at compile time
+    struct AssetPath
+    {
+        constexpr AssetPath(std::string_view path) : path(path), hash(HashPath(path)) {}
+        constexpr AssetPath(const char *path) : AssetPath(std::string_view(path)) {}
+        AssetPath(const std::string &path) : AssetPath(std::string_view(path)) {}
+
+        std::string_view path;
+        std::uint64_t hash;
+    };
+}
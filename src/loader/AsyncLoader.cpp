@@ -0,0 +1,173 @@
+#include "loader/AsyncLoader.hpp"
+
+namespace RIS::Loader
+{
+    AsyncLoader::AsyncLoader(WorkerPool &pool)
+        : pool(pool), renderThread(std::this_thread::get_id())
+    {}
+
+    AsyncLoader::~AsyncLoader()
+    {
+        Shutdown();
+    }
+
+    void AsyncLoader::Enqueue(Job &&job, Cancel &&cancel)
+    {
+        QueuedJob queued = { std::move(job), std::move(cancel) };
+        bool stopped = false;
+        bool queuedForWorker = false;
+        {
+            std::lock_guard lock(jobMutex);
+            stopped = !running;
+            if(!stopped)
+            {
+                ++pending;
+                // without workers (emscripten) jobs run inline
+                if(pool.NumWorkers() > 0)
+                {
+                    jobs.push_back(std::move(queued));
+                    ++queuedRuns;
+                    queuedForWorker = true;
+                }
+            }
+        }
+
+        if(stopped)
+        {
+            if(queued.cancel)
+                queued.cancel();
+        }
+        else if(queuedForWorker)
+        {
+            pool.Enqueue([this]{ RunQueued(); });
+        }
+        else
+        {
+            Run(queued);
+        }
+    }
+
+    void AsyncLoader::Update(std::chrono::duration<float, std::milli> budget)
+    {
+        using clock = std::chrono::steady_clock;
+        auto start = clock::now();
+
+        // finalizers that have to wait are queued again, they get their next chance in the next frame
+        std::size_t count;
+        {
+            std::lock_guard lock(finalizerMutex);
+            count = finalizers.size();
+        }
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            if(i > 0 && clock::now() - start >= budget)
+                return;
+
+            QueuedFinalizer queued;
+            {
+                std::lock_guard lock(finalizerMutex);
+                if(finalizers.empty())
+                    return;
+                queued = std::move(finalizers.front());
+                finalizers.pop_front();
+            }
+
+            if(queued.finalizer && !queued.finalizer())
+            {
+                std::lock_guard lock(finalizerMutex);
+                finalizers.push_back(std::move(queued));
+                continue;
+            }
+            --pending;
+        }
+    }
+
+    bool AsyncLoader::RunJob()
+    {
+        QueuedJob queued;
+        {
+            std::lock_guard lock(jobMutex);
+            if(!running || jobs.empty())
+                return false;
+            queued = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        Run(queued);
+        return true;
+    }
+
+    void AsyncLoader::Shutdown()
+    {
+        std::deque<QueuedJob> cancelledJobs;
+        {
+            std::unique_lock lock(jobMutex);
+            if(!running)
+                return;
+            running = false;
+            cancelledJobs.swap(jobs);
+
+            // jobs that already started finish on their worker, their finalizers are cancelled below
+            runsCondition.wait(lock, [this]{ return queuedRuns == 0; });
+        }
+
+        // whoever waits for these loads gets an error instead of waiting forever
+        std::deque<QueuedFinalizer> cancelledFinalizers;
+        {
+            std::lock_guard lock(finalizerMutex);
+            cancelledFinalizers.swap(finalizers);
+        }
+        for(auto &queued : cancelledJobs)
+        {
+            if(queued.cancel)
+                queued.cancel();
+        }
+        for(auto &queued : cancelledFinalizers)
+        {
+            if(queued.cancel)
+                queued.cancel();
+        }
+        pending = 0;
+    }
+
+    bool AsyncLoader::IsIdle() const
+    {
+        return pending == 0;
+    }
+
+    bool AsyncLoader::IsRenderThread() const
+    {
+        return std::this_thread::get_id() == renderThread;
+    }
+
+    std::size_t AsyncLoader::NumWorkers() const
+    {
+        return pool.NumWorkers();
+    }
+
+    // one run per queued job, the job may already have been taken by RunJob or Shutdown
+    void AsyncLoader::RunQueued()
+    {
+        RunJob();
+
+        // notified under the lock, Shutdown may return and the loader go away right after
+        std::lock_guard lock(jobMutex);
+        --queuedRuns;
+        runsCondition.notify_all();
+    }
+
+    void AsyncLoader::Run(QueuedJob &queued)
+    {
+        Finalizer finalizer = queued.job();
+
+        std::lock_guard lock(finalizerMutex);
+        finalizers.push_back({ std::move(finalizer), std::move(queued.cancel) });
+    }
+
+    AsyncLoader& GetAsyncLoader()
+    {
+        static AsyncLoader asyncLoader(GetWorkerPool());
+        return asyncLoader;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "misc/WorkerPool.hpp"
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+namespace RIS::Loader
+{
+    class AsyncLoader
+    {
+    public:
+        // returns false if it has to wait for something, it is run again on the next Update
+        using Finalizer = std::function<bool()>;
+        using Job = std::function<Finalizer()>;
+        // called instead of the job or its finalizer if the loader shuts down before they ran
+        using Cancel = std::function<void()>;
+
+        // jobs run on the workers of pool, the thread that creates the loader is the render thread
+        AsyncLoader(WorkerPool &pool);
+        ~AsyncLoader();
+
+        AsyncLoader(const AsyncLoader&) = delete;
+        AsyncLoader& operator=(const AsyncLoader&) = delete;
+        AsyncLoader(AsyncLoader&&) = delete;
+        AsyncLoader& operator=(AsyncLoader&&) = delete;
+
+        void Enqueue(Job &&job, Cancel &&cancel = {});
+
+        // runs finished jobs on the calling (render) thread until the budget is used up
+        void Update(std::chrono::duration<float, std::milli> budget);
+        // runs one queued job on the calling thread, returns false if there was none
+        bool RunJob();
+        void Shutdown();
+
+        bool IsIdle() const;
+        bool IsRenderThread() const;
+        std::size_t NumWorkers() const;
+
+    private:
+        struct QueuedJob
+        {
+            Job job;
+            Cancel cancel;
+        };
+
+        struct QueuedFinalizer
+        {
+            Finalizer finalizer;
+            Cancel cancel;
+        };
+
+        void RunQueued();
+        void Run(QueuedJob &job);
+
+    private:
+        WorkerPool &pool;
+        std::thread::id renderThread;
+
+        std::deque<QueuedJob> jobs;
+        std::deque<QueuedFinalizer> finalizers;
+
+        mutable std::mutex jobMutex;
+        mutable std::mutex finalizerMutex;
+        // runs handed to the pool that haven't finished yet, Shutdown waits for them
+        std::size_t queuedRuns = 0;
+        std::condition_variable runsCondition;
+
+        std::atomic<std::size_t> pending = 0;
+        bool running = true;
+
+    };
+
+    AsyncLoader& GetAsyncLoader();
+}
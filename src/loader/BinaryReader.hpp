@@ -0,0 +1,140 @@
+#pragma once
+
+#include "RisExcept.hpp"
+
+#include <gsl/span>
+#include <fmt/format.h>
+
+#include <string>
+#include <type_traits>
+#include <cstring>
+#include <cstddef>
+
+namespace RIS::Loader
+{
+    // elements of T read in place, without any assumptions about the alignment of the data
+    template<typename T>
+    class ArrayView
+    {
+    public:
+        ArrayView(const std::byte *data, std::size_t count) : data(data), count(count) {}
+
+        T operator[](std::size_t index) const
+        {
+            T value;
+            std::memcpy(&value, data + index * sizeof(T), sizeof(T));
+            return value;
+        }
+
+        void CopyTo(T *dst) const
+        {
+            if(count > 0)
+                std::memcpy(dst, data, count * sizeof(T));
+        }
+
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+    private:
+        const std::byte *data;
+        std::size_t count;
+
+    };
+
+    // reads the little endian map formats (every platform we build for is little endian)
+    // straight from the resource bytes. throws if a read would go past the end
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const std::byte *data, std::size_t size) : data(data), size(size) {}
+        BinaryReader(gsl::span<const std::byte> bytes) : BinaryReader(bytes.data(), bytes.size()) {}
+
+        template<typename T>
+        void Read(T &value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            std::memcpy(&value, Advance(sizeof(T)), sizeof(T));
+        }
+
+        template<typename T>
+        T Read()
+        {
+            T value;
+            Read(value);
+            return value;
+        }
+
+        template<typename T>
+        void ReadArray(T *dst, std::size_t count)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            CheckCount<T>(count);
+            const std::byte *src = Advance(count * sizeof(T));
+            if(count > 0)
+                std::memcpy(dst, src, count * sizeof(T));
+        }
+
+        template<typename T>
+        ArrayView<T> View(std::size_t count)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            CheckCount<T>(count);
+            return ArrayView<T>(Advance(count * sizeof(T)), count);
+        }
+
+        // a fixed size, zero padded string
+        std::string ReadString(std::size_t length)
+        {
+            const char *chars = reinterpret_cast<const char*>(Advance(length));
+            if(length == 0)
+                return {};
+            return std::string(chars, strnlen(chars, length));
+        }
+
+        void Skip(std::size_t bytes)
+        {
+            Advance(bytes);
+        }
+
+        template<typename T>
+        void SkipArray(std::size_t count)
+        {
+            CheckCount<T>(count);
+            Advance(count * sizeof(T));
+        }
+
+        std::size_t Offset() const { return offset; }
+        std::size_t Remaining() const { return size - offset; }
+        bool AtEnd() const { return offset == size; }
+
+    private:
+        const std::byte* Advance(std::size_t bytes)
+        {
+            if(bytes > size - offset)
+                throw RISException(fmt::format("Unexpected end of data at offset {} (needed {} bytes, {} left)", offset, bytes, size - offset));
+
+            const std::byte *current = data + offset;
+            offset += bytes;
+            return current;
+        }
+
+        template<typename T>
+        void CheckCount(std::size_t count) const
+        {
+            if(count > (size - offset) / sizeof(T))
+                throw RISException(fmt::format("Unexpected end of data at offset {} ({} elements of {} bytes, {} bytes left)", offset, count, sizeof(T), size - offset));
+        }
+
+    private:
+        const std::byte *data;
+        std::size_t size;
+        std::size_t offset = 0;
+
+    };
+
+    template<std::size_t N>
+    std::string FixedString(const char (&chars)[N])
+    {
+        return std::string(chars, strnlen(chars, N));
+    }
+}
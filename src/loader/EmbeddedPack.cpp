@@ -31,4 +31,12 @@ namespace RIS::Loader
     {
         return resources.count(res) > 0;
     }
+
+    std::vector<std::string> EmbeddedPack::List() const
+    {
+        std::vector<std::string> names;
+        for(const auto &[name, data] : resources)
+            names.push_back(name);
+        return names;
+    }
 }
@@ -13,6 +13,7 @@ namespace RIS::Loader
 
         std::vector<std::byte> Read(const std::string &res) const override;
         bool Contains(const std::string &res) const override;
+        std::vector<std::string> List() const override;
 
     private:
         static const std::map<std::string, std::string> resources;
@@ -1,4 +1,5 @@
 #include "loader/FilesystemPack.hpp"
+#include "loader/MappedFile.hpp"
 
 #include <fstream>
 
@@ -29,4 +30,27 @@ namespace RIS::Loader
         auto path = folder / res;
         return std::filesystem::exists(path) && std::filesystem::is_regular_file(path);
     }
+
+    std::vector<std::string> FilesystemPack::List() const
+    {
+        std::vector<std::string> resources;
+        std::error_code error;
+        for(auto it = std::filesystem::recursive_directory_iterator(folder, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+        {
+            if(it->is_regular_file())
+                resources.push_back(it->path().lexically_relative(folder).generic_string());
+        }
+        return resources;
+    }
+
+    ResourceView FilesystemPack::Map(const std::string &res) const
+    {
+        auto file = std::make_shared<MappedFile>(folder / res);
+        if(!file->IsOpen())
+            return ResourceView(Read(res));
+
+        const std::byte *data = file->Data();
+        std::size_t size = file->Size();
+        return ResourceView(std::move(file), data, size);
+    }
 }
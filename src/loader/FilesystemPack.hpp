@@ -19,6 +19,8 @@ namespace RIS::Loader
 
         std::vector<std::byte> Read(const std::string &res) const override;
         bool Contains(const std::string &res) const override;
+        std::vector<std::string> List() const override;
+        ResourceView Map(const std::string &res) const override;
 
     private:
         std::filesystem::path folder;
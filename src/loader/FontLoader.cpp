@@ -1,5 +1,8 @@
 #include "loader/FontLoader.hpp"
 
+#include "loader/TextureLoader.hpp"
+#include "loader/Loader.hpp"
+
 #include "graphics/Font.hpp"
 
 #include <rapidjson/rapidjson.h>
@@ -12,71 +15,113 @@
 
 namespace RIS::Loader
 {
-    template<>
-    std::shared_ptr<Graphics::Font> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    namespace
     {
-        using namespace std::literals::string_literals;
-
-        std::string fontStr(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        struct FontData
+        {
+            float ascender;
+            float descender;
+            float height;
+            float maxAdvance;
+            std::string fontName;
+            float size;
+            float spaceAdvance;
+            std::string texturePath;
+            std::unordered_map<uint32_t, Graphics::Glyph> glyphs;
+        };
 
-        rapidjson::Document fontJson;
-        rapidjson::ParseResult res = fontJson.Parse(fontStr.c_str()); 
-        if(res.IsError())
+        std::shared_ptr<FontData> ParseFont(const ResourceView &bytes, const std::string &name)
         {
-            std::string errorMsg = rapidjson::GetParseError_En(res.Code());
-            Logger::Instance().Error("Failed to parse font ("s + name + "): "s + errorMsg + "(" + std::to_string(res.Offset()) + ")");
-            return nullptr;
-        }
+            using namespace std::literals::string_literals;
+
+            std::string fontStr(reinterpret_cast<const char*>(bytes.data()), bytes.size());
 
-        float ascender = fontJson["ascender"].GetFloat();
-        //float bitmapWidth = fontJson["bitmap_width"].GetInt();
-        //float bitmapHeight = fontJson["bitmap_height"].GetInt();
-        float descender = fontJson["descender"].GetFloat();
-        float height = fontJson["height"].GetFloat();
-        float maxAdvance = fontJson["max_advance"].GetFloat();
-        std::string fontName = fontJson["name"].GetString();
-        float size = fontJson["size"].GetFloat();
-        float spaceAdvance = fontJson["space_advance"].GetFloat();
+            rapidjson::Document fontJson;
+            rapidjson::ParseResult res = fontJson.Parse(fontStr.c_str()); 
+            if(res.IsError())
+            {
+                std::string errorMsg = rapidjson::GetParseError_En(res.Code());
+                Logger::Instance().Error("Failed to parse font ("s + name + "): "s + errorMsg + "(" + std::to_string(res.Offset()) + ")");
+                return nullptr;
+            }
 
-        std::string fontTexturePath = "fonts/" + fontName + ".dds";
-        auto fontTexture = Load<Graphics::Texture>(resourcePack.Read(fontTexturePath), fontTexturePath, {}, resourcePack);
+            auto font = std::make_shared<FontData>();
+            font->ascender = fontJson["ascender"].GetFloat();
+            //float bitmapWidth = fontJson["bitmap_width"].GetInt();
+            //float bitmapHeight = fontJson["bitmap_height"].GetInt();
+            font->descender = fontJson["descender"].GetFloat();
+            font->height = fontJson["height"].GetFloat();
+            font->maxAdvance = fontJson["max_advance"].GetFloat();
+            font->fontName = fontJson["name"].GetString();
+            font->size = fontJson["size"].GetFloat();
+            font->spaceAdvance = fontJson["space_advance"].GetFloat();
 
-        std::unordered_map<uint32_t, Graphics::Glyph> glyphs;
+            font->texturePath = "fonts/" + font->fontName + ".dds";
 
-        const rapidjson::Value &glyphData = fontJson["glyph_data"];
-        for (auto itr = glyphData.MemberBegin(); itr != glyphData.MemberEnd(); ++itr)
-        {
-            const rapidjson::Value &glyphJson = itr->value;
-            Graphics::Glyph glyph = { 0 };
-            glyph.advanceX = glyphJson["advance_x"].GetFloat();
-            glyph.bboxHeight = glyphJson["bbox_height"].GetFloat();
-            glyph.bboxWidth = glyphJson["bbox_width"].GetFloat();
-            glyph.bearingX = glyphJson["bearing_x"].GetFloat();
-            glyph.bearingY = glyphJson["bearing_y"].GetFloat();
-            glyph.s0 = glyphJson["s0"].GetFloat();
-            glyph.t0 = glyphJson["t0"].GetFloat();
-            glyph.s1 = glyphJson["s1"].GetFloat();
-            glyph.t1 = glyphJson["t1"].GetFloat();
-
-            auto charcode = glyphJson["charcode"].GetString();
-            auto begin = charcode;
-            auto end = charcode + std::strlen(charcode);
-            glyph.charCode = utf8::next(begin, end);
-
-            const rapidjson::Value &kerningsJson = glyphJson["kernings"];
-            for(auto kItr = kerningsJson.MemberBegin(); kItr != kerningsJson.MemberEnd(); ++kItr)
+            auto &glyphs = font->glyphs;
+
+            const rapidjson::Value &glyphData = fontJson["glyph_data"];
+            for (auto itr = glyphData.MemberBegin(); itr != glyphData.MemberEnd(); ++itr)
             {
-                auto char2 = kItr->name.GetString();
-                begin = char2;
-                end = char2 + std::strlen(char2);
-                uint32_t c = utf8::next(begin, end);
-                float val = kItr->value.GetFloat();
-                glyph.kernings.insert({ c, val });
+                const rapidjson::Value &glyphJson = itr->value;
+                Graphics::Glyph glyph = { 0 };
+                glyph.advanceX = glyphJson["advance_x"].GetFloat();
+                glyph.bboxHeight = glyphJson["bbox_height"].GetFloat();
+                glyph.bboxWidth = glyphJson["bbox_width"].GetFloat();
+                glyph.bearingX = glyphJson["bearing_x"].GetFloat();
+                glyph.bearingY = glyphJson["bearing_y"].GetFloat();
+                glyph.s0 = glyphJson["s0"].GetFloat();
+                glyph.t0 = glyphJson["t0"].GetFloat();
+                glyph.s1 = glyphJson["s1"].GetFloat();
+                glyph.t1 = glyphJson["t1"].GetFloat();
+
+                auto charcode = glyphJson["charcode"].GetString();
+                auto begin = charcode;
+                auto end = charcode + std::strlen(charcode);
+                glyph.charCode = utf8::next(begin, end);
+
+                const rapidjson::Value &kerningsJson = glyphJson["kernings"];
+                for(auto kItr = kerningsJson.MemberBegin(); kItr != kerningsJson.MemberEnd(); ++kItr)
+                {
+                    auto char2 = kItr->name.GetString();
+                    begin = char2;
+                    end = char2 + std::strlen(char2);
+                    uint32_t c = utf8::next(begin, end);
+                    float val = kItr->value.GetFloat();
+                    glyph.kernings.insert({ c, val });
+                }
+
+                glyphs.insert({ glyph.charCode, glyph });
             }
 
-            glyphs.insert({ glyph.charCode, glyph });
+            return font;
         }
 
-        return std::make_shared<Graphics::Font>(ascender, descender, height, maxAdvance, fontName, size, spaceAdvance, glyphs, fontTexture);
+        Graphics::Font::Ptr BuildFont(const FontData &font, Graphics::Texture::Ptr fontTexture)
+        {
+            return std::make_shared<Graphics::Font>(font.ascender, font.descender, font.height, font.maxAdvance, font.fontName, font.size, font.spaceAdvance, font.glyphs, fontTexture);
+        }
+    }
+
+    template<>
+    std::shared_ptr<Graphics::Font> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        auto font = ParseFont(bytes, name);
+        if(!font)
+            return nullptr;
+
+        auto fontTexture = Load<Graphics::Texture>(font->texturePath, resourcePack);
+        return BuildFont(*font, fontTexture);
+    }
+
+    template<>
+    Upload<Graphics::Font> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        auto font = ParseFont(bytes, name);
+        if(!font)
+            return Ready<Graphics::Font>(nullptr);
+
+        auto textureFuture = LoadAsync<Graphics::Texture>(font->texturePath, resourcePack);
+        return Upload<Graphics::Font>([textureFuture]{ return IsReady(textureFuture); }, [font, textureFuture]{ return BuildFont(*font, textureFuture.get()); });
     }
 }
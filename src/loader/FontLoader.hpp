@@ -9,5 +9,8 @@ namespace RIS::Graphics { class Font; }
 namespace RIS::Loader
 {
     template<>
-    std::shared_ptr<Graphics::Font> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    std::shared_ptr<Graphics::Font> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
+    template<>
+    Upload<Graphics::Font> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
 }
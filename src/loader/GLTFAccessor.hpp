@@ -0,0 +1,117 @@
+#pragma once
+
+#include "loader/TinyGLTF.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+namespace RIS::Loader
+{
+    namespace GLTFAccessorDetail
+    {
+        template<typename T>
+        constexpr int ComponentType()
+        {
+            if constexpr(std::is_same_v<T, float>) return TINYGLTF_COMPONENT_TYPE_FLOAT;
+            else if constexpr(std::is_same_v<T, std::int8_t>) return TINYGLTF_COMPONENT_TYPE_BYTE;
+            else if constexpr(std::is_same_v<T, std::uint8_t>) return TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+            else if constexpr(std::is_same_v<T, std::int16_t>) return TINYGLTF_COMPONENT_TYPE_SHORT;
+            else if constexpr(std::is_same_v<T, std::uint16_t>) return TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT;
+            else if constexpr(std::is_same_v<T, std::uint32_t>) return TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT;
+            else return -1;
+        }
+
+        template<typename S>
+        S Get(const unsigned char *src)
+        {
+            S value;
+            std::memcpy(&value, src, sizeof(S));
+            return value;
+        }
+
+        // normalized integers map to [0, 1] or [-1, 1] as described in the gltf spec
+        template<typename T>
+        T Convert(const unsigned char *src, int componentType, bool normalized)
+        {
+            switch(componentType)
+            {
+            case TINYGLTF_COMPONENT_TYPE_FLOAT: return static_cast<T>(Get<float>(src));
+            case TINYGLTF_COMPONENT_TYPE_BYTE: return normalized ? static_cast<T>(std::max(Get<std::int8_t>(src) / 127.0f, -1.0f)) : static_cast<T>(Get<std::int8_t>(src));
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: return normalized ? static_cast<T>(Get<std::uint8_t>(src) / 255.0f) : static_cast<T>(Get<std::uint8_t>(src));
+            case TINYGLTF_COMPONENT_TYPE_SHORT: return normalized ? static_cast<T>(std::max(Get<std::int16_t>(src) / 32767.0f, -1.0f)) : static_cast<T>(Get<std::int16_t>(src));
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: return normalized ? static_cast<T>(Get<std::uint16_t>(src) / 65535.0f) : static_cast<T>(Get<std::uint16_t>(src));
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: return static_cast<T>(Get<std::uint32_t>(src));
+            }
+            return T{};
+        }
+    }
+
+    // copies the elements of an accessor to out, converting every component to T.
+    // out has to have room for accessor.count elements, outStride is the distance between
+    // two elements in bytes (0 for tightly packed) so it can write straight into interleaved vertices.
+    // returns false if the accessor doesn't fit its buffer or has a different number of components
+    template<typename T>
+    bool ReadAccessor(const tinygltf::Model &model, const tinygltf::Accessor &accessor, std::size_t numComponents, T *out, std::size_t outStride = 0)
+    {
+        using namespace GLTFAccessorDetail;
+
+        if(static_cast<std::size_t>(tinygltf::GetNumComponentsInType(accessor.type)) != numComponents || accessor.sparse.isSparse)
+            return false;
+
+        std::size_t componentSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+        std::size_t elementSize = componentSize * numComponents;
+        std::size_t outElementSize = sizeof(T) * numComponents;
+        if(outStride == 0)
+            outStride = outElementSize;
+
+        auto *dst = reinterpret_cast<unsigned char*>(out);
+        if(accessor.bufferView < 0)
+        {
+            // no buffer view means all zeros
+            for(std::size_t i = 0; i < accessor.count; ++i)
+                std::memset(dst + i * outStride, 0, outElementSize);
+            return true;
+        }
+
+        if(accessor.bufferView >= static_cast<int>(model.bufferViews.size()))
+            return false;
+        const auto &bufferView = model.bufferViews[accessor.bufferView];
+        if(bufferView.buffer < 0 || bufferView.buffer >= static_cast<int>(model.buffers.size()))
+            return false;
+        const auto &buffer = model.buffers[bufferView.buffer];
+
+        std::size_t stride = bufferView.byteStride != 0 ? bufferView.byteStride : elementSize;
+        if(accessor.count == 0)
+            return true;
+        std::size_t byteLength = accessor.byteOffset + stride * (accessor.count - 1) + elementSize;
+        if(componentSize == 0 || stride < elementSize || byteLength > bufferView.byteLength || bufferView.byteOffset + bufferView.byteLength > buffer.data.size())
+            return false;
+
+        const unsigned char *src = buffer.data.data() + bufferView.byteOffset + accessor.byteOffset;
+        if(accessor.componentType == ComponentType<T>() && !accessor.normalized)
+        {
+            if(stride == elementSize && outStride == outElementSize)
+            {
+                std::memcpy(dst, src, elementSize * accessor.count);
+                return true;
+            }
+
+            for(std::size_t i = 0; i < accessor.count; ++i)
+                std::memcpy(dst + i * outStride, src + i * stride, elementSize);
+            return true;
+        }
+
+        for(std::size_t i = 0; i < accessor.count; ++i)
+        {
+            for(std::size_t c = 0; c < numComponents; ++c)
+            {
+                T value = Convert<T>(src + i * stride + c * componentSize, accessor.componentType, accessor.normalized);
+                std::memcpy(dst + i * outStride + c * sizeof(T), &value, sizeof(T));
+            }
+        }
+        return true;
+    }
+}
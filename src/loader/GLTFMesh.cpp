@@ -0,0 +1,345 @@
+#include "loader/MeshData.hpp"
+
+#define TINYGLTF_IMPLEMENTATION
+#include "loader/TinyGLTF.hpp"
+#include "loader/GLTFAccessor.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+#include <fmt/format.h>
+
+namespace RIS::Loader
+{
+    namespace
+    {
+        template<typename T>
+        bool ReadAttribute(const tinygltf::Model &model, const tinygltf::Primitive &primitive, const std::string &attribute, std::size_t numComponents, std::size_t numVertices, T *first)
+        {
+            const auto &accessor = model.accessors.at(primitive.attributes.at(attribute));
+            return accessor.count == numVertices && ReadAccessor(model, accessor, numComponents, first, sizeof(VertexType::ModelVertex));
+        }
+
+        bool HasRequiredAttributes(const std::map<std::string, int> &attribs)
+        {
+            return attribs.count("POSITION") && attribs.count("NORMAL") && attribs.count("TEXCOORD_0");
+        }
+
+        glm::mat4 NodeTransform(const tinygltf::Node &node)
+        {
+            if(node.matrix.size() == 16)
+                return glm::mat4(glm::make_mat4(node.matrix.data()));
+
+            glm::mat4 transform(1.0f);
+            if(node.translation.size() == 3)
+                transform = glm::translate(transform, glm::vec3(glm::make_vec3(node.translation.data())));
+            if(node.rotation.size() == 4)
+                transform *= glm::mat4_cast(glm::quat(static_cast<float>(node.rotation[3]), static_cast<float>(node.rotation[0]), static_cast<float>(node.rotation[1]), static_cast<float>(node.rotation[2])));
+            if(node.scale.size() == 3)
+                transform = glm::scale(transform, glm::vec3(glm::make_vec3(node.scale.data())));
+            return transform;
+        }
+
+        // calls visit for every node of the scene that has a mesh, together with its world transform.
+        // files without a scene start at every node that isn't the child of another one
+        template<typename F>
+        void VisitMeshNodes(const tinygltf::Model &model, F &&visit)
+        {
+            // nothing places the meshes, every one is used once as it is
+            if(model.nodes.empty())
+            {
+                for(std::size_t i = 0; i < model.meshes.size(); ++i)
+                {
+                    tinygltf::Node node;
+                    node.mesh = static_cast<int>(i);
+                    visit(node, glm::mat4(1.0f));
+                }
+                return;
+            }
+
+            std::vector<int> roots;
+            if(!model.scenes.empty())
+            {
+                int scene = model.defaultScene >= 0 && model.defaultScene < static_cast<int>(model.scenes.size()) ? model.defaultScene : 0;
+                roots = model.scenes[scene].nodes;
+            }
+            else
+            {
+                std::vector<bool> isChild(model.nodes.size(), false);
+                for(const auto &node : model.nodes)
+                {
+                    for(int child : node.children)
+                    {
+                        if(child >= 0 && child < static_cast<int>(model.nodes.size()))
+                            isChild[child] = true;
+                    }
+                }
+                for(std::size_t i = 0; i < model.nodes.size(); ++i)
+                {
+                    if(!isChild[i])
+                        roots.push_back(static_cast<int>(i));
+                }
+            }
+
+            // nodes are visited once, a broken file with cycles can't loop forever
+            std::vector<bool> visited(model.nodes.size(), false);
+            std::vector<std::pair<int, glm::mat4>> stack;
+            for(auto it = roots.rbegin(); it != roots.rend(); ++it)
+                stack.emplace_back(*it, glm::mat4(1.0f));
+
+            while(!stack.empty())
+            {
+                auto [nodeId, parentTransform] = stack.back();
+                stack.pop_back();
+                if(nodeId < 0 || nodeId >= static_cast<int>(model.nodes.size()) || visited[nodeId])
+                    continue;
+                visited[nodeId] = true;
+
+                const auto &node = model.nodes[nodeId];
+                glm::mat4 transform = parentTransform * NodeTransform(node);
+                if(node.mesh >= 0 && node.mesh < static_cast<int>(model.meshes.size()))
+                    visit(node, transform);
+
+                for(auto it = node.children.rbegin(); it != node.children.rend(); ++it)
+                    stack.emplace_back(*it, transform);
+            }
+        }
+    }
+
+    std::optional<MeshData> ParseGLTFMesh(const std::byte *data, std::size_t size, std::string &warning)
+    {
+        tinygltf::TinyGLTF gltfLoader;
+        tinygltf::Model model;
+        std::string err;
+
+        bool result = gltfLoader.LoadBinaryFromMemory(&model, &err, &warning, reinterpret_cast<const unsigned char*>(data), static_cast<unsigned int>(size));
+        if(!result)
+        {
+            warning += err;
+            return std::nullopt;
+        }
+        return ExtractGLTFMesh(model, warning);
+    }
+
+    std::vector<std::size_t> SkinJointOrder(const tinygltf::Model &model, const std::vector<int> &joints)
+    {
+        constexpr std::size_t NO_PARENT = SIZE_MAX;
+
+        // the parent of a joint is the first joint that has its node as a child
+        std::unordered_map<int, std::size_t> jointOfNode;
+        for(std::size_t i = 0; i < joints.size(); ++i)
+            jointOfNode.emplace(joints[i], i);
+        std::vector<std::size_t> parents(joints.size(), NO_PARENT);
+        for(std::size_t i = 0; i < joints.size(); ++i)
+        {
+            for(int child : model.nodes.at(joints[i]).children)
+            {
+                auto it = jointOfNode.find(child);
+                if(it != std::end(jointOfNode) && it->second != i && parents[it->second] == NO_PARENT)
+                    parents[it->second] = i;
+            }
+        }
+
+        // every joint goes in after its ancestors, a skin that is ordered already stays as it is.
+        // the walk up stops at joints it has seen, so a broken file with cycles still ends
+        enum : std::uint8_t { UNSEEN, SEEN, PLACED };
+        std::vector<std::uint8_t> state(joints.size(), UNSEEN);
+        std::vector<std::size_t> order, chain;
+        order.reserve(joints.size());
+        for(std::size_t i = 0; i < joints.size(); ++i)
+        {
+            chain.clear();
+            for(std::size_t j = i; j != NO_PARENT && state[j] == UNSEEN; j = parents[j])
+            {
+                state[j] = SEEN;
+                chain.push_back(j);
+            }
+            for(auto it = chain.rbegin(); it != chain.rend(); ++it)
+            {
+                state[*it] = PLACED;
+                order.push_back(*it);
+            }
+        }
+        return order;
+    }
+
+    std::optional<MeshData> ExtractGLTFMesh(const tinygltf::Model &model, std::string &warning)
+    {
+        MeshData meshData;
+        auto &vertices = meshData.vertices;
+        std::vector<std::uint32_t> indices;
+        bool valid = true;
+
+        // JOINTS_0 indexes the joints of the skin, the skeleton puts them in SkinJointOrder
+        std::map<int, std::vector<std::int16_t>> jointRemaps;
+        auto getJointRemap = [&model, &jointRemaps](int skin) -> const std::vector<std::int16_t>&
+        {
+            auto [it, inserted] = jointRemaps.try_emplace(skin);
+            if(inserted)
+            {
+                auto order = SkinJointOrder(model, model.skins[skin].joints);
+                it->second.resize(order.size());
+                for(std::size_t bone = 0; bone < order.size(); ++bone)
+                    it->second[order[bone]] = static_cast<std::int16_t>(bone);
+            }
+            return it->second;
+        };
+
+        // every mesh instance of the scene ends up in one vertex and index buffer, placed by its node.
+        // skinned meshes ignore the node transform, their joints place them
+        VisitMeshNodes(model, [&](const tinygltf::Node &node, const glm::mat4 &nodeTransform)
+        {
+            if(!valid)
+                return;
+
+            glm::mat4 transform = node.skin >= 0 ? glm::mat4(1.0f) : nodeTransform;
+            bool isIdentity = transform == glm::mat4(1.0f);
+            glm::mat3 normalTransform = glm::transpose(glm::inverse(glm::mat3(transform)));
+            // mirrored nodes turn the triangles inside out
+            bool flipWinding = glm::determinant(glm::mat3(transform)) < 0.0f;
+
+            const auto &mesh = model.meshes[node.mesh];
+            for(const auto &primitive : mesh.primitives)
+            {
+                if(primitive.mode != -1 && primitive.mode != TINYGLTF_MODE_TRIANGLES)
+                {
+                    warning += fmt::format("skipped non triangle primitive in {}\n", mesh.name);
+                    continue;
+                }
+                if(!HasRequiredAttributes(primitive.attributes) || primitive.indices < 0)
+                {
+                    warning += fmt::format("skipped primitive without the required attributes in {}\n", mesh.name);
+                    continue;
+                }
+
+                std::size_t baseVertex = vertices.size();
+                std::size_t numVertices = model.accessors.at(primitive.attributes.at("POSITION")).count;
+                vertices.resize(baseVertex + numVertices, { glm::vec3(0.0f), glm::vec3(0.0f), glm::vec2(0.0f), glm::i16vec4(0), glm::vec4(0.0f) });
+
+                // every attribute is written straight into the interleaved vertices
+                auto &first = vertices[baseVertex];
+                if(numVertices > 0
+                    && (!ReadAttribute(model, primitive, "POSITION", 3, numVertices, &first.position.x)
+                    || !ReadAttribute(model, primitive, "NORMAL", 3, numVertices, &first.normal.x)
+                    || !ReadAttribute(model, primitive, "TEXCOORD_0", 2, numVertices, &first.texCoords.x)
+                    || (primitive.attributes.count("JOINTS_0") && !ReadAttribute(model, primitive, "JOINTS_0", 4, numVertices, &first.joints.x))
+                    || (primitive.attributes.count("WEIGHTS_0") && !ReadAttribute(model, primitive, "WEIGHTS_0", 4, numVertices, &first.weights.x))))
+                {
+                    warning += fmt::format("invalid vertex attribute accessor in {}", mesh.name);
+                    valid = false;
+                    return;
+                }
+
+                if(node.skin >= 0 && primitive.attributes.count("JOINTS_0"))
+                {
+                    if(node.skin >= static_cast<int>(model.skins.size()))
+                    {
+                        warning += fmt::format("invalid skin in {}", mesh.name);
+                        valid = false;
+                        return;
+                    }
+
+                    const auto &jointRemap = getJointRemap(node.skin);
+                    for(std::size_t i = baseVertex; i < vertices.size(); ++i)
+                    {
+                        auto &joints = vertices[i].joints;
+                        for(int c = 0; c < 4; ++c)
+                        {
+                            if(joints[c] < 0 || static_cast<std::size_t>(joints[c]) >= jointRemap.size())
+                            {
+                                warning += fmt::format("joint out of range in {}", mesh.name);
+                                valid = false;
+                                return;
+                            }
+                            joints[c] = jointRemap[joints[c]];
+                        }
+                    }
+                }
+
+                if(!isIdentity)
+                {
+                    for(std::size_t i = baseVertex; i < vertices.size(); ++i)
+                    {
+                        vertices[i].position = glm::vec3(transform * glm::vec4(vertices[i].position, 1.0f));
+                        glm::vec3 normal = normalTransform * vertices[i].normal;
+                        float length = glm::length(normal);
+                        vertices[i].normal = length > 0.0f ? normal / length : normal;
+                    }
+                }
+
+                std::size_t baseIndex = indices.size();
+                const auto &indexAccessor = model.accessors.at(primitive.indices);
+                indices.resize(baseIndex + indexAccessor.count);
+                if(!ReadAccessor(model, indexAccessor, 1, indices.data() + baseIndex))
+                {
+                    warning += fmt::format("invalid index accessor in {}", mesh.name);
+                    valid = false;
+                    return;
+                }
+
+                for(std::size_t i = baseIndex; i < indices.size(); ++i)
+                {
+                    if(indices[i] >= numVertices)
+                    {
+                        warning += fmt::format("index out of range in {}", mesh.name);
+                        valid = false;
+                        return;
+                    }
+                    indices[i] += static_cast<std::uint32_t>(baseVertex);
+                }
+
+                if(flipWinding)
+                {
+                    for(std::size_t i = baseIndex; i + 2 < indices.size(); i += 3)
+                        std::swap(indices[i + 1], indices[i + 2]);
+                }
+
+                meshData.subMeshes.push_back({ static_cast<std::uint32_t>(baseIndex), static_cast<std::uint32_t>(indexAccessor.count), primitive.material });
+            }
+        });
+
+        if(!valid)
+            return std::nullopt;
+
+        if(meshData.subMeshes.empty())
+            return std::nullopt;
+
+        meshData.min = vertices.empty() ? glm::vec3(0.0f) : vertices[0].position;
+        meshData.max = meshData.min;
+        for(const auto &vertex : vertices)
+        {
+            meshData.min = glm::min(meshData.min, vertex.position);
+            meshData.max = glm::max(meshData.max, vertex.position);
+        }
+
+        // 16 bit indices whenever the vertices fit
+        meshData.numIndices = indices.size();
+        if(vertices.size() <= 0x10000)
+        {
+            meshData.indexSize = sizeof(std::uint16_t);
+            meshData.indices.resize(indices.size() * sizeof(std::uint16_t));
+            for(std::size_t i = 0; i < indices.size(); ++i)
+            {
+                auto index = static_cast<std::uint16_t>(indices[i]);
+                std::memcpy(meshData.indices.data() + i * sizeof(std::uint16_t), &index, sizeof(index));
+            }
+        }
+        else
+        {
+            meshData.indexSize = sizeof(std::uint32_t);
+            meshData.indices.resize(indices.size() * sizeof(std::uint32_t));
+            std::memcpy(meshData.indices.data(), indices.data(), meshData.indices.size());
+        }
+        return meshData;
+    }
+}
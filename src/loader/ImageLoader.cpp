@@ -5,10 +5,16 @@
 namespace RIS::Loader
 {
     template<>
-    std::shared_ptr<Graphics::Image> Load<Graphics::Image>(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    std::shared_ptr<Graphics::Image> Load<Graphics::Image>(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
     {
         if(bytes.size() == 0)
             return nullptr;
-        return std::make_shared<Graphics::Image>(bytes);
+        return std::make_shared<Graphics::Image>(bytes.Span());
+    }
+
+    template<>
+    Upload<Graphics::Image> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        return Ready(Load<Graphics::Image>(bytes, name, param, resourcePack));
     }
 }
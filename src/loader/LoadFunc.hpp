@@ -4,11 +4,65 @@
 #include <memory>
 #include <any>
 #include <string>
+#include <functional>
+#include <type_traits>
+#include <utility>
 
 #include "loader/ResourcePack.hpp"
+#include "loader/ResourceView.hpp"
 
 namespace RIS::Loader
 {
     template<typename T>
-    std::shared_ptr<T> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    std::shared_ptr<T> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
+    // the part of a load that has to run on the render thread (gl object creation).
+    // uploads that need other async loads check them with ready and are retried every frame until it returns true
+    template<typename T>
+    class Upload
+    {
+    public:
+        using Build = std::function<std::shared_ptr<T>()>;
+        using Ready = std::function<bool()>;
+
+        Upload() = default;
+
+        template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Upload> && std::is_invocable_r_v<std::shared_ptr<T>, F&>>>
+        Upload(F &&build)
+            : build(std::forward<F>(build))
+        {}
+
+        Upload(Ready ready, Build build)
+            : ready(std::move(ready)), build(std::move(build))
+        {}
+
+        bool IsReady() const
+        {
+            return !ready || ready();
+        }
+
+        std::shared_ptr<T> operator()() const
+        {
+            return build();
+        }
+
+    private:
+        Ready ready;
+        Build build;
+
+    };
+
+    template<typename T>
+    Upload<T> Ready(std::shared_ptr<T> asset)
+    {
+        return [asset]{ return asset; };
+    }
+
+    // runs on a loader thread and does all the work that doesn't need the gl context.
+    // asset types without a specialization do all their work in the returned upload
+    template<typename T>
+    Upload<T> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        return [bytes = std::move(bytes), name, param, &resourcePack]{ return Load<T>(bytes, name, param, resourcePack); };
+    }
 }
@@ -4,35 +4,143 @@
 #include <vector>
 #include <any>
 #include <memory>
+#include <future>
+#include <chrono>
+#include <thread>
 
 #include "loader/ResourcePack.hpp"
 #include "loader/AssetCache.hpp"
+#include "loader/AssetId.hpp"
+#include "loader/AsyncLoader.hpp"
+#include "loader/LoadFunc.hpp"
+
+#include "RisExcept.hpp"
 
 namespace RIS::Loader
 {
-    namespace
+    inline AssetCache& GetCache()
     {
         static AssetCache cache;
+        return cache;
     }
-    inline AssetCache& GetCache() { return cache; }
 
     template<typename T>
-    std::shared_ptr<T> Load(const std::string &res, const ResourcePack &resourcePack, std::any param = {})
-    {  
-        auto &cache = GetCache();
-        if(cache.IsCached<T>(res))
+    bool IsReady(const AssetFuture<T> &future)
+    {
+        return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    // uploads only happen on the render thread, so it keeps them going while waiting for another load.
+    // loader threads (shader includes, ...) must not upload, they help with queued jobs and then block
+    template<typename T>
+    std::shared_ptr<T> Wait(const AssetFuture<T> &future)
+    {
+        auto &asyncLoader = GetAsyncLoader();
+        if(!asyncLoader.IsRenderThread())
         {
-            cache.AddRef<T>(res);
-            return cache.Get<T>(res);
+            while(!IsReady(future))
+            {
+                if(!asyncLoader.RunJob())
+                    future.wait();
+            }
+            return future.get();
         }
 
-        auto bytes = resourcePack.Read(res);
-        if(!bytes.empty())
+        while(!IsReady(future))
+        {
+            asyncLoader.Update(std::chrono::duration<float, std::milli>(0));
+            std::this_thread::yield();
+        }
+        return future.get();
+    }
+
+    // nested loads (textures of a map, the mesh of a model, ...) go through these as well,
+    // so every asset is only loaded once and stays referenced as long as the asset that uses it
+    template<typename T>
+    std::shared_ptr<T> Load(const AssetPath &res, const ResourcePack &resourcePack, std::any param = {})
+    {
+        auto &cache = GetCache();
+        DependencyScope::Record(AssetCache::GetId<T>(res));
+        auto claim = cache.Claim<T>(res);
+        if(claim.asset)
+            return claim.asset;
+        if(!claim.isOwner)
+            return Wait(claim.future);
+
+        try
         {
-            auto asset = Load<T>(bytes, res, param, resourcePack);
-            cache.Cache<T>(res, asset);
+            std::string name(res.path);
+            std::shared_ptr<T> asset;
+            DependencyScope scope;
+            auto bytes = resourcePack.Map(name);
+            if(!bytes.empty())
+                asset = Load<T>(bytes, name, param, resourcePack);
+            cache.Complete<T>(res, asset, scope.Take());
             return asset;
         }
-        return nullptr;
+        catch(...)
+        {
+            cache.Fail<T>(res, std::current_exception());
+            throw;
+        }
+    }
+
+    // reading and decoding happens on the loader threads, the upload is done by AsyncLoader::Update
+    template<typename T>
+    AssetFuture<T> LoadAsync(const AssetPath &res, const ResourcePack &resourcePack, std::any param = {})
+    {
+        auto &cache = GetCache();
+        DependencyScope::Record(AssetCache::GetId<T>(res));
+        auto claim = cache.Claim<T>(res);
+        if(claim.asset)
+        {
+            std::promise<std::shared_ptr<T>> promise;
+            promise.set_value(claim.asset);
+            return promise.get_future().share();
+        }
+        if(!claim.isOwner)
+            return claim.future;
+
+        std::string name(res.path);
+        auto cancel = [name]{ GetCache().Fail<T>(name, std::make_exception_ptr(RISException("Loading " + name + " was cancelled"))); };
+        GetAsyncLoader().Enqueue([name, param, &resourcePack]() -> AsyncLoader::Finalizer
+        {
+            try
+            {
+                auto bytes = resourcePack.Map(name);
+                if(bytes.empty())
+                    return [name]{ GetCache().Complete<T>(name, nullptr); return true; };
+
+                DependencyScope scope;
+                Upload<T> upload = Prepare<T>(std::move(bytes), name, param, resourcePack);
+                return [name, upload, dependencies = scope.Take()]() mutable
+                {
+                    // nested loads aren't done yet, waiting for them here would stall the render thread
+                    if(!upload.IsReady())
+                        return false;
+
+                    try
+                    {
+                        // uploads that load other assets themselves add to the dependencies found on the loader thread
+                        DependencyScope uploadScope;
+                        auto asset = upload();
+                        auto uploadDependencies = uploadScope.Take();
+                        dependencies.insert(std::end(dependencies), std::begin(uploadDependencies), std::end(uploadDependencies));
+                        GetCache().Complete<T>(name, asset, std::move(dependencies));
+                    }
+                    catch(...)
+                    {
+                        GetCache().Fail<T>(name, std::current_exception());
+                    }
+                    return true;
+                };
+            }
+            catch(...)
+            {
+                return [name, error = std::current_exception()]{ GetCache().Fail<T>(name, error); return true; };
+            }
+        }, std::move(cancel));
+
+        return claim.future;
     }
 }
@@ -1,4 +1,5 @@
 #include "loader/MapEntityLoader.hpp"
+#include "loader/BinaryReader.hpp"
 
 #include "game/MapEntity.hpp"
 #include "game/MapProps.hpp"
@@ -7,12 +8,16 @@
 
 #include "graphics/VertexTypes.hpp"
 
+#include "misc/Logger.hpp"
+
 #include <string>
 #include <string_view>
 #include <cstdint>
 
 #include <glm/glm.hpp>
 
+#include <fmt/format.h>
+
 namespace RIS::Loader
 {
     constexpr char ENTITY_FILE_MAGIC[4] = {'E', 'N', 'T', 'I'};
@@ -77,128 +82,124 @@ namespace RIS::Loader
         vt_bool
     };
 
-    template<>
-    std::shared_ptr<std::vector<Game::MapEntity>> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    std::shared_ptr<std::vector<Game::MapEntity>> ParseEntityFile(const std::byte *data, std::size_t size)
     {
-        if(bytes.size() == 0)
-            return nullptr;
+        BinaryReader reader(data, size);
 
-        auto readBytes = [bytesPtr = bytes.data()](auto *dst, std::size_t size) mutable
-        {
-            std::memcpy(dst, bytesPtr, size);
-            bytesPtr += size;
-        };
-
-        entityheader header = {};
-        readBytes(&header, sizeof header);
+        auto header = reader.Read<entityheader>();
         if(std::string_view(header.magic, sizeof header.magic) != std::string_view(ENTITY_FILE_MAGIC, sizeof ENTITY_FILE_MAGIC))
             return nullptr;
         if(header.version != ENTITY_FILE_VERSION)
             return nullptr;
 
-        std::shared_ptr<std::vector<Game::MapEntity>> entList = std::make_unique<std::vector<Game::MapEntity>>();
+        auto entList = std::make_shared<std::vector<Game::MapEntity>>();
         auto &entities = *entList;
         for(uint32_t i = 0; i < header.numEntities; ++i)
         {
-            entityentry entEntry = {};
-            readBytes(&entEntry, sizeof entEntry);
-            std::string classname(entEntry.entityName/*, sizeof entEntry.entityName*/);
+            auto entEntry = reader.Read<entityentry>();
+            std::string classname = FixedString(entEntry.entityName);
 
             Game::MapProps props;
             for(uint32_t j = 0; j < entEntry.numProperties; ++j)
             {
-                entityproperty entProp = {};
-                readBytes(&entProp, sizeof entProp);
-                std::string key(entProp.propertyName/*, sizeof entProp.propertyName*/);
+                auto entProp = reader.Read<entityproperty>();
+                std::string key = FixedString(entProp.propertyName);
                 switch (static_cast<value_type>(entProp.valueType))
                 {
                 case value_type::vt_bool:
-                    {
-                        bool val;
-                        readBytes(&val, sizeof val);
-                        props.Set(key, val);
-                    }
+                    props.Set(key, reader.Read<std::uint8_t>() != 0);
                     break;
                 case value_type::vt_int:
-                    {
-                        int val;
-                        readBytes(&val, sizeof val);
-                        props.Set(key, val);
-                    }
+                    props.Set(key, reader.Read<int>());
                     break;
                 case value_type::vt_float:
-                    {
-                        float val;
-                        readBytes(&val, sizeof val);
-                        props.Set(key, val);
-                    }
+                    props.Set(key, reader.Read<float>());
                     break;
                 case value_type::vt_vec2:
-                    {
-                        glm::vec2 val;
-                        readBytes(&val, sizeof val);
-                        props.Set(key, val);
-                    }
+                    props.Set(key, reader.Read<glm::vec2>());
                     break;
                 case value_type::vt_vec3:
-                    {
-                        glm::vec3 val;
-                        readBytes(&val, sizeof val);
-                        props.Set(key, val);
-                    }
+                    props.Set(key, reader.Read<glm::vec3>());
                     break;
                 case value_type::vt_string:
                     {
                         constexpr int MAX_CHARS = 128;
-                        char buffer[MAX_CHARS];
-                        readBytes(buffer, MAX_CHARS);
-                        std::string val(buffer/*, MAX_CHARS*/);
-                        props.Set(key, val);
+                        props.Set(key, reader.ReadString(MAX_CHARS));
                     }
                     break;
+                default:
+                    throw RISException(fmt::format("Unknown value type {} for {}", entProp.valueType, key));
                 }
             }
 
-            auto &entity = entities.emplace_back(classname, std::move(props));
-
-            entitypolygonentry polyEntry = {};
-            readBytes(&polyEntry, sizeof polyEntry);
-
+            Game::MapEntityMesh mesh;
+            auto polyEntry = reader.Read<entitypolygonentry>();
             for(uint32_t j = 0; j < polyEntry.numPolygonSections; ++j)
             {
-                entitypolygonsection polySection = {};
-                readBytes(&polySection, sizeof polySection);
-                std::string textureName(polySection.texture, sizeof polySection.texture);
+                auto polySection = reader.Read<entitypolygonsection>();
+                auto &section = mesh.sections.emplace_back();
+                section.texture = fmt::format("textures/{}.dds", FixedString(polySection.texture));
+                section.indexOffset = static_cast<uint32_t>(mesh.indices.size());
 
                 for(uint32_t k = 0; k < polySection.numPolygons; ++k)
                 {
-                    entitypolygon poly = {};
-                    readBytes(&poly, sizeof poly);
+                    auto poly = reader.Read<entitypolygon>();
+                    auto polyVertices = reader.View<VertexType::MapVertex>(poly.numVertices);
+                    auto polyIndices = reader.View<uint16_t>(poly.numIndices);
 
-                    std::vector<VertexType::MapVertex> vertices(poly.numVertices);
-                    std::vector<uint16_t> indices(poly.numIndices);
+                    std::size_t baseVertex = mesh.vertices.size();
+                    mesh.vertices.resize(baseVertex + polyVertices.size());
+                    polyVertices.CopyTo(mesh.vertices.data() + baseVertex);
 
-                    readBytes(vertices.data(), poly.numVertices * sizeof(VertexType::MapVertex));
-                    readBytes(indices.data(), poly.numIndices * sizeof(uint16_t));
+                    std::size_t baseIndex = mesh.indices.size();
+                    mesh.indices.resize(baseIndex + polyIndices.size());
+                    for(std::size_t n = 0; n < polyIndices.size(); ++n)
+                    {
+                        uint16_t index = polyIndices[n];
+                        if(index >= poly.numVertices)
+                            throw RISException(fmt::format("Index {} out of range in entity {}", index, classname));
+                        mesh.indices[baseIndex + n] = static_cast<uint32_t>(baseVertex + index);
+                    }
                 }
+                section.indexCount = static_cast<uint32_t>(mesh.indices.size()) - section.indexOffset;
             }
 
-            entitybrushentry brushentry = {};
-            readBytes(&brushentry, sizeof brushentry);
-
-            for(uint32_t j = 0; j < brushentry.numBrushes; ++j)
+            std::vector<Physics::Brush> brushes;
+            auto brushEntry = reader.Read<entitybrushentry>();
+            for(uint32_t j = 0; j < brushEntry.numBrushes; ++j)
             {
-                entitybrush brush = {};
-                readBytes(&brush, sizeof brush);
-
-                for(uint32_t k = 0; k < brush.numPlanes; ++k)
-                {
-                    Physics::Plane plane;
-                    readBytes(&plane, sizeof plane);
-                }
+                auto brush = reader.Read<entitybrush>();
+                auto planes = reader.View<Physics::Plane>(brush.numPlanes);
+                brushes.emplace_back().planes.resize(planes.size());
+                planes.CopyTo(brushes.back().planes.data());
             }
+
+            entities.emplace_back(classname, std::move(props), std::move(mesh), std::move(brushes));
         }
 
         return entList;
     }
+
+    template<>
+    std::shared_ptr<std::vector<Game::MapEntity>> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        if(bytes.size() == 0)
+            return nullptr;
+
+        try
+        {
+            return ParseEntityFile(bytes.data(), bytes.size());
+        }
+        catch(const RISException &e)
+        {
+            Logger::Instance().Error(fmt::format("Failed to read entity file ({}): {}", name, e.what()));
+            return nullptr;
+        }
+    }
+
+    template<>
+    Upload<std::vector<Game::MapEntity>> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        return Ready(Load<std::vector<Game::MapEntity>>(bytes, name, param, resourcePack));
+    }
 }
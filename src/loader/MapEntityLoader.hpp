@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <vector>
+#include <cstddef>
 
 namespace RIS::Game
 {
@@ -12,6 +13,12 @@ namespace RIS::Game
 
 namespace RIS::Loader
 {
+    // entities of a .entity file, nullptr if the bytes aren't one. throws RISException if the file is broken
+    std::shared_ptr<std::vector<Game::MapEntity>> ParseEntityFile(const std::byte *data, std::size_t size);
+
+    template<>
+    std::shared_ptr<std::vector<Game::MapEntity>> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
     template<>
-    std::shared_ptr<std::vector<Game::MapEntity>> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    Upload<std::vector<Game::MapEntity>> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
 }
@@ -1,98 +1,213 @@
 #include "loader/MapLoader.hpp"
 
 #include "loader/TextureLoader.hpp"
+#include "loader/Loader.hpp"
+#include "loader/PolyFile.hpp"
 
 #include "graphics/VertexTypes.hpp"
 #include "graphics/MapMesh.hpp"
 #include "graphics/Buffer.hpp"
 
+#include "game/MapEntity.hpp"
+
+#include "misc/Logger.hpp"
+
 #include <fmt/format.h>
 #include <string_view>
 #include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <algorithm>
 
 namespace RIS::Loader
 {
-    constexpr char POLY_FILE_MAGIC[4] = {'P', 'O', 'L', 'Y'};
-    constexpr uint32_t POLY_FILE_VERSION = 1;
-
-    struct polyheader
+    namespace
     {
-        char magic[4];
-        uint32_t version;
-        uint32_t numSections;
-    };
+        struct PolyData
+        {
+            std::vector<VertexType::MapVertex> vertices;
+            std::vector<std::uint32_t> indices;
+            std::vector<std::string> textureNames;
+            std::vector<Graphics::MapSection> sections;
+            std::vector<std::string> entityTextureNames;
+            std::vector<Graphics::MapEntityBatch> entityBatches;
+            std::vector<Graphics::MapEntityRange> entityRanges;
+
+            // every texture once, sections and entity batches point into it
+            std::vector<std::string> textures;
+            std::vector<std::size_t> sectionTextures;
+            std::vector<std::size_t> entityBatchTextures;
+        };
 
-    struct polysection
-    {
-        char texture[64];
-        uint32_t numPolygons;
-    };
+        std::shared_ptr<PolyData> ParsePoly(const ResourceView &bytes, const std::string &name)
+        {
+            try
+            {
+                auto file = ParsePolyFile(bytes.data(), bytes.size());
+                if(!file)
+                    return nullptr;
+
+                auto poly = std::make_shared<PolyData>();
+                poly->vertices = std::move(file->vertices);
+                poly->indices = std::move(file->indices);
+                poly->textureNames.reserve(file->sections.size());
+                poly->sections.reserve(file->sections.size());
+                for(auto &section : file->sections)
+                {
+                    poly->textureNames.push_back(std::move(section.texture));
+                    poly->sections.push_back({ nullptr, section.count, section.offset });
+                }
+                return poly;
+            }
+            catch(const RISException &e)
+            {
+                Logger::Instance().Error(fmt::format("Failed to read poly file ({}): {}", name, e.what()));
+                return nullptr;
+            }
+        }
 
-    struct polydata
-    {
-        uint32_t numVertices;
-        uint32_t numIndices;
-    };
+        // entity geometry goes behind the world geometry, one batch per texture.
+        // the ranges remember where every entity and section ended up, so it can be hidden or drawn on its own.
+        // the entities are shared through the asset cache and only read, the map mesh may be loaded again later
+        void AppendEntities(PolyData &poly, const Game::MapEntities &entities)
+        {
+            auto &vertices = poly.vertices;
+            auto &indices = poly.indices;
 
-    template<>
-    std::shared_ptr<Graphics::MapMesh> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
-    {
-        if(bytes.size() == 0)
-            return nullptr;
+            std::size_t numVertices = vertices.size(), numIndices = indices.size();
+            for(const auto &entity : entities)
+            {
+                numVertices += entity.Mesh().vertices.size();
+                numIndices += entity.Mesh().indices.size();
+            }
+            vertices.reserve(numVertices);
+            indices.reserve(numIndices);
 
-        auto readBytes = [bytesPtr = bytes.data()](auto *dst, std::size_t size) mutable
-        {
-            std::memcpy(dst, bytesPtr, size);
-            bytesPtr += size;
-        };
+            std::unordered_map<std::string, std::size_t> batchIds;
+            poly.entityRanges.resize(entities.size());
+            for(std::size_t i = 0; i < entities.size(); ++i)
+            {
+                const auto &mesh = entities[i].Mesh();
+                if(mesh.sections.empty() || mesh.indices.empty())
+                    continue;
+
+                auto &range = poly.entityRanges[i];
+                range.baseVertex = static_cast<std::int32_t>(vertices.size());
+                range.vertexCount = static_cast<std::uint32_t>(mesh.vertices.size());
+                range.firstIndex = static_cast<std::uint32_t>(indices.size());
+                range.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+                vertices.insert(std::end(vertices), std::begin(mesh.vertices), std::end(mesh.vertices));
+                indices.insert(std::end(indices), std::begin(mesh.indices), std::end(mesh.indices));
+
+                range.draws.reserve(mesh.sections.size());
+                for(const auto &section : mesh.sections)
+                {
+                    auto [found, inserted] = batchIds.try_emplace(section.texture, poly.entityBatches.size());
+                    if(inserted)
+                    {
+                        poly.entityTextureNames.push_back(section.texture);
+                        poly.entityBatches.emplace_back();
+                    }
+
+                    auto &batch = poly.entityBatches[found->second];
+                    range.draws.push_back({ static_cast<std::uint32_t>(found->second), static_cast<std::uint32_t>(batch.counts.size()) });
+                    batch.counts.push_back(static_cast<GLsizei>(section.indexCount));
+                    batch.indexCounts.push_back(static_cast<GLsizei>(section.indexCount));
+                    batch.offsets.push_back(reinterpret_cast<const void*>(static_cast<std::size_t>(range.firstIndex + section.indexOffset) * sizeof(std::uint32_t)));
+                    batch.baseVertices.push_back(range.baseVertex);
+                }
+            }
+        }
 
-        polyheader header = {};
-        readBytes(&header, sizeof header);
-        if(std::string_view(header.magic, sizeof header.magic) != std::string_view(POLY_FILE_MAGIC, sizeof POLY_FILE_MAGIC))
-            return nullptr;
-        if(header.version != POLY_FILE_VERSION)
-            return nullptr;
+        // a texture used by many sections is still loaded once, so the map holds exactly one reference to it
+        void CollectTextures(PolyData &poly)
+        {
+            std::unordered_map<std::string, std::size_t> textureIds;
+            auto add = [&poly, &textureIds](const std::string &textureName)
+            {
+                auto [it, inserted] = textureIds.try_emplace(textureName, poly.textures.size());
+                if(inserted)
+                    poly.textures.push_back(textureName);
+                return it->second;
+            };
+
+            poly.sectionTextures.reserve(poly.textureNames.size());
+            for(const auto &textureName : poly.textureNames)
+                poly.sectionTextures.push_back(add(textureName));
+            poly.entityBatchTextures.reserve(poly.entityTextureNames.size());
+            for(const auto &textureName : poly.entityTextureNames)
+                poly.entityBatchTextures.push_back(add(textureName));
+        }
 
-        std::vector<VertexType::MapVertex> vertices;
-        std::vector<std::uint16_t> indices;
-        std::vector<Graphics::MapSection> sections;
-        for(uint32_t s = 0; s < header.numSections; ++s)
+        std::shared_ptr<PolyData> ParseMap(const ResourceView &bytes, const std::string &name, const std::any &param)
         {
-            polysection section = {};
-            readBytes(&section, sizeof section);
+            auto poly = ParsePoly(bytes, name);
+            if(!poly)
+                return nullptr;
+
+            // LoadScene passes the entities of the map so their geometry ends up in the same buffers
+            if(auto entities = std::any_cast<Game::MapEntitiesPtr>(&param); entities && *entities)
+                AppendEntities(*poly, **entities);
+            CollectTextures(*poly);
+            return poly;
+        }
 
-            std::string textureName(section.texture);
-            textureName = fmt::format("textures/{}.dds", textureName);
-            auto &sec = sections.emplace_back();
-            sec.texture = Load<Graphics::Texture>(resourcePack.Read(textureName), textureName, false, resourcePack);
-            sec.offset = indices.size();
+        void AssignTextures(PolyData &poly, const std::vector<Graphics::Texture::Ptr> &textures)
+        {
+            for(std::size_t i = 0; i < poly.sections.size(); ++i)
+                poly.sections[i].texture = textures.at(poly.sectionTextures.at(i));
+            for(std::size_t i = 0; i < poly.entityBatches.size(); ++i)
+                poly.entityBatches[i].texture = textures.at(poly.entityBatchTextures.at(i));
+        }
 
-            int sectionIndices = 0;
-            for(uint32_t p = 0; p < section.numPolygons; ++p)
-            {
-                polydata data = {};
-                readBytes(&data, sizeof data);
+        Graphics::MapMesh::Ptr BuildMapMesh(PolyData &poly)
+        {
+            Graphics::VertexBuffer vertexBuffer(poly.vertices);
+            Graphics::IndexBuffer indexBuffer(poly.indices);
+            return std::make_shared<Graphics::MapMesh>(std::move(vertexBuffer), std::move(indexBuffer), std::move(poly.sections), std::move(poly.entityBatches), std::move(poly.entityRanges));
+        }
+    }
 
-                std::vector<VertexType::MapVertex> tmpVertices(data.numVertices);
-                readBytes(tmpVertices.data(), data.numVertices * sizeof(VertexType::MapVertex));
+    template<>
+    std::shared_ptr<Graphics::MapMesh> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        auto poly = ParseMap(bytes, name, param);
+        if(!poly)
+            return nullptr;
 
-                std::uint16_t indexOffset = static_cast<std::uint16_t>(vertices.size());
-                vertices.insert(std::cend(vertices), std::begin(tmpVertices), std::end(tmpVertices));
+        std::vector<Graphics::Texture::Ptr> textures;
+        textures.reserve(poly->textures.size());
+        for(const auto &textureName : poly->textures)
+            textures.push_back(Load<Graphics::Texture>(textureName, resourcePack, false));
+        AssignTextures(*poly, textures);
 
-                std::vector<std::uint16_t> tmpIndices(data.numIndices);
-                readBytes(tmpIndices.data(), data.numIndices * sizeof(std::uint16_t));
+        return BuildMapMesh(*poly);
+    }
 
-                std::for_each(std::begin(tmpIndices), std::end(tmpIndices), [indexOffset](auto &index){ index += indexOffset; });
-                indices.insert(std::cend(indices), std::begin(tmpIndices), std::end(tmpIndices));
+    template<>
+    Upload<Graphics::MapMesh> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        auto poly = ParseMap(bytes, name, param);
+        if(!poly)
+            return Ready<Graphics::MapMesh>(nullptr);
 
-                sectionIndices += data.numIndices;
-            }
-            sec.count = static_cast<std::size_t>(sectionIndices);
-        }
+        std::vector<AssetFuture<Graphics::Texture>> textureFutures;
+        textureFutures.reserve(poly->textures.size());
+        for(const auto &textureName : poly->textures)
+            textureFutures.push_back(LoadAsync<Graphics::Texture>(textureName, resourcePack, false));
 
-        Graphics::VertexBuffer vertexBuffer(vertices);
-        Graphics::IndexBuffer indexBuffer(indices);
-        Graphics::MapMesh::Ptr mapMesh = std::make_shared<Graphics::MapMesh>(std::move(vertexBuffer), std::move(indexBuffer), std::move(sections));
-        return mapMesh;
+        auto ready = [textureFutures]
+        {
+            return std::all_of(std::begin(textureFutures), std::end(textureFutures), [](const auto &future){ return IsReady(future); });
+        };
+        return Upload<Graphics::MapMesh>(ready, [poly, textureFutures]
+        {
+            std::vector<Graphics::Texture::Ptr> textures;
+            textures.reserve(textureFutures.size());
+            for(const auto &future : textureFutures)
+                textures.push_back(future.get());
+            AssignTextures(*poly, textures);
+            return BuildMapMesh(*poly);
+        });
     }
 }
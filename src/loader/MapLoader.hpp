@@ -9,5 +9,8 @@ namespace RIS::Graphics { class MapMesh; }
 namespace RIS::Loader
 {
     template<>
-    std::shared_ptr<Graphics::MapMesh> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    std::shared_ptr<Graphics::MapMesh> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
+    template<>
+    Upload<Graphics::MapMesh> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
 }
@@ -0,0 +1,94 @@
+#include "loader/MappedFile.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif __linux__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace RIS::Loader
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::filesystem::path &path)
+    {
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if(file == INVALID_HANDLE_VALUE)
+        {
+            file = nullptr;
+            return;
+        }
+
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+            return;
+
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(!mapping)
+            return;
+
+        data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if(data)
+            size = static_cast<std::size_t>(fileSize.QuadPart);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if(data)
+            UnmapViewOfFile(data);
+        if(mapping)
+            CloseHandle(mapping);
+        if(file)
+            CloseHandle(file);
+    }
+#elif __linux__
+    MappedFile::MappedFile(const std::filesystem::path &path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if(fd == -1)
+            return;
+
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0)
+        {
+            void *ptr = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if(ptr != MAP_FAILED)
+            {
+                data = static_cast<const std::byte*>(ptr);
+                size = static_cast<std::size_t>(fileStat.st_size);
+            }
+        }
+        // the mapping stays valid after the descriptor is closed
+        close(fd);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if(data)
+            munmap(const_cast<std::byte*>(data), size);
+    }
+#else
+    MappedFile::MappedFile(const std::filesystem::path &path)
+    {}
+
+    MappedFile::~MappedFile()
+    {}
+#endif
+
+    bool MappedFile::IsOpen() const
+    {
+        return data != nullptr;
+    }
+
+    const std::byte* MappedFile::Data() const
+    {
+        return data;
+    }
+
+    std::size_t MappedFile::Size() const
+    {
+        return size;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <filesystem>
+#include <cstddef>
+
+namespace RIS::Loader
+{
+    // read only memory mapping of a whole file. IsOpen is false if the file
+    // can't be mapped or the platform has no mmap (emscripten)
+    class MappedFile
+    {
+    public:
+        MappedFile(const std::filesystem::path &path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+
+        bool IsOpen() const;
+        const std::byte* Data() const;
+        std::size_t Size() const;
+
+    private:
+        const std::byte *data = nullptr;
+        std::size_t size = 0;
+#ifdef _WIN32
+        void *file = nullptr;
+        void *mapping = nullptr;
+#endif
+
+    };
+}
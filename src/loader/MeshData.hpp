@@ -0,0 +1,79 @@
+#pragma once
+
+#include "graphics/VertexTypes.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+namespace tinygltf
+{
+    class Model;
+}
+
+namespace RIS::Loader
+{
+    struct MeshDataSubMesh
+    {
+        std::uint32_t offset;
+        std::uint32_t count;
+        std::int32_t material;
+    };
+
+    // cpu side mesh, ready to be copied into buffers.
+    // indices are 16 or 32 bit depending on the number of vertices
+    struct MeshData
+    {
+        std::vector<VertexType::ModelVertex> vertices;
+        std::vector<std::byte> indices;
+        std::size_t indexSize = sizeof(std::uint16_t);
+        std::size_t numIndices = 0;
+        std::vector<MeshDataSubMesh> subMeshes;
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    // reads all triangle primitives of the scene of a binary gltf file, placed where their nodes put them
+    std::optional<MeshData> ParseGLTFMesh(const std::byte *data, std::size_t size, std::string &warning);
+    std::optional<MeshData> ExtractGLTFMesh(const tinygltf::Model &model, std::string &warning);
+
+    // the joints of a skin ordered parents first, order[bone] is the index of the joint in joints.
+    // skeletons, their animations and the JOINTS_0 of skinned meshes all use this order
+    std::vector<std::size_t> SkinJointOrder(const tinygltf::Model &model, const std::vector<int> &joints);
+
+    // .rmesh files written by the mesh cooker. little endian:
+    //   RMeshHeader
+    //   ModelVertex[numVertices] at vertexOffset
+    //   uint16_t or uint32_t[numIndices] at indexOffset
+    //   RMeshSubMesh[numSubMeshes] at subMeshOffset
+    // version 3 stores the joints of skinned vertices in SkinJointOrder
+    constexpr char RMESH_MAGIC[4] = { 'R', 'M', 'S', 'H' };
+    constexpr std::uint32_t RMESH_VERSION = 3;
+
+    struct RMeshHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t vertexSize;
+        std::uint32_t indexSize;
+        std::uint32_t numVertices;
+        std::uint32_t numIndices;
+        float min[3];
+        float max[3];
+        std::uint64_t vertexOffset;
+        std::uint64_t indexOffset;
+        std::uint64_t subMeshOffset;
+        std::uint32_t numSubMeshes;
+        std::uint32_t reserved;
+    };
+
+    static_assert(sizeof(RMeshHeader) == 80);
+
+    using RMeshSubMesh = MeshDataSubMesh;
+
+    static_assert(sizeof(RMeshSubMesh) == 12);
+}
@@ -1,6 +1,10 @@
 #include "loader/ModelLoader.hpp"
 
 #include "loader/TextureLoader.hpp"
+#include "loader/Loader.hpp"
+#include "loader/MeshData.hpp"
+#include "loader/TinyGLTF.hpp"
+#include "loader/GLTFAccessor.hpp"
 
 #include "graphics/Mesh.hpp"
 #include "graphics/Model.hpp"
@@ -8,16 +12,6 @@
 
 #include "misc/Logger.hpp"
 
-#define TINYGLTF_IMPLEMENTATION
-#define TINYGLTF_NO_EXTERNAL_IMAGE
-#define TINYGLTF_USE_RAPIDJSON
-#define TINYGLTF_USE_CPP14
-#define TINYGLTF_NO_INCLUDE_STB_IMAGE
-#define TINYGLTF_NO_INCLUDE_STB_IMAGE_WRITE
-#define TINYGLTF_NO_STB_IMAGE_WRITE
-#define TINYGLTF_NO_STB_IMAGE
-#include <tiny_gltf.h>
-
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -30,6 +24,12 @@
 #include <map>
 #include <vector>
 #include <array>
+#include <optional>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <future>
+#include <algorithm>
 
 #include <fmt/format.h>
 
@@ -37,40 +37,13 @@ namespace RIS::Loader
 {
     namespace GLTFHelper
     {
-        template<typename T, size_t S = sizeof(T)>
-        static std::array<unsigned char, S> GetComponents(const T &comp)
-        {
-            std::array<unsigned char, S> d;
-            std::memcpy(d.data(), &comp, S);
-            return d;
-        }
-
-        static std::vector<unsigned char> Interleave(const std::vector<glm::vec3> &positions, const std::vector<glm::vec3> &normals, const std::vector<glm::vec2> &texCoords, const std::vector<glm::i16vec4> &joints, const std::vector<glm::vec4> &weights)
-        {
-            std::vector<unsigned char> data;
-            size_t size = positions.size();
-            for(size_t i = 0; i < size; ++i)
-            {
-                auto p = GetComponents(positions.at(i));
-                data.insert(data.end(), p.cbegin(), p.cend());
-                auto n = GetComponents(normals.at(i));
-                data.insert(data.end(), n.cbegin(), n.cend());
-                auto t = GetComponents(texCoords.at(i));
-                data.insert(data.end(), t.cbegin(), t.cend());
-                auto j = GetComponents(joints.at(i));
-                data.insert(data.end(), j.cbegin(), j.cend());
-                auto w = GetComponents(weights.at(i));
-                data.insert(data.end(), w.cbegin(), w.cend());
-            }
-            return data;
-        }
-
+        // bones are numbered in SkinJointOrder, so parents always come before their children
         static std::unordered_map<std::size_t, std::size_t> CreateNodeBoneMap(const tinygltf::Model &model, const tinygltf::Skin &skin)
         {
             std::unordered_map<std::size_t, std::size_t> nodeBoneMap;
-            std::size_t boneId = 0;
-            for(int nodeId : skin.joints)
-                nodeBoneMap.insert({nodeId, boneId++});
+            auto order = SkinJointOrder(model, skin.joints);
+            for(std::size_t boneId = 0; boneId < order.size(); ++boneId)
+                nodeBoneMap.insert({skin.joints[order[boneId]], boneId});
             return nodeBoneMap;
         }
 
@@ -87,49 +60,12 @@ namespace RIS::Loader
             return 0;
         }
 
-        template<typename T, std::size_t Size = sizeof(T)>
+        template<typename T>
         static void GetScalarValues(const tinygltf::Model &model, std::vector<T> &out, std::size_t compCount, const tinygltf::Accessor &accessor)
         {
             out.resize(accessor.count * compCount);
-            const auto &bufferView = model.bufferViews.at(accessor.bufferView);
-            const auto &buffer = model.buffers.at(bufferView.buffer);
-            auto beg = buffer.data.cbegin() + bufferView.byteOffset + accessor.byteOffset;
-            auto end = buffer.data.cbegin() + bufferView.byteOffset + accessor.byteOffset + bufferView.byteLength;
-            
-            std::size_t i = 0;
-            for(auto it = beg; it != end;)
-            {
-                std::vector<unsigned char> bytes(it, it + Size);
-                T val;
-                std::memcpy(&val, bytes.data(), Size);
-
-                out[i++] = val;
-
-                it += Size;
-            }
-        }
-
-        template<typename T, std::size_t Size = sizeof(T)>
-        static void GetValues(const tinygltf::Model &model, const tinygltf::Accessor &accessor, std::vector<T> &out)
-        {
-            out.resize(accessor.count);
-            const auto &bufferView = model.bufferViews.at(accessor.bufferView);
-            const auto &buffer = model.buffers.at(bufferView.buffer);
-
-            auto beg = buffer.data.cbegin() + bufferView.byteOffset + accessor.byteOffset;
-            auto end = buffer.data.cbegin() + bufferView.byteOffset + accessor.byteOffset + bufferView.byteLength;
-
-            std::size_t i = 0;
-            for(auto it = beg; it != end;)
-            {
-                std::vector<unsigned char> bytes(it, it + Size);
-                T val;
-                std::memcpy(&val, bytes.data(), Size);
-
-                out[i++] = val;
-
-                it += Size;
-            }
+            if(!ReadAccessor(model, accessor, compCount, out.data()))
+                throw std::runtime_error("invalid accessor");
         }
 
         template<typename T, unsigned int N>
@@ -236,9 +172,8 @@ namespace RIS::Loader
         static Graphics::Animation::Pose LoadBindPose(const tinygltf::Model &model, const tinygltf::Skin &skin, RIS::Graphics::Animation::Pose &restPose, Logger &logger)
         {
             std::size_t numBones = restPose.Size();
-            std::vector<Graphics::Transform> worldBindPose(numBones);
-            for(std::size_t i = 0; i < numBones; ++i)
-                worldBindPose[i] = restPose.GetGlobalTransform(i);
+            std::vector<Graphics::Transform> worldBindPose;
+            restPose.GetGlobalTransforms(worldBindPose);
 
             const tinygltf::Accessor &matAccessor = model.accessors.at(skin.inverseBindMatrices);
 
@@ -249,6 +184,8 @@ namespace RIS::Loader
 
             GetScalarValues(model, invBindAccessor, compCount, matAccessor);
 
+            // the matrices are in the order of the skin joints, the bones aren't
+            const auto &nodeBoneMap = CreateNodeBoneMap(model, skin);
             std::size_t numJoints = skin.joints.size();
             for(std::size_t i = 0; i < numJoints; ++i)
             {
@@ -256,7 +193,7 @@ namespace RIS::Loader
                 glm::mat4 invBindMatrix = glm::make_mat4(matrix);
                 glm::mat4 bindMatrix = glm::inverse(invBindMatrix);
                 Graphics::Transform bindTransform = Graphics::Mat4ToTransform(bindMatrix);
-                worldBindPose[i] = bindTransform;
+                worldBindPose[nodeBoneMap.at(skin.joints[i])] = bindTransform;
             }
 
             Graphics::Animation::Pose bindPose(restPose);
@@ -276,106 +213,274 @@ namespace RIS::Loader
         }
     }
 
-    template<>
-    std::shared_ptr<Graphics::Mesh> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    namespace
     {
-        auto &logger = Logger::Instance();
-
-        tinygltf::TinyGLTF gltfLoader;
-        tinygltf::Model model;
-        std::string err, warn;
+        struct GLTFDocument
+        {
+            tinygltf::Model model;
+            bool valid = false;
+        };
 
-        bool result = gltfLoader.LoadBinaryFromMemory(&model, &err, &warn, reinterpret_cast<const unsigned char*>(bytes.data()), static_cast<unsigned int>(bytes.size()));
-        if(!warn.empty()) logger.Warning(warn);
-        if(result)
+        // the loads that can use a parsed file
+        enum GLTFConsumer : std::uint8_t
+        {
+            GLTF_MESH = 1,
+            GLTF_SKELETON = 2,
+            GLTF_ANIMATION = 4
+        };
+
+        // mesh, skeleton and animation of a character usually come from the same glb and are loaded
+        // right after each other. a parsed file is only kept until every load its content is good for has taken it
+        class GLTFDocumentCache
         {
-            //const auto &nodeBoneMap = GLTFHelper::CreateNodeBoneMap(model, model.skins.at(0));
+        public:
+            using DocumentPtr = std::shared_ptr<const GLTFDocument>;
 
-            auto checkAttribs = [](const std::map<std::string, int> &attribs)
+            DocumentPtr Get(const ResourceView &bytes, const std::string &name, GLTFConsumer consumer)
             {
-                int hasAll = 0;
-                std::for_each(attribs.begin(), attribs.end(), [&hasAll](const std::pair<std::string, int> attrib)
+                std::promise<DocumentPtr> promise;
+                std::shared_future<DocumentPtr> document;
+                std::uint64_t id;
+                bool isOwner = false;
                 {
-                    if(attrib.first.compare("POSITION") == 0) hasAll++;
-                    else if(attrib.first.compare("NORMAL") == 0) hasAll++;
-                    else if(attrib.first.compare("TEXCOORD_0") == 0) hasAll++;
-                });
-                return hasAll == 3;
-            };
+                    std::lock_guard lock(mutex);
+                    auto it = Find(name, bytes.size());
+                    if(it != std::end(entries))
+                    {
+                        entries.splice(std::begin(entries), entries, it);
+                        document = it->document;
+                        id = it->id;
+                    }
+                    else
+                    {
+                        document = promise.get_future().share();
+                        id = nextId++;
+                        entries.push_front({ name, bytes.size(), document, id, 0 });
+                        if(entries.size() > CAPACITY)
+                            entries.pop_back();
+                        isOwner = true;
+                    }
+                }
 
-            const tinygltf::Mesh &mesh = model.meshes.at(0);
-            const tinygltf::Primitive &primitive = mesh.primitives.at(0);
+                // other threads asking for the same file wait for this parse
+                if(isOwner)
+                {
+                    try
+                    {
+                        promise.set_value(Parse(bytes, name));
+                    }
+                    catch(...)
+                    {
+                        promise.set_exception(std::current_exception());
+                    }
+                }
 
-            if(!checkAttribs(primitive.attributes))
-                return nullptr;
+                DocumentPtr result;
+                try
+                {
+                    result = document.get();
+                }
+                catch(...)
+                {
+                    Release(name, bytes.size(), id, 0);
+                    throw;
+                }
+                Release(name, bytes.size(), id, consumer | ~Consumers(*result));
+                return result;
+            }
 
-            std::size_t numElements = model.accessors.at(primitive.attributes.at("POSITION")).count;
+        private:
+            struct Entry
+            {
+                std::string name;
+                std::size_t size;
+                std::shared_future<DocumentPtr> document;
+                std::uint64_t id;
+                std::uint8_t taken;
+            };
 
-            std::vector<glm::vec3> positions;
-            const auto &posAccessor = model.accessors.at(primitive.attributes.at("POSITION"));
-            GLTFHelper::GetValues(model, posAccessor, positions);
+            static DocumentPtr Parse(const ResourceView &bytes, const std::string &name)
+            {
+                auto &logger = Logger::Instance();
+                auto document = std::make_shared<GLTFDocument>();
+
+                tinygltf::TinyGLTF gltfLoader;
+                std::string err, warn;
+                document->valid = gltfLoader.LoadBinaryFromMemory(&document->model, &err, &warn, reinterpret_cast<const unsigned char*>(bytes.data()), static_cast<unsigned int>(bytes.size()));
+                if(!warn.empty()) logger.Warning(fmt::format("({}): {}", name, warn));
+                if(!err.empty()) logger.Error(fmt::format("({}): {}", name, err));
+                return document;
+            }
 
-            std::vector<glm::vec3> normals;
-            const auto &normAccessor = model.accessors.at(primitive.attributes.at("NORMAL"));
-            GLTFHelper::GetValues(model, normAccessor, normals);
+            // a broken file isn't useful to anyone
+            static std::uint8_t Consumers(const GLTFDocument &document)
+            {
+                if(!document.valid)
+                    return 0;
 
-            std::vector<glm::vec2> texCoords;
-            const auto &texAccessor = model.accessors.at(primitive.attributes.at("TEXCOORD_0"));
-            GLTFHelper::GetValues(model, texAccessor, texCoords);
+                const auto &model = document.model;
+                return (model.meshes.empty() ? 0 : GLTF_MESH) | (model.skins.empty() ? 0 : GLTF_SKELETON | GLTF_ANIMATION);
+            }
 
-            std::vector<glm::i16vec4> joints;
-            if(primitive.attributes.count("JOINTS_0"))
+            std::list<Entry>::iterator Find(const std::string &name, std::size_t size)
             {
-                const auto &jointAccessor = model.accessors.at(primitive.attributes.at("JOINTS_0"));
-                GLTFHelper::GetValues(model, jointAccessor, joints);
+                return std::find_if(std::begin(entries), std::end(entries), [&](const Entry &entry){ return entry.name == name && entry.size == size; });
             }
-            else
+
+            // taken has a bit for every consumer that is done with the file, the entry goes once all are
+            void Release(const std::string &name, std::size_t size, std::uint64_t id, int taken)
             {
-                joints.resize(numElements);
+                std::lock_guard lock(mutex);
+                auto it = Find(name, size);
+                if(it == std::end(entries) || it->id != id)
+                    return;
+
+                it->taken |= static_cast<std::uint8_t>(taken);
+                if(taken == 0 || (it->taken & ALL_CONSUMERS) == ALL_CONSUMERS)
+                    entries.erase(it);
             }
 
-            std::vector<glm::vec4> weights;
-            if(primitive.attributes.count("WEIGHTS_0"))
+            static constexpr std::uint8_t ALL_CONSUMERS = GLTF_MESH | GLTF_SKELETON | GLTF_ANIMATION;
+            // only reached if files are parsed for loads that never happen
+            static constexpr std::size_t CAPACITY = 8;
+
+            std::mutex mutex;
+            std::list<Entry> entries;
+            std::uint64_t nextId = 0;
+        };
+
+        GLTFDocumentCache::DocumentPtr GetGLTFDocument(const ResourceView &bytes, const std::string &name, GLTFConsumer consumer)
+        {
+            static GLTFDocumentCache documentCache;
+            return documentCache.Get(bytes, name, consumer);
+        }
+
+        bool IsCookedMesh(const ResourceView &bytes)
+        {
+            return bytes.size() >= sizeof(RMeshHeader) && std::memcmp(bytes.data(), RMESH_MAGIC, sizeof(RMESH_MAGIC)) == 0;
+        }
+
+        struct CookedMesh
+        {
+            RMeshHeader header;
+            std::vector<Graphics::SubMesh> subMeshes;
+        };
+
+        std::optional<CookedMesh> ReadCookedMesh(const ResourceView &bytes, const std::string &name)
+        {
+            CookedMesh cooked;
+            auto &header = cooked.header;
+            std::memcpy(&header, bytes.data(), sizeof(header));
+
+            std::uint64_t vertexSize = static_cast<std::uint64_t>(header.numVertices) * sizeof(VertexType::ModelVertex);
+            std::uint64_t indexSize = static_cast<std::uint64_t>(header.numIndices) * header.indexSize;
+            std::uint64_t subMeshSize = static_cast<std::uint64_t>(header.numSubMeshes) * sizeof(RMeshSubMesh);
+            if(header.version != RMESH_VERSION || header.vertexSize != sizeof(VertexType::ModelVertex)
+                || (header.indexSize != sizeof(std::uint16_t) && header.indexSize != sizeof(std::uint32_t))
+                || header.vertexOffset > bytes.size() || vertexSize > bytes.size() - header.vertexOffset
+                || header.indexOffset > bytes.size() || indexSize > bytes.size() - header.indexOffset
+                || header.subMeshOffset > bytes.size() || subMeshSize > bytes.size() - header.subMeshOffset)
             {
-                const auto &weightAccessor = model.accessors.at(primitive.attributes.at("WEIGHTS_0"));
-                GLTFHelper::GetValues(model, weightAccessor, weights);
+                Logger::Instance().Error(fmt::format("Invalid cooked mesh ({})", name));
+                return std::nullopt;
             }
-            else
+
+            cooked.subMeshes.reserve(header.numSubMeshes);
+            for(std::uint32_t i = 0; i < header.numSubMeshes; ++i)
             {
-                weights.resize(numElements);
+                RMeshSubMesh subMesh;
+                std::memcpy(&subMesh, bytes.data() + header.subMeshOffset + i * sizeof(RMeshSubMesh), sizeof(subMesh));
+                if(static_cast<std::uint64_t>(subMesh.offset) + subMesh.count > header.numIndices)
+                {
+                    Logger::Instance().Error(fmt::format("Invalid cooked mesh ({}): submesh {} out of range", name, i));
+                    return std::nullopt;
+                }
+                cooked.subMeshes.push_back({ subMesh.offset, subMesh.count, subMesh.material });
             }
+            return cooked;
+        }
+
+        // the buffers are filled straight from the resource, which usually is the mapped file
+        Graphics::Mesh::Ptr BuildCookedMesh(CookedMesh cooked, const ResourceView &bytes)
+        {
+            const auto &header = cooked.header;
+            Graphics::VertexBuffer vertexBuffer(bytes.data() + header.vertexOffset, header.numVertices * sizeof(VertexType::ModelVertex));
+            Graphics::IndexBuffer indexBuffer(bytes.data() + header.indexOffset, header.numIndices * header.indexSize);
+            Graphics::Bounds bounds{ glm::make_vec3(header.min), glm::make_vec3(header.max) };
+            return std::make_shared<Graphics::Mesh>(std::move(vertexBuffer), std::move(indexBuffer), std::move(cooked.subMeshes), header.indexSize, bounds);
+        }
+
+        std::shared_ptr<MeshData> ParseMesh(const ResourceView &bytes, const std::string &name)
+        {
+            auto document = GetGLTFDocument(bytes, name, GLTF_MESH);
+            if(!document->valid)
+                return nullptr;
 
-            std::vector<unsigned char> vertices = GLTFHelper::Interleave(positions, normals, texCoords, joints, weights);
+            std::string warning;
+            auto meshData = ExtractGLTFMesh(document->model, warning);
+            if(!warning.empty())
+                Logger::Instance().Warning(fmt::format("({}): {}", name, warning));
+            if(!meshData)
+                return nullptr;
+            return std::make_shared<MeshData>(std::move(*meshData));
+        }
 
-            std::vector<unsigned short> indices;
-            const tinygltf::Accessor &indexAccessor = model.accessors.at(primitive.indices);
-            GLTFHelper::GetValues(model, indexAccessor, indices);
+        Graphics::Mesh::Ptr BuildMesh(const MeshData &meshData)
+        {
+            Graphics::VertexBuffer vertexBuffer(meshData.vertices);
+            Graphics::IndexBuffer indexBuffer(meshData.indices);
 
-            Graphics::VertexBuffer vertexBuffer(vertices);
-            Graphics::IndexBuffer indexBuffer(indices);
-            
-            int numIndices = static_cast<int>(model.accessors.at(primitive.indices).count);
+            std::vector<Graphics::SubMesh> subMeshes;
+            subMeshes.reserve(meshData.subMeshes.size());
+            for(const auto &subMesh : meshData.subMeshes)
+                subMeshes.push_back({ subMesh.offset, subMesh.count, subMesh.material });
 
-            return std::make_shared<Graphics::Mesh>(std::move(vertexBuffer), std::move(indexBuffer), numIndices);
+            return std::make_shared<Graphics::Mesh>(std::move(vertexBuffer), std::move(indexBuffer), std::move(subMeshes), meshData.indexSize, Graphics::Bounds{ meshData.min, meshData.max });
         }
-        else
+    }
+
+    template<>
+    std::shared_ptr<Graphics::Mesh> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        if(IsCookedMesh(bytes))
         {
+            auto cooked = ReadCookedMesh(bytes, name);
+            if(!cooked)
+                return nullptr;
+            return BuildCookedMesh(std::move(*cooked), bytes);
+        }
+
+        auto meshData = ParseMesh(bytes, name);
+        if(!meshData)
             return nullptr;
+        return BuildMesh(*meshData);
+    }
+
+    template<>
+    Upload<Graphics::Mesh> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        if(IsCookedMesh(bytes))
+        {
+            auto cooked = ReadCookedMesh(bytes, name);
+            if(!cooked)
+                return Ready<Graphics::Mesh>(nullptr);
+            return [cooked = std::move(*cooked), bytes]{ return BuildCookedMesh(cooked, bytes); };
         }
+
+        auto meshData = ParseMesh(bytes, name);
+        if(!meshData)
+            return Ready<Graphics::Mesh>(nullptr);
+        return [meshData]{ return BuildMesh(*meshData); };
     }
 
     template<>
-    std::shared_ptr<Graphics::Animation::Skeleton> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    std::shared_ptr<Graphics::Animation::Skeleton> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
     {
         auto &logger = Logger::Instance();
 
-        tinygltf::TinyGLTF gltfLoader;
-        tinygltf::Model model;
-        std::string err, warn;
-
-        bool result = gltfLoader.LoadBinaryFromMemory(&model, &err, &warn, reinterpret_cast<const unsigned char*>(bytes.data()), static_cast<unsigned int>(bytes.size()));
-        if(!warn.empty()) logger.Warning(warn);
-        if(result)
+        auto document = GetGLTFDocument(bytes, name, GLTF_SKELETON);
+        const tinygltf::Model &model = document->model;
+        if(document->valid)
         {
             if(model.skins.size() == 0)
             {
@@ -392,6 +497,9 @@ namespace RIS::Loader
 
             std::vector<std::string> names;
             Graphics::Animation::Pose restPose = GLTFHelper::LoadRestPose(model, skin, names, logger);
+            // the bones are ordered parents first, only a joint hierarchy with cycles can still fail this
+            if(!restPose.IsTopological())
+                logger.Warning(fmt::format("({}): skin joints have a cyclic hierarchy", name));
             Graphics::Animation::Pose bindPose = GLTFHelper::LoadBindPose(model, skin, restPose, logger);
 
             return std::make_shared<Graphics::Animation::Skeleton>(std::move(restPose), std::move(bindPose), std::move(names));
@@ -403,17 +511,13 @@ namespace RIS::Loader
     }
 
     template<>
-    std::shared_ptr<Graphics::Animation::Animation> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    std::shared_ptr<Graphics::Animation::Animation> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
     {
         auto &logger = Logger::Instance();
 
-        tinygltf::TinyGLTF gltfLoader;
-        tinygltf::Model model;
-        std::string err, warn;
-
-        bool result = gltfLoader.LoadBinaryFromMemory(&model, &err, &warn, reinterpret_cast<const unsigned char*>(bytes.data()), static_cast<unsigned int>(bytes.size()));
-        if(!warn.empty()) logger.Warning(warn);
-        if(result)
+        auto document = GetGLTFDocument(bytes, name, GLTF_ANIMATION);
+        const tinygltf::Model &model = document->model;
+        if(document->valid)
         {
             std::size_t numClips = model.animations.size();
 
@@ -459,6 +563,18 @@ namespace RIS::Loader
 
                 return std::make_shared<Graphics::Animation::Animation>(std::move(fastClips));
             }
+            else if constexpr (std::is_same_v<Graphics::Animation::Animation::ClipType, Graphics::Animation::CompressedClip>)
+            {
+                std::vector<Graphics::Animation::CompressedClip> compressedClips(clips.size());
+                for(std::size_t i = 0; i < clips.size(); ++i)
+                {
+                    compressedClips[i] = Graphics::Animation::CompressClip(clips.at(i));
+                    if(!compressedClips[i].WithinTolerance())
+                        logger.Warning(fmt::format("({}): clip {} has keys the compression can't keep within its tolerances", name, clips.at(i).GetName()));
+                }
+
+                return std::make_shared<Graphics::Animation::Animation>(std::move(compressedClips));
+            }
             else
             {
                 return std::make_shared<Graphics::Animation::Animation>(std::move(clips));
@@ -466,34 +582,83 @@ namespace RIS::Loader
         }
         else
         {
-            if(!err.empty()) logger.Error(err);
             return nullptr;
         }
     }
 
     template<>
-    std::shared_ptr<Graphics::Model> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    Upload<Graphics::Animation::Skeleton> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        return Ready(Load<Graphics::Animation::Skeleton>(bytes, name, param, resourcePack));
+    }
+
+    template<>
+    Upload<Graphics::Animation::Animation> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
     {
-        std::string modelStr(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        return Ready(Load<Graphics::Animation::Animation>(bytes, name, param, resourcePack));
+    }
 
-        rapidjson::Document modelJson;
-        rapidjson::ParseResult res = modelJson.Parse(modelStr.c_str()); 
-        if(res.IsError())
+    namespace
+    {
+        struct ModelDesc
         {
-            std::string errorMsg = rapidjson::GetParseError_En(res.Code());
-            Logger::Instance().Error(fmt::format("Failed to parse model ({}): {}({})", name, errorMsg, std::to_string(res.Offset())));
-            return nullptr;
+            std::string meshName;
+            std::string textureName;
+        };
+
+        std::optional<ModelDesc> ParseModel(const ResourceView &bytes, const std::string &name)
+        {
+            std::string modelStr(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+
+            rapidjson::Document modelJson;
+            rapidjson::ParseResult res = modelJson.Parse(modelStr.c_str()); 
+            if(res.IsError())
+            {
+                std::string errorMsg = rapidjson::GetParseError_En(res.Code());
+                Logger::Instance().Error(fmt::format("Failed to parse model ({}): {}({})", name, errorMsg, std::to_string(res.Offset())));
+                return std::nullopt;
+            }
+
+            return ModelDesc{ modelJson["mesh"].GetString(), modelJson["texture"].GetString() };
         }
+    }
 
-        std::string meshName = modelJson["mesh"].GetString();
-        std::string textureName = modelJson["texture"].GetString();
+    template<>
+    std::shared_ptr<Graphics::Model> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        auto desc = ParseModel(bytes, name);
+        if(!desc)
+            return nullptr;
 
-        auto textureId = Load<Graphics::Texture>(resourcePack.Read(textureName), textureName, {}, resourcePack);
-        auto meshId = Load<Graphics::Mesh>(resourcePack.Read(meshName), meshName, {}, resourcePack);
+        auto textureId = Load<Graphics::Texture>(desc->textureName, resourcePack);
+        auto meshId = Load<Graphics::Mesh>(desc->meshName, resourcePack);
 
         if(!textureId || !meshId)
             return nullptr;
 
         return std::make_shared<Graphics::Model>(meshId, textureId);
     }
+
+    template<>
+    Upload<Graphics::Model> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        auto desc = ParseModel(bytes, name);
+        if(!desc)
+            return Ready<Graphics::Model>(nullptr);
+
+        auto textureFuture = LoadAsync<Graphics::Texture>(desc->textureName, resourcePack);
+        auto meshFuture = LoadAsync<Graphics::Mesh>(desc->meshName, resourcePack);
+
+        auto ready = [textureFuture, meshFuture]{ return IsReady(textureFuture) && IsReady(meshFuture); };
+        return Upload<Graphics::Model>(ready, [textureFuture, meshFuture]() -> Graphics::Model::Ptr
+        {
+            auto textureId = textureFuture.get();
+            auto meshId = meshFuture.get();
+
+            if(!textureId || !meshId)
+                return nullptr;
+
+            return std::make_shared<Graphics::Model>(meshId, textureId);
+        });
+    }
 }
@@ -18,14 +18,26 @@ namespace RIS::Graphics
 namespace RIS::Loader
 {
     template<>
-    std::shared_ptr<Graphics::Mesh> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    std::shared_ptr<Graphics::Mesh> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
 
     template<>
-    std::shared_ptr<Graphics::Animation::Skeleton> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    std::shared_ptr<Graphics::Animation::Skeleton> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
 
     template<>
-    std::shared_ptr<Graphics::Animation::Animation> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    std::shared_ptr<Graphics::Animation::Animation> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
 
     template<>
-    std::shared_ptr<Graphics::Model> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    std::shared_ptr<Graphics::Model> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
+    template<>
+    Upload<Graphics::Mesh> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
+    template<>
+    Upload<Graphics::Animation::Skeleton> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
+    template<>
+    Upload<Graphics::Animation::Animation> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
+    template<>
+    Upload<Graphics::Model> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
 }
@@ -1,10 +1,21 @@
 #pragma once
 
+#include "loader/ResourceView.hpp"
+#include "misc/StringSupport.hpp"
+
 #include <vector>
 #include <string>
+#include <filesystem>
 
 namespace RIS::Loader
 {
+    // resource names are compared case insensitive and with '/' separators
+    inline std::string NormalizeResourceName(const std::string &res)
+    {
+        std::filesystem::path path = res;
+        return lowerCase(path.lexically_normal().generic_string());
+    }
+
     class Pack
     {
     public:
@@ -12,6 +23,11 @@ namespace RIS::Loader
 
         virtual std::vector<std::byte> Read(const std::string &res) const = 0;
         virtual bool Contains(const std::string &res) const = 0;
+        // every resource in the pack, used to build the ResourcePack index
+        virtual std::vector<std::string> List() const = 0;
+
+        // packs that can hand out their storage directly override this to avoid the copy
+        virtual ResourceView Map(const std::string &res) const { return ResourceView(Read(res)); }
 
     };
 }
@@ -0,0 +1,114 @@
+#include "loader/PolyFile.hpp"
+#include "loader/BinaryReader.hpp"
+
+#include "RisExcept.hpp"
+
+#include <fmt/format.h>
+
+#include <string_view>
+
+namespace RIS::Loader
+{
+    namespace
+    {
+        std::string TextureName(const char (&texture)[64])
+        {
+            return fmt::format("textures/{}.dds", FixedString(texture));
+        }
+
+        // every section is a list of polygons with their own vertices and 16 bit indices
+        void ParsePolyV1(BinaryReader &reader, const polyheader &header, PolyFile &poly)
+        {
+            auto &vertices = poly.vertices;
+            auto &indices = poly.indices;
+            for(std::uint32_t s = 0; s < header.numSections; ++s)
+            {
+                auto section = reader.Read<polysection>();
+
+                auto &sec = poly.sections.emplace_back();
+                sec.texture = TextureName(section.texture);
+                sec.offset = indices.size();
+
+                for(std::uint32_t p = 0; p < section.numPolygons; ++p)
+                {
+                    auto data = reader.Read<polydata>();
+
+                    auto polyVertices = reader.View<VertexType::MapVertex>(data.numVertices);
+                    auto polyIndices = reader.View<std::uint16_t>(data.numIndices);
+
+                    std::size_t baseVertex = vertices.size();
+                    vertices.resize(baseVertex + polyVertices.size());
+                    polyVertices.CopyTo(vertices.data() + baseVertex);
+
+                    std::size_t baseIndex = indices.size();
+                    indices.resize(baseIndex + polyIndices.size());
+                    for(std::size_t i = 0; i < polyIndices.size(); ++i)
+                    {
+                        std::uint16_t index = polyIndices[i];
+                        if(index >= data.numVertices)
+                            throw RISException(fmt::format("Index {} out of range in section {}", index, s));
+                        indices[baseIndex + i] = static_cast<std::uint32_t>(baseVertex + index);
+                    }
+                }
+                sec.count = indices.size() - sec.offset;
+            }
+        }
+
+        // the totals size the arrays once, every section is read straight into them
+        void ParsePolyV2(BinaryReader &reader, const polyheader &header, PolyFile &poly)
+        {
+            auto totals = reader.Read<polytotals>();
+            if(static_cast<std::uint64_t>(totals.numVertices) * sizeof(VertexType::MapVertex) + static_cast<std::uint64_t>(totals.numIndices) * sizeof(std::uint32_t) > reader.Remaining())
+                throw RISException("Vertex and index totals are larger than the file");
+
+            auto &vertices = poly.vertices;
+            auto &indices = poly.indices;
+            vertices.resize(totals.numVertices);
+            indices.resize(totals.numIndices);
+
+            std::size_t vertexOffset = 0, indexOffset = 0;
+            for(std::uint32_t s = 0; s < header.numSections; ++s)
+            {
+                auto section = reader.Read<polysection2>();
+                if(section.numVertices > vertices.size() - vertexOffset || section.numIndices > indices.size() - indexOffset)
+                    throw RISException(fmt::format("Section {} is larger than the totals", s));
+
+                reader.ReadArray(vertices.data() + vertexOffset, section.numVertices);
+                reader.ReadArray(indices.data() + indexOffset, section.numIndices);
+
+                for(std::size_t i = indexOffset; i < indexOffset + section.numIndices; ++i)
+                {
+                    if(indices[i] >= section.numVertices)
+                        throw RISException(fmt::format("Index {} out of range in section {}", indices[i], s));
+                    indices[i] += static_cast<std::uint32_t>(vertexOffset);
+                }
+
+                poly.sections.push_back({ TextureName(section.texture), indexOffset, section.numIndices });
+
+                vertexOffset += section.numVertices;
+                indexOffset += section.numIndices;
+            }
+
+            if(vertexOffset != vertices.size() || indexOffset != indices.size())
+                throw RISException("Sections don't add up to the totals");
+        }
+    }
+
+    std::optional<PolyFile> ParsePolyFile(const std::byte *data, std::size_t size)
+    {
+        BinaryReader reader(data, size);
+
+        auto header = reader.Read<polyheader>();
+        if(std::string_view(header.magic, sizeof header.magic) != std::string_view(POLY_FILE_MAGIC, sizeof POLY_FILE_MAGIC))
+            return std::nullopt;
+
+        PolyFile poly;
+        if(header.version == POLY_FILE_VERSION_1)
+            ParsePolyV1(reader, header, poly);
+        else if(header.version == POLY_FILE_VERSION_2)
+            ParsePolyV2(reader, header, poly);
+        else
+            throw RISException(fmt::format("Unsupported version {}", header.version));
+        return poly;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "graphics/VertexTypes.hpp"
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+namespace RIS::Loader
+{
+    // .poly files with the world geometry of a map. little endian:
+    //   polyheader
+    //   version 1: per section a polysection, then per polygon a polydata, MapVertex[numVertices], uint16_t[numIndices]
+    //   version 2: polytotals, then per section a polysection2, MapVertex[numVertices] and
+    //              uint32_t[numIndices] relative to the first vertex of the section
+    constexpr char POLY_FILE_MAGIC[4] = {'P', 'O', 'L', 'Y'};
+    constexpr std::uint32_t POLY_FILE_VERSION_1 = 1;
+    constexpr std::uint32_t POLY_FILE_VERSION_2 = 2;
+
+    struct polyheader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t numSections;
+    };
+
+    struct polysection
+    {
+        char texture[64];
+        std::uint32_t numPolygons;
+    };
+
+    struct polydata
+    {
+        std::uint32_t numVertices;
+        std::uint32_t numIndices;
+    };
+
+    struct polytotals
+    {
+        std::uint32_t numVertices;
+        std::uint32_t numIndices;
+    };
+
+    struct polysection2
+    {
+        char texture[64];
+        std::uint32_t numVertices;
+        std::uint32_t numIndices;
+    };
+
+    // a range of the indices drawn with one texture
+    struct PolySection
+    {
+        std::string texture;
+        std::size_t offset;
+        std::size_t count;
+    };
+
+    // indices point into the vertices of the whole file
+    struct PolyFile
+    {
+        std::vector<VertexType::MapVertex> vertices;
+        std::vector<std::uint32_t> indices;
+        std::vector<PolySection> sections;
+    };
+
+    // nullopt if the bytes aren't a poly file, throws RISException if the file is broken
+    std::optional<PolyFile> ParsePolyFile(const std::byte *data, std::size_t size);
+}
@@ -4,12 +4,57 @@ namespace RIS::Loader
 {
     std::vector<std::byte> ResourcePack::Read(const std::string &res) const
     {
-        for(const PackType& p : packs)
+        if(const IndexEntry *entry = Find(res))
+            return GetPack(packs[entry->pack]).Read(entry->name);
+        return {};
+    }
+
+    ResourceView ResourcePack::Map(const std::string &res) const
+    {
+        if(const IndexEntry *entry = Find(res))
+            return GetPack(packs[entry->pack]).Map(entry->name);
+        return {};
+    }
+
+    bool ResourcePack::Contains(const std::string &res) const
+    {
+        return Find(res) != nullptr;
+    }
+
+    void ResourcePack::RebuildIndex()
+    {
+        index.clear();
+        for(std::size_t i = 0; i < packs.size(); ++i)
+            IndexPack(i, false);
+    }
+
+    std::string ResourcePack::IndexKey(const std::string &res)
+    {
+        return NormalizeResourceName(res);
+    }
+
+    const Pack& ResourcePack::GetPack(const PackType &pack)
+    {
+        return std::visit([](auto &&v) -> const Pack& { return v; }, pack);
+    }
+
+    void ResourcePack::IndexPack(std::size_t packIndex, bool overwrite)
+    {
+        for(auto &name : GetPack(packs[packIndex]).List())
         {
-            const Pack &pack = std::visit([](auto &&v) -> const Pack& { return v; }, p);
-            if(pack.Contains(res))
-                return pack.Read(res);
+            std::string key = IndexKey(name);
+            if(overwrite)
+                index.insert_or_assign(std::move(key), IndexEntry{ packIndex, std::move(name) });
+            else
+                index.try_emplace(std::move(key), IndexEntry{ packIndex, std::move(name) });
         }
-        return {};
+    }
+
+    const ResourcePack::IndexEntry* ResourcePack::Find(const std::string &res) const
+    {
+        auto found = index.find(IndexKey(res));
+        if(found == std::end(index))
+            return nullptr;
+        return &found->second;
     }
 }
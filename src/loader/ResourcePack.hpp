@@ -3,14 +3,16 @@
 #include <vector>
 #include <string>
 #include <variant>
+#include <unordered_map>
 
 #include "loader/ZipPack.hpp"
+#include "loader/RisPack.hpp"
 #include "loader/FilesystemPack.hpp"
 #include "loader/EmbeddedPack.hpp"
 
 namespace RIS::Loader
 {
-    using PackType = std::variant<ZipPack, FilesystemPack, EmbeddedPack>;
+    using PackType = std::variant<ZipPack, RisPack, FilesystemPack, EmbeddedPack>;
 
     class ResourcePack
     {
@@ -21,9 +23,30 @@ namespace RIS::Loader
         void PushBack(P &&pack);
 
         std::vector<std::byte> Read(const std::string &res) const;
+        // like Read, but without copying the resource if the pack supports it
+        ResourceView Map(const std::string &res) const;
+        bool Contains(const std::string &res) const;
+
+        // the index is built when a pack is pushed, call this if files were added to a pack afterwards
+        void RebuildIndex();
+
+    private:
+        struct IndexEntry
+        {
+            std::size_t pack;
+            std::string name;   // name as stored in the pack
+        };
+
+        static std::string IndexKey(const std::string &res);
+        static const Pack& GetPack(const PackType &pack);
+
+        void IndexPack(std::size_t packIndex, bool overwrite);
+        const IndexEntry* Find(const std::string &res) const;
 
     private:
         std::vector<PackType> packs;
+        // case insensitive resource name to the pack with the highest priority that has it
+        std::unordered_map<std::string, IndexEntry> index;
 
     };
 
@@ -31,11 +54,15 @@ namespace RIS::Loader
     void ResourcePack::PushFront(P &&pack)
     {
         packs.insert(packs.begin(), std::forward<P>(pack));
+        for(auto &[key, entry] : index)
+            entry.pack++;
+        IndexPack(0, true);
     }
 
     template<typename P>
     void ResourcePack::PushBack(P &&pack)
     {
         packs.push_back(std::forward<P>(pack));
+        IndexPack(packs.size() - 1, false);
     }
 }
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include <gsl/span>
+
+namespace RIS::Loader
+{
+    // read only view of a resource. the owner keeps the memory alive (a file mapping or a buffer)
+    // for as long as a copy of the view exists
+    class ResourceView
+    {
+    public:
+        ResourceView() = default;
+
+        ResourceView(std::vector<std::byte> &&bytes)
+        {
+            if(bytes.empty())
+                return;
+
+            auto buffer = std::make_shared<std::vector<std::byte>>(std::move(bytes));
+            ptr = buffer->data();
+            length = buffer->size();
+            owner = std::move(buffer);
+        }
+
+        ResourceView(std::shared_ptr<const void> owner, const std::byte *data, std::size_t size)
+            : owner(std::move(owner)), ptr(data), length(size)
+        {}
+
+        const std::byte* data() const { return ptr; }
+        std::size_t size() const { return length; }
+        bool empty() const { return length == 0; }
+
+        const std::byte* begin() const { return ptr; }
+        const std::byte* end() const { return ptr + length; }
+        const std::byte& operator[](std::size_t index) const { return ptr[index]; }
+
+        // part of this view that shares its owner
+        ResourceView Sub(std::size_t offset, std::size_t size) const { return ResourceView(owner, ptr + offset, size); }
+
+        gsl::span<const std::byte> Span() const { return gsl::span<const std::byte>(ptr, length); }
+
+    private:
+        std::shared_ptr<const void> owner;
+        const std::byte *ptr = nullptr;
+        std::size_t length = 0;
+
+    };
+}
@@ -0,0 +1,151 @@
+#include "loader/RisPack.hpp"
+#include "loader/MappedFile.hpp"
+
+#include "RisExcept.hpp"
+
+#include <lz4.h>
+#include <zstd.h>
+
+#include <fmt/format.h>
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+namespace RIS::Loader
+{
+    namespace
+    {
+        ResourceView OpenArchive(const std::string &archivePath)
+        {
+            auto file = std::make_shared<MappedFile>(archivePath);
+            if(file->IsOpen())
+            {
+                const std::byte *data = file->Data();
+                std::size_t size = file->Size();
+                return ResourceView(std::move(file), data, size);
+            }
+
+            // no mmap, keep the whole archive in memory
+            std::ifstream stream(archivePath, std::ios::binary | std::ios::ate);
+            if(!stream)
+                return {};
+
+            std::size_t size = stream.tellg();
+            stream.seekg(0);
+            std::vector<std::byte> bytes(size);
+            stream.read(reinterpret_cast<char*>(bytes.data()), size);
+            return ResourceView(std::move(bytes));
+        }
+    }
+
+    RisPack::RisPack(const std::string &archivePath)
+        : archive(OpenArchive(archivePath))
+    {
+        if(archive.size() < sizeof(RisPackHeader))
+            throw RISException(fmt::format("Can't open archive {}", archivePath));
+
+        RisPackHeader header;
+        std::memcpy(&header, archive.data(), sizeof(header));
+        if(std::memcmp(header.magic, RISPACK_MAGIC, sizeof(RISPACK_MAGIC)) != 0 || header.version != RISPACK_VERSION)
+            throw RISException(fmt::format("{} is not a version {} rpak archive", archivePath, RISPACK_VERSION));
+
+        std::uint64_t tocSize = static_cast<std::uint64_t>(header.numEntries) * sizeof(RisPackEntry);
+        if(header.tocOffset % alignof(RisPackEntry) != 0 || header.tocOffset > archive.size() || tocSize > archive.size() - header.tocOffset
+            || header.namesOffset > archive.size() || header.namesSize > archive.size() - header.namesOffset)
+            throw RISException(fmt::format("Archive {} is corrupt", archivePath));
+
+        entries = reinterpret_cast<const RisPackEntry*>(archive.data() + header.tocOffset);
+        numEntries = header.numEntries;
+        names = reinterpret_cast<const char*>(archive.data() + header.namesOffset);
+
+        // Read allocates originalSize before decompressing and Map hands out stored entries as they are,
+        // so both have to be sane before anything trusts them
+        for(std::size_t i = 0; i < numEntries; ++i)
+        {
+            const auto &entry = entries[i];
+            if(entry.offset > archive.size() || entry.size > archive.size() - entry.offset
+                || entry.originalSize > RISPACK_MAX_ENTRY_SIZE
+                || (entry.compression == RisPackCompression::NONE && entry.size != entry.originalSize)
+                || static_cast<std::uint64_t>(entry.nameOffset) + entry.nameLength > header.namesSize)
+                throw RISException(fmt::format("Archive {} is corrupt", archivePath));
+        }
+    }
+
+    std::vector<std::byte> RisPack::Read(const std::string &res) const
+    {
+        const RisPackEntry *entry = Find(res);
+        if(!entry)
+            return {};
+
+        std::vector<std::byte> bytes(entry->originalSize);
+        if(!Decompress(*entry, bytes.data()))
+            return {};
+        return bytes;
+    }
+
+    bool RisPack::Contains(const std::string &res) const
+    {
+        return Find(res) != nullptr;
+    }
+
+    std::vector<std::string> RisPack::List() const
+    {
+        std::vector<std::string> resources;
+        resources.reserve(numEntries);
+        for(std::size_t i = 0; i < numEntries; ++i)
+            resources.emplace_back(names + entries[i].nameOffset, entries[i].nameLength);
+        return resources;
+    }
+
+    ResourceView RisPack::Map(const std::string &res) const
+    {
+        const RisPackEntry *entry = Find(res);
+        if(!entry)
+            return {};
+
+        if(entry->compression == RisPackCompression::NONE)
+            return archive.Sub(entry->offset, entry->size);
+        return ResourceView(Read(res));
+    }
+
+    const RisPackEntry* RisPack::Find(const std::string &res) const
+    {
+        std::string name = NormalizeResourceName(res);
+        std::uint64_t hash = HashPath(name);
+        const RisPackEntry *end = entries + numEntries;
+        const RisPackEntry *found = std::lower_bound(entries, end, hash, [](const RisPackEntry &entry, std::uint64_t hash){ return entry.nameHash < hash; });
+
+        // the hash only narrows it down, names that collide or archives from other packers need the stored name
+        for(; found != end && found->nameHash == hash; ++found)
+        {
+            if(NormalizeResourceName(std::string(names + found->nameOffset, found->nameLength)) == name)
+                return found;
+        }
+        return nullptr;
+    }
+
+    bool RisPack::Decompress(const RisPackEntry &entry, std::byte *dst) const
+    {
+        const std::byte *src = archive.data() + entry.offset;
+        switch(entry.compression)
+        {
+            case RisPackCompression::NONE:
+                if(entry.size != entry.originalSize)
+                    return false;
+                std::memcpy(dst, src, entry.size);
+                return true;
+            case RisPackCompression::LZ4:
+            {
+                int size = LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst), static_cast<int>(entry.size), static_cast<int>(entry.originalSize));
+                return size >= 0 && static_cast<std::uint64_t>(size) == entry.originalSize;
+            }
+            case RisPackCompression::ZSTD:
+            {
+                std::size_t size = ZSTD_decompress(dst, entry.originalSize, src, entry.size);
+                return !ZSTD_isError(size) && size == entry.originalSize;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "loader/Pack.hpp"
+#include "loader/RisPackFormat.hpp"
+
+#include <string>
+#include <vector>
+
+namespace RIS::Loader
+{
+    // .rpak archive created by the packer tool. the archive is mapped once and only read afterwards,
+    // so any number of threads can read from it at the same time
+    class RisPack : public Pack
+    {
+    public:
+        RisPack(const std::string &archivePath);
+        virtual ~RisPack() = default;
+
+        RisPack(const RisPack &) = delete;
+        RisPack& operator=(const RisPack &) = delete;
+        RisPack(RisPack &&) = default;
+        RisPack& operator=(RisPack &&) = default;
+
+        std::vector<std::byte> Read(const std::string &res) const override;
+        bool Contains(const std::string &res) const override;
+        std::vector<std::string> List() const override;
+        // uncompressed entries point straight into the mapped archive
+        ResourceView Map(const std::string &res) const override;
+
+    private:
+        const RisPackEntry* Find(const std::string &res) const;
+        bool Decompress(const RisPackEntry &entry, std::byte *dst) const;
+
+    private:
+        ResourceView archive;
+        const RisPackEntry *entries = nullptr;
+        std::size_t numEntries = 0;
+        const char *names = nullptr;
+
+    };
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "loader/Pack.hpp"
+#include "loader/AssetId.hpp"
+
+#include <cstdint>
+#include <string>
+
+// on disk layout of .rpak archives, shared by RisPack and the packer tool.
+// everything is little endian:
+//   RisPackHeader
+//   entry data, every entry starts at a multiple of RISPACK_ALIGNMENT
+//   RisPackEntry[numEntries] at tocOffset, sorted by nameHash
+//   names, not null terminated, at namesOffset
+namespace RIS::Loader
+{
+    constexpr char RISPACK_MAGIC[4] = { 'R', 'P', 'A', 'K' };
+    constexpr std::uint32_t RISPACK_VERSION = 1;
+    constexpr std::uint64_t RISPACK_ALIGNMENT = 16;
+    // largest entry after decompression, LZ4 can't handle more than 2 GB anyway
+    constexpr std::uint64_t RISPACK_MAX_ENTRY_SIZE = 1ull << 30;
+
+    enum class RisPackCompression : std::uint8_t
+    {
+        NONE = 0,
+        LZ4 = 1,
+        ZSTD = 2
+    };
+
+    struct RisPackHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t numEntries;
+        std::uint32_t reserved;
+        std::uint64_t tocOffset;
+        std::uint64_t namesOffset;
+        std::uint64_t namesSize;
+    };
+
+    struct RisPackEntry
+    {
+        std::uint64_t nameHash;
+        std::uint64_t offset;
+        std::uint64_t size;             // size in the archive
+        std::uint64_t originalSize;     // size after decompression
+        std::uint32_t nameOffset;
+        std::uint16_t nameLength;
+        RisPackCompression compression;
+        std::uint8_t reserved;
+    };
+
+    static_assert(sizeof(RisPackHeader) == 40);
+    static_assert(sizeof(RisPackEntry) == 40);
+
+    // names are hashed case insensitive, the same way the ResourcePack index compares them
+    inline std::uint64_t RisPackNameHash(const std::string &name)
+    {
+        return HashPath(NormalizeResourceName(name));
+    }
+}
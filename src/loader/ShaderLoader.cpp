@@ -1,36 +1,69 @@
 #include "loader/ShaderLoader.hpp"
 
 #include "loader/TextLoader.hpp"
+#include "loader/Loader.hpp"
 
 #include "graphics/Shader.hpp"
 #include "graphics/ShaderSourceBuilder.hpp"
 
+#include "RisExcept.hpp"
+
+#include <fmt/format.h>
+
 namespace RIS::Loader
 {
+    namespace
+    {
+        GLenum GetShaderType(const std::any &param)
+        {
+            GLenum shaderType;
+            auto shaderParam = std::any_cast<Graphics::ShaderType>(param);
+            if(shaderParam == Graphics::ShaderType::VERTEX)
+                shaderType = GL_VERTEX_SHADER;
+            else if(shaderParam == Graphics::ShaderType::FRAGMENT)
+                shaderType = GL_FRAGMENT_SHADER;
+            return shaderType;
+        }
+
+        std::string BuildShaderSource(const ResourceView &bytes, const std::string &name, const ResourcePack &resourcePack)
+        {
+            std::string path = std::filesystem::path(name).remove_filename().generic_string();
+
+            Graphics::ShaderSourceBuilder builder;
+
+            std::string shaderSrc(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            return builder.BuildSource(shaderSrc, [&resourcePack, &path](const std::string &fileName)
+            {
+                std::string file = path + fileName;
+                auto source = Load<std::string>(file, resourcePack);
+                if(!source)
+                    throw RISException(fmt::format("Could not load shader include {}", file));
+                return *source;
+            });
+        }
+    }
+
     template<>
-    std::shared_ptr<Graphics::Shader> Load<Graphics::Shader>(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    std::shared_ptr<Graphics::Shader> Load<Graphics::Shader>(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
     {
         if(bytes.size() == 0)
             return nullptr;
 
-        GLenum shaderType;
-        auto shaderParam = std::any_cast<Graphics::ShaderType>(param);
-        if(shaderParam == Graphics::ShaderType::VERTEX)
-            shaderType = GL_VERTEX_SHADER;
-        else if(shaderParam == Graphics::ShaderType::FRAGMENT)
-            shaderType = GL_FRAGMENT_SHADER;
+        GLenum shaderType = GetShaderType(param);
+        std::string shaderSrcProcessed = BuildShaderSource(bytes, name, resourcePack);
 
-        std::string path = std::filesystem::path(name).remove_filename().generic_string();
+        return std::make_shared<Graphics::Shader>(shaderSrcProcessed, shaderType);        
+    }
 
-        Graphics::ShaderSourceBuilder builder;
+    template<>
+    Upload<Graphics::Shader> Prepare<Graphics::Shader>(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        if(bytes.size() == 0)
+            return Ready<Graphics::Shader>(nullptr);
 
-        std::string shaderSrc(reinterpret_cast<const char*>(bytes.data()), bytes.size());
-        std::string shaderSrcProcessed = builder.BuildSource(shaderSrc, [&resourcePack, &path](const std::string &fileName)
-        {
-            std::string file = path + fileName;
-            return *Load<std::string>(resourcePack.Read(file), file, {}, resourcePack);
-        });
+        GLenum shaderType = GetShaderType(param);
+        std::string shaderSrcProcessed = BuildShaderSource(bytes, name, resourcePack);
 
-        return std::make_shared<Graphics::Shader>(shaderSrcProcessed, shaderType);        
+        return [shaderSrcProcessed, shaderType]{ return std::make_shared<Graphics::Shader>(shaderSrcProcessed, shaderType); };
     }
 }
@@ -9,5 +9,8 @@ namespace RIS::Graphics { class Shader; }
 namespace RIS::Loader
 {
     template<>
-    std::shared_ptr<Graphics::Shader> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    std::shared_ptr<Graphics::Shader> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
+    template<>
+    Upload<Graphics::Shader> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
 }
@@ -3,10 +3,16 @@
 namespace RIS::Loader
 {
     template<>
-    std::shared_ptr<std::string> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    std::shared_ptr<std::string> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
     {
         if(bytes.size() == 0)
             return nullptr;
         return std::make_shared<std::string>(reinterpret_cast<const char*>(bytes.data()), bytes.size());
     }
+
+    template<>
+    Upload<std::string> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        return Ready(Load<std::string>(bytes, name, param, resourcePack));
+    }
 }
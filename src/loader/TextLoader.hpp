@@ -7,5 +7,8 @@
 namespace RIS::Loader
 {
     template<>
-    std::shared_ptr<std::string> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    std::shared_ptr<std::string> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
+    template<>
+    Upload<std::string> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
 }
@@ -2,16 +2,31 @@
 
 #include "graphics/Texture.hpp"
 
+#include <gli/gli.hpp>
+
 namespace RIS::Loader
 {
     template<>
-    std::shared_ptr<Graphics::Texture> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    std::shared_ptr<Graphics::Texture> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
     {
         if(bytes.size() == 0)
             return nullptr;
         
         if(bool *flip = std::any_cast<bool>(&param))
-            return std::make_shared<Graphics::Texture>(bytes, flip);
-        return std::make_shared<Graphics::Texture>(bytes);
+            return std::make_shared<Graphics::Texture>(bytes.Span(), flip);
+        return std::make_shared<Graphics::Texture>(bytes.Span());
+    }
+
+    template<>
+    Upload<Graphics::Texture> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        if(bytes.size() == 0)
+            return Ready<Graphics::Texture>(nullptr);
+
+        auto texture = std::make_shared<gli::texture>(gli::load(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+        if(bool *flip = std::any_cast<bool>(&param); flip && !texture->empty())
+            *texture = gli::flip(*texture);
+
+        return [texture]{ return std::make_shared<Graphics::Texture>(*texture); };
     }
 }
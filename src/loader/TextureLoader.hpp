@@ -9,5 +9,8 @@ namespace RIS::Graphics { class Texture; }
 namespace RIS::Loader
 {
     template<>
-    std::shared_ptr<Graphics::Texture> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    std::shared_ptr<Graphics::Texture> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
+    template<>
+    Upload<Graphics::Texture> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
 }
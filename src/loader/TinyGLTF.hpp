@@ -0,0 +1,11 @@
+#pragma once
+
+// tinygltf has to be configured the same way everywhere, the implementation lives in GLTFMesh.cpp
+#define TINYGLTF_NO_EXTERNAL_IMAGE
+#define TINYGLTF_USE_RAPIDJSON
+#define TINYGLTF_USE_CPP14
+#define TINYGLTF_NO_INCLUDE_STB_IMAGE
+#define TINYGLTF_NO_INCLUDE_STB_IMAGE_WRITE
+#define TINYGLTF_NO_STB_IMAGE_WRITE
+#define TINYGLTF_NO_STB_IMAGE
+#include <tiny_gltf.h>
@@ -1,7 +1,13 @@
 #include "loader/WorldSolidsLoader.hpp"
 
+#include "loader/BinaryReader.hpp"
+
 #include "physics/WorldSolids.hpp"
 
+#include "game/MapEntity.hpp"
+
+#include "misc/Logger.hpp"
+
 #include <fmt/format.h>
 #include <string_view>
 #include <cstdint>
@@ -23,41 +29,70 @@ namespace RIS::Loader
         uint32_t numPlanes;
     };
 
+    std::optional<std::vector<Physics::Brush>> ParseBrushFile(const std::byte *data, std::size_t size)
+    {
+        BinaryReader reader(data, size);
+
+        auto header = reader.Read<brushheader>();
+        if(std::string_view(header.magic, sizeof header.magic) != std::string_view(BRUSH_FILE_MAGIC, sizeof BRUSH_FILE_MAGIC))
+            return std::nullopt;
+        if(header.version != BRUSH_FILE_VERSION)
+            return std::nullopt;
+
+        // every brush takes at least the bytes of its plane count
+        if(header.numBrushes > reader.Remaining() / sizeof(brushdata))
+            throw RISException(fmt::format("{} brushes don't fit into the file", header.numBrushes));
+
+        std::vector<Physics::Brush> brushes(header.numBrushes);
+        for(auto &brush : brushes)
+        {
+            auto data = reader.Read<brushdata>();
+            auto planes = reader.View<Physics::Plane>(data.numPlanes);
+            brush.planes.resize(planes.size());
+            planes.CopyTo(brush.planes.data());
+        }
+        return brushes;
+    }
+
     template<>
-    std::shared_ptr<Physics::WorldSolids> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    std::shared_ptr<Physics::WorldSolids> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
     {
         if(bytes.size() == 0)
             return nullptr;
 
-        auto readBytes = [bytesPtr = bytes.data()](auto *dst, std::size_t size) mutable
+        std::optional<std::vector<Physics::Brush>> brushes;
+        try
         {
-            std::memcpy(dst, bytesPtr, size);
-            bytesPtr += size;
-        };
-
-        brushheader header = {};
-        readBytes(&header, sizeof header);
-        if(std::string_view(header.magic, sizeof header.magic) != std::string_view(BRUSH_FILE_MAGIC, sizeof BRUSH_FILE_MAGIC))
-            return nullptr;
-        if(header.version != BRUSH_FILE_VERSION)
+            brushes = ParseBrushFile(bytes.data(), bytes.size());
+            if(!brushes)
+                return nullptr;
+        }
+        catch(const RISException &e)
+        {
+            Logger::Instance().Error(fmt::format("Failed to read brush file ({}): {}", name, e.what()));
             return nullptr;
+        }
 
-        std::vector<Physics::Brush> brushes;
-        for(uint32_t b = 0; b < header.numBrushes; ++b)
+        // LoadScene passes the entities of the map, their brushes go behind the world brushes.
+        // the entities are shared with the map mesh load, so where their brushes went is kept by the world solids
+        std::vector<std::uint32_t> entityFirstBrushes;
+        if(auto entities = std::any_cast<Game::MapEntitiesPtr>(&param); entities && *entities)
         {
-            brushdata data = {};
-            readBytes(&data, sizeof data);
-
-            auto &brush = brushes.emplace_back();
-            for(uint32_t p = 0; p < data.numPlanes; ++p)
+            entityFirstBrushes.reserve((*entities)->size());
+            for(const auto &entity : **entities)
             {
-                Physics::Plane plane = {};
-                readBytes(&plane, sizeof plane);
-                brush.planes.push_back(plane);
+                entityFirstBrushes.push_back(static_cast<std::uint32_t>(brushes->size()));
+                brushes->insert(std::end(*brushes), std::begin(entity.Brushes()), std::end(entity.Brushes()));
             }
         }
 
-        Physics::WorldSolids::Ptr worldSolids = std::make_shared<Physics::WorldSolids>(std::move(brushes));
+        Physics::WorldSolids::Ptr worldSolids = std::make_shared<Physics::WorldSolids>(std::move(*brushes), std::move(entityFirstBrushes));
         return worldSolids;
     }
+
+    template<>
+    Upload<Physics::WorldSolids> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack)
+    {
+        return Ready(Load<Physics::WorldSolids>(bytes, name, param, resourcePack));
+    }
 }
@@ -2,7 +2,12 @@
 
 #include "loader/LoadFunc.hpp"
 
+#include "physics/Brush.hpp"
+
 #include <memory>
+#include <vector>
+#include <optional>
+#include <cstddef>
 
 namespace RIS::Physics
 {
@@ -11,6 +16,12 @@ namespace RIS::Physics
 
 namespace RIS::Loader
 {
+    // brushes of a .brush file, nullopt if the bytes aren't one. throws RISException if the file is broken
+    std::optional<std::vector<Physics::Brush>> ParseBrushFile(const std::byte *data, std::size_t size);
+
+    template<>
+    std::shared_ptr<Physics::WorldSolids> Load(const ResourceView &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+
     template<>
-    std::shared_ptr<Physics::WorldSolids> Load(const std::vector<std::byte> &bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
+    Upload<Physics::WorldSolids> Prepare(ResourceView bytes, const std::string &name, std::any param, const ResourcePack &resourcePack);
 }
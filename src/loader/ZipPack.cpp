@@ -1,17 +1,219 @@
 #include "loader/ZipPack.hpp"
 
+#include <zlib.h>
+
 #include <filesystem>
+#include <cstring>
+#include <cstdint>
 
 namespace RIS
 {
     namespace Loader
     {
+        namespace
+        {
+            constexpr std::uint32_t END_OF_CENTRAL_DIR_SIG = 0x06054b50;
+            constexpr std::uint32_t CENTRAL_DIR_SIG = 0x02014b50;
+            constexpr std::uint32_t LOCAL_HEADER_SIG = 0x04034b50;
+            constexpr std::size_t END_OF_CENTRAL_DIR_SIZE = 22;
+            constexpr std::size_t CENTRAL_DIR_HEADER_SIZE = 46;
+            constexpr std::size_t LOCAL_HEADER_SIZE = 30;
+            constexpr std::size_t MAX_COMMENT_SIZE = 0xffff;
+            constexpr std::uint16_t METHOD_STORE = 0;
+            constexpr std::uint16_t METHOD_DEFLATE = 8;
+
+            // zip headers are little endian
+            template<typename T>
+            T ReadLE(const std::byte *data)
+            {
+                T value = 0;
+                for(std::size_t i = 0; i < sizeof(T); ++i)
+                    value |= static_cast<T>(std::to_integer<std::uint8_t>(data[i])) << (8 * i);
+                return value;
+            }
+
+            bool Inflate(const std::byte *src, std::size_t srcSize, std::byte *dst, std::size_t dstSize)
+            {
+                z_stream stream = {};
+                // negative window bits, zip entries are raw deflate streams without zlib header
+                if(inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+                    return false;
+
+                stream.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(src));
+                stream.avail_in = static_cast<uInt>(srcSize);
+                stream.next_out = reinterpret_cast<Bytef*>(dst);
+                stream.avail_out = static_cast<uInt>(dstSize);
+
+                int result = inflate(&stream, Z_FINISH);
+                inflateEnd(&stream);
+                return result == Z_STREAM_END && stream.total_out == dstSize;
+            }
+        }
+
         ZipPack::ZipPack(const std::string &archivePath)
-            : archive(archivePath)
-        {}
+            : archive(archivePath), archiveMutex(std::make_unique<std::mutex>()), mappedArchive(std::make_shared<MappedFile>(archivePath))
+        {
+            if(mappedArchive->IsOpen())
+                IndexEntries();
+            if(entries.empty())
+                mappedArchive.reset();
+
+            crcStates = std::make_unique<std::atomic<CrcState>[]>(entries.size());
+            for(std::size_t i = 0; i < entries.size(); ++i)
+                crcStates[i] = UNCHECKED;
+        }
 
         std::vector<std::byte> ZipPack::Read(const std::string &res) const
         {
+            if(const Entry *entry = Find(res))
+            {
+                std::vector<std::byte> bytes(entry->size);
+                if(Extract(*entry, bytes.data()))
+                    return bytes;
+            }
+            return ReadLocked(res);
+        }
+
+        bool ZipPack::Contains(const std::string &res) const
+        {
+            if(Find(res))
+                return true;
+
+            std::lock_guard lock(*archiveMutex);
+            return archive.exists(res, ZIP_FL_NOCASE);
+        }
+
+        std::vector<std::string> ZipPack::List() const
+        {
+            std::lock_guard lock(*archiveMutex);
+
+            std::vector<std::string> resources;
+            int64_t numEntries = archive.num_entries();
+            for(int64_t i = 0; i < numEntries; ++i)
+            {
+                std::string name = archive.stat(i).name;
+                if(!name.empty() && name.back() != '/')
+                    resources.push_back(std::move(name));
+            }
+            return resources;
+        }
+
+        ResourceView ZipPack::Map(const std::string &res) const
+        {
+            const Entry *entry = Find(res);
+            if(entry && !entry->deflated && IsIntact(*entry))
+                return ResourceView(mappedArchive, mappedArchive->Data() + entry->offset, entry->size);
+            return ResourceView(Read(res));
+        }
+
+        // walks the central directory of the mapped archive and remembers where the data of every entry starts.
+        // anything unusual (zip64, encryption, other compression methods, broken headers) is left to libzip
+        void ZipPack::IndexEntries()
+        {
+            const std::byte *data = mappedArchive->Data();
+            std::size_t size = mappedArchive->Size();
+            if(size < END_OF_CENTRAL_DIR_SIZE)
+                return;
+
+            std::size_t searchEnd = size - END_OF_CENTRAL_DIR_SIZE;
+            std::size_t searchStart = searchEnd > MAX_COMMENT_SIZE ? searchEnd - MAX_COMMENT_SIZE : 0;
+            std::size_t eocd = searchEnd + 1;
+            for(std::size_t pos = searchEnd + 1; pos-- > searchStart;)
+            {
+                if(ReadLE<std::uint32_t>(data + pos) == END_OF_CENTRAL_DIR_SIG)
+                {
+                    eocd = pos;
+                    break;
+                }
+            }
+            if(eocd > searchEnd)
+                return;
+
+            std::size_t numEntries = ReadLE<std::uint16_t>(data + eocd + 10);
+            std::size_t dirSize = ReadLE<std::uint32_t>(data + eocd + 12);
+            std::size_t dirOffset = ReadLE<std::uint32_t>(data + eocd + 16);
+            if(dirOffset > eocd || dirSize > eocd - dirOffset)
+                return;
+
+            std::size_t pos = dirOffset;
+            for(std::size_t i = 0; i < numEntries; ++i)
+            {
+                if(pos + CENTRAL_DIR_HEADER_SIZE > eocd || ReadLE<std::uint32_t>(data + pos) != CENTRAL_DIR_SIG)
+                    return;
+
+                std::uint16_t flags = ReadLE<std::uint16_t>(data + pos + 8);
+                std::uint16_t method = ReadLE<std::uint16_t>(data + pos + 10);
+                std::uint32_t crc = ReadLE<std::uint32_t>(data + pos + 16);
+                std::uint32_t compressedSize = ReadLE<std::uint32_t>(data + pos + 20);
+                std::uint32_t uncompressedSize = ReadLE<std::uint32_t>(data + pos + 24);
+                std::size_t nameLength = ReadLE<std::uint16_t>(data + pos + 28);
+                std::size_t extraLength = ReadLE<std::uint16_t>(data + pos + 30);
+                std::size_t commentLength = ReadLE<std::uint16_t>(data + pos + 32);
+                std::size_t localOffset = ReadLE<std::uint32_t>(data + pos + 42);
+
+                std::size_t next = pos + CENTRAL_DIR_HEADER_SIZE + nameLength + extraLength + commentLength;
+                if(next > eocd)
+                    return;
+
+                bool encrypted = flags & 0x1;
+                bool zip64 = compressedSize == 0xffffffff || uncompressedSize == 0xffffffff || localOffset == 0xffffffff;
+                bool supported = method == METHOD_DEFLATE || (method == METHOD_STORE && compressedSize == uncompressedSize);
+                if(supported && !encrypted && !zip64 && localOffset + LOCAL_HEADER_SIZE <= size && ReadLE<std::uint32_t>(data + localOffset) == LOCAL_HEADER_SIG)
+                {
+                    std::size_t localNameLength = ReadLE<std::uint16_t>(data + localOffset + 26);
+                    std::size_t localExtraLength = ReadLE<std::uint16_t>(data + localOffset + 28);
+                    std::size_t dataOffset = localOffset + LOCAL_HEADER_SIZE + localNameLength + localExtraLength;
+
+                    if(dataOffset <= size && compressedSize <= size - dataOffset)
+                    {
+                        std::string name(reinterpret_cast<const char*>(data + pos + CENTRAL_DIR_HEADER_SIZE), nameLength);
+                        entries.try_emplace(NormalizeResourceName(name), Entry{ dataOffset, compressedSize, uncompressedSize, crc, method == METHOD_DEFLATE, entries.size() });
+                    }
+                }
+
+                pos = next;
+            }
+        }
+
+        const ZipPack::Entry* ZipPack::Find(const std::string &res) const
+        {
+            auto found = entries.find(NormalizeResourceName(res));
+            if(found == std::end(entries))
+                return nullptr;
+            return &found->second;
+        }
+
+        // only reads from the mapping, so any number of threads can extract at the same time
+        bool ZipPack::Extract(const Entry &entry, std::byte *dst) const
+        {
+            const std::byte *src = mappedArchive->Data() + entry.offset;
+            if(!entry.deflated)
+                std::memcpy(dst, src, entry.size);
+            else if(!Inflate(src, entry.compressedSize, dst, entry.size))
+                return false;
+
+            // sizes fit into 32 bits, zip64 entries are not indexed
+            return crc32(0, reinterpret_cast<const Bytef*>(dst), static_cast<uInt>(entry.size)) == entry.crc;
+        }
+
+        // a broken entry is never handed out, Map falls back to Read which reports it
+        bool ZipPack::IsIntact(const Entry &entry) const
+        {
+            auto &state = crcStates[entry.index];
+            CrcState current = state.load();
+            if(current == UNCHECKED)
+            {
+                const std::byte *src = mappedArchive->Data() + entry.offset;
+                current = crc32(0, reinterpret_cast<const Bytef*>(src), static_cast<uInt>(entry.size)) == entry.crc ? VALID : INVALID;
+                state = current;
+            }
+            return current == VALID;
+        }
+
+        std::vector<std::byte> ZipPack::ReadLocked(const std::string &res) const
+        {
+            std::lock_guard lock(*archiveMutex);
+
             std::filesystem::path filePath = res;
             int64_t fileIndex = archive.find(filePath.generic_string(), ZIP_FL_NOCASE);
             libzip::stat fileStat = archive.stat(fileIndex);
@@ -24,10 +226,5 @@ namespace RIS
                 return {};
             return bytes;
         }
-
-        bool ZipPack::Contains(const std::string &res) const
-        {
-            return archive.exists(res, ZIP_FL_NOCASE);
-        }
     }
 }
@@ -1,9 +1,16 @@
 #pragma once
 
 #include "loader/Pack.hpp"
+#include "loader/MappedFile.hpp"
 
 #include <zip.hpp>
 
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
 namespace RIS::Loader
 {
     class ZipPack : public Pack
@@ -19,9 +26,45 @@ namespace RIS::Loader
 
         std::vector<std::byte> Read(const std::string &res) const override;
         bool Contains(const std::string &res) const override;
+        std::vector<std::string> List() const override;
+        // stored (uncompressed) entries are returned straight from the mapped archive
+        ResourceView Map(const std::string &res) const override;
+
+    private:
+        struct Entry
+        {
+            std::size_t offset;
+            std::size_t compressedSize;
+            std::size_t size;
+            std::uint32_t crc;
+            bool deflated;
+            std::size_t index;
+        };
+
+        enum CrcState : std::uint8_t
+        {
+            UNCHECKED,
+            VALID,
+            INVALID
+        };
+
+        void IndexEntries();
+        const Entry* Find(const std::string &res) const;
+        bool Extract(const Entry &entry, std::byte *dst) const;
+        bool IsIntact(const Entry &entry) const;
+        std::vector<std::byte> ReadLocked(const std::string &res) const;
 
     private:
         libzip::archive archive;
+        // libzip handles are not thread safe, only used for entries the index can't handle
+        std::unique_ptr<std::mutex> archiveMutex;
+
+        // stored and deflated entries are read from the mapping without locking
+        std::shared_ptr<MappedFile> mappedArchive;
+        // normalized names, the archive is searched case insensitive
+        std::unordered_map<std::string, Entry> entries;
+        // stored entries are checked the first time they are mapped
+        std::unique_ptr<std::atomic<CrcState>[]> crcStates;
 
     };
 }
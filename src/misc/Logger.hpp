@@ -2,6 +2,7 @@
 
 #include <string>
 #include <fstream>
+#include <mutex>
 
 namespace RIS
 {
@@ -36,12 +37,14 @@ namespace RIS
 
     private:
         std::ofstream logFile;
+        std::mutex logMutex;
 
     };
 
     template<typename T>
     void Logger::Warning(const T &v)
     {
+        std::lock_guard lock(logMutex);
         PutTime(logFile);
         logFile << "[WARN]" << v << std::endl;
     }
@@ -49,6 +52,7 @@ namespace RIS
     template<typename T>
     void Logger::Info(const T &v)
     {
+        std::lock_guard lock(logMutex);
         PutTime(logFile);
         logFile << "[INFO]" << v << std::endl;
     }
@@ -56,6 +60,7 @@ namespace RIS
     template<typename T>
     void Logger::Error(const T &v)
     {
+        std::lock_guard lock(logMutex);
         PutTime(logFile);
         logFile << "[ERRO]" << v << std::endl;
     }
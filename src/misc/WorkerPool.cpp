@@ -0,0 +1,187 @@
+#include "misc/WorkerPool.hpp"
+
+#include <utility>
+
+namespace RIS
+{
+    WorkerPool::WorkerPool(std::size_t numWorkers)
+    {
+#ifndef __EMSCRIPTEN__
+        // the thread that waits for a ParallelFor works too, loading still needs at least one worker
+        if(numWorkers == 0)
+        {
+            unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            numWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        workers.reserve(numWorkers);
+        for(std::size_t i = 0; i < numWorkers; ++i)
+            workers.emplace_back([this]{ WorkerLoop(); });
+#else
+        // no threads, everything runs on the calling thread
+        static_cast<void>(numWorkers);
+#endif
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        Shutdown();
+    }
+
+    void WorkerPool::Enqueue(Job &&job)
+    {
+        bool queued = false;
+        {
+            std::lock_guard lock(mutex);
+            if(running && !workers.empty())
+            {
+                jobs.push_back(std::move(job));
+                queued = true;
+            }
+        }
+
+        if(queued)
+            workCondition.notify_one();
+        else
+            job();
+    }
+
+    void WorkerPool::ParallelFor(std::size_t count, const Task &loopTask)
+    {
+        if(workers.empty() || count < 2 || taskActive.exchange(true))
+        {
+            for(std::size_t i = 0; i < count; ++i)
+                loopTask(i);
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            task = &loopTask;
+            taskCount = count;
+            nextIndex = 0;
+            ++taskGeneration;
+            taskWorkers = 0;
+            taskError = nullptr;
+        }
+        workCondition.notify_all();
+
+        std::exception_ptr error;
+        try
+        {
+            RunTask(loopTask, count);
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+
+        // no worker joins anymore, the ones that did have to finish their index before task goes away
+        {
+            std::unique_lock lock(mutex);
+            task = nullptr;
+            taskDoneCondition.wait(lock, [this]{ return taskWorkers == 0; });
+            if(!error)
+                error = std::exchange(taskError, nullptr);
+        }
+        taskActive = false;
+
+        if(error)
+            std::rethrow_exception(error);
+    }
+
+    void WorkerPool::Shutdown()
+    {
+        {
+            std::lock_guard lock(mutex);
+            running = false;
+        }
+        workCondition.notify_all();
+
+        for(auto &worker : workers)
+        {
+            if(worker.joinable())
+                worker.join();
+        }
+        workers.clear();
+    }
+
+    std::size_t WorkerPool::NumWorkers() const
+    {
+        return workers.size();
+    }
+
+    void WorkerPool::RunTask(const Task &loopTask, std::size_t count)
+    {
+        while(true)
+        {
+            std::size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+            if(index >= count)
+                return;
+            loopTask(index);
+        }
+    }
+
+    void WorkerPool::WorkerLoop()
+    {
+        std::uint64_t seenGeneration = 0;
+        while(true)
+        {
+            Job job;
+            const Task *joinedTask = nullptr;
+            std::size_t count = 0;
+            {
+                std::unique_lock lock(mutex);
+                workCondition.wait(lock, [this, seenGeneration]{ return (task && taskGeneration != seenGeneration) || !jobs.empty() || !running; });
+
+                // a loop someone waits for goes before queued jobs
+                if(task && taskGeneration != seenGeneration)
+                {
+                    seenGeneration = taskGeneration;
+                    joinedTask = task;
+                    count = taskCount;
+                    ++taskWorkers;
+                }
+                else if(!jobs.empty())
+                {
+                    job = std::move(jobs.front());
+                    jobs.pop_front();
+                }
+                else
+                {
+                    return;
+                }
+            }
+
+            if(job)
+            {
+                job();
+                continue;
+            }
+
+            std::exception_ptr error;
+            try
+            {
+                RunTask(*joinedTask, count);
+            }
+            catch(...)
+            {
+                error = std::current_exception();
+            }
+
+            {
+                std::lock_guard lock(mutex);
+                if(error && !taskError)
+                    taskError = error;
+                --taskWorkers;
+            }
+            taskDoneCondition.notify_one();
+        }
+    }
+
+    WorkerPool& GetWorkerPool()
+    {
+        static WorkerPool workerPool;
+        return workerPool;
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <cstdint>
+
+namespace RIS
+{
+    // the threads of the process, shared by loading, animation and physics. queued jobs run in order,
+    // ParallelFor splits a loop over the calling thread and every worker that is idle
+    class WorkerPool
+    {
+    public:
+        using Job = std::function<void()>;
+        using Task = std::function<void(std::size_t)>;
+
+        WorkerPool(std::size_t numWorkers = 0);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+        WorkerPool(WorkerPool&&) = delete;
+        WorkerPool& operator=(WorkerPool&&) = delete;
+
+        // runs job on a worker, right away on the calling thread if there are none
+        void Enqueue(Job &&job);
+
+        // calls task for every index below count and returns when all calls are done. the calling thread
+        // takes indices too, so a loop finishes even while every worker is stuck in a long job.
+        // only one loop is spread out at a time, others (and loops inside a task) run on their calling thread.
+        // the first exception of task is rethrown on the calling thread
+        void ParallelFor(std::size_t count, const Task &task);
+
+        // runs the jobs that are still queued and stops the workers
+        void Shutdown();
+
+        std::size_t NumWorkers() const;
+
+    private:
+        void RunTask(const Task &loopTask, std::size_t count);
+        void WorkerLoop();
+
+    private:
+        std::vector<std::thread> workers;
+        std::deque<Job> jobs;
+
+        // the loop of the current ParallelFor, workers join it until it is cleared
+        std::atomic<bool> taskActive = false;
+        const Task *task = nullptr;
+        std::size_t taskCount = 0;
+        std::atomic<std::size_t> nextIndex = 0;
+        std::uint64_t taskGeneration = 0;
+        std::size_t taskWorkers = 0;
+        std::exception_ptr taskError;
+
+        std::mutex mutex;
+        std::condition_variable workCondition;
+        std::condition_variable taskDoneCondition;
+        bool running = true;
+
+    };
+
+    WorkerPool& GetWorkerPool();
+}
@@ -0,0 +1,67 @@
+#include "physics/BVH.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace RIS::Physics
+{
+    BVH::BVH(const std::vector<Item> &items)
+    {
+        if(items.empty())
+            return;
+
+        std::vector<glm::vec3> centers(items.size());
+        for(std::size_t i = 0; i < items.size(); ++i)
+            centers[i] = (items[i].bounds.min + items[i].bounds.max) * 0.5f;
+
+        indices.resize(items.size());
+        std::iota(std::begin(indices), std::end(indices), 0);
+
+        nodes.reserve(items.size() / LEAF_SIZE * 2 + 1);
+        Build(items, centers, 0, static_cast<std::uint32_t>(items.size()), 0);
+    }
+
+    std::size_t BVH::NumNodes() const
+    {
+        return nodes.size();
+    }
+
+    void BVH::Build(const std::vector<Item> &items, const std::vector<glm::vec3> &centers, std::uint32_t begin, std::uint32_t end, std::uint32_t depth)
+    {
+        std::uint32_t nodeId = static_cast<std::uint32_t>(nodes.size());
+        nodes.emplace_back();
+
+        Node node = {};
+        node.bounds = items[indices[begin]].bounds;
+        node.expansion = items[indices[begin]].expansion;
+        AABB centerBounds = { centers[indices[begin]], centers[indices[begin]] };
+        for(std::uint32_t i = begin + 1; i < end; ++i)
+        {
+            const Item &item = items[indices[i]];
+            node.bounds.min = glm::min(node.bounds.min, item.bounds.min);
+            node.bounds.max = glm::max(node.bounds.max, item.bounds.max);
+            node.expansion = glm::max(node.expansion, item.expansion);
+            centerBounds.min = glm::min(centerBounds.min, centers[indices[i]]);
+            centerBounds.max = glm::max(centerBounds.max, centers[indices[i]]);
+        }
+
+        // split at the median of the widest axis, the stack in Any needs the depth limit
+        glm::vec3 extent = centerBounds.max - centerBounds.min;
+        int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        if(end - begin <= LEAF_SIZE || depth + 2 >= MAX_DEPTH || extent[axis] <= 0.0f)
+        {
+            node.first = begin;
+            node.count = end - begin;
+            nodes[nodeId] = node;
+            return;
+        }
+
+        std::uint32_t middle = begin + (end - begin) / 2;
+        std::nth_element(std::begin(indices) + begin, std::begin(indices) + middle, std::begin(indices) + end, [&centers, axis](std::uint32_t a, std::uint32_t b){ return centers[a][axis] < centers[b][axis]; });
+
+        Build(items, centers, begin, middle, depth + 1);
+        node.right = static_cast<std::uint32_t>(nodes.size());
+        Build(items, centers, middle, end, depth + 1);
+        nodes[nodeId] = node;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+namespace RIS::Physics
+{
+    struct AABB
+    {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    // bounding volume hierarchy over brush bounds, built once when the map is loaded.
+    // radius queries grow every box by radius * expansion, the distance the corners
+    // of a brush move when all of its planes are pushed out by one unit
+    class BVH
+    {
+    public:
+        struct Item
+        {
+            AABB bounds;
+            glm::vec3 expansion;
+        };
+
+        BVH() = default;
+        BVH(const std::vector<Item> &items);
+
+        // calls test for every item whose grown bounds contain point, until test returns true
+        template<typename F>
+        bool Any(const glm::vec3 &point, float radius, F &&test) const
+        {
+            return Any(AABB{ point, point }, radius, std::forward<F>(test));
+        }
+
+        // same for every item whose grown bounds overlap box
+        template<typename F>
+        bool Any(const AABB &box, float radius, F &&test) const
+        {
+            if(nodes.empty())
+                return false;
+
+            std::uint32_t stack[MAX_DEPTH];
+            std::uint32_t stackSize = 0;
+            stack[stackSize++] = 0;
+            while(stackSize > 0)
+            {
+                const Node &node = nodes[stack[--stackSize]];
+                if(!Overlaps(node.bounds, node.expansion * radius, box))
+                    continue;
+
+                if(node.count > 0)
+                {
+                    for(std::uint32_t i = node.first; i < node.first + node.count; ++i)
+                    {
+                        if(test(indices[i]))
+                            return true;
+                    }
+                }
+                else
+                {
+                    // the left child always directly follows its parent
+                    stack[stackSize++] = static_cast<std::uint32_t>(&node - nodes.data()) + 1;
+                    stack[stackSize++] = node.right;
+                }
+            }
+            return false;
+        }
+
+        std::size_t NumNodes() const;
+
+    private:
+        struct Node
+        {
+            AABB bounds;
+            glm::vec3 expansion;
+            std::uint32_t first;    // first index of a leaf
+            std::uint32_t count;    // 0 for inner nodes
+            std::uint32_t right;    // right child of an inner node
+        };
+
+        static constexpr std::uint32_t LEAF_SIZE = 4;
+        static constexpr std::uint32_t MAX_DEPTH = 64;
+
+        static bool Overlaps(const AABB &bounds, const glm::vec3 &grow, const AABB &box)
+        {
+            return glm::all(glm::greaterThanEqual(box.max, bounds.min - grow)) && glm::all(glm::lessThanEqual(box.min, bounds.max + grow));
+        }
+
+        void Build(const std::vector<Item> &items, const std::vector<glm::vec3> &centers, std::uint32_t begin, std::uint32_t end, std::uint32_t depth);
+
+    private:
+        std::vector<Node> nodes;
+        std::vector<std::uint32_t> indices;
+
+    };
+}
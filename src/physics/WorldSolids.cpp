@@ -1,88 +1,201 @@
 #include "physics/WorldSolids.hpp"
+#include "misc/WorkerPool.hpp"
+#include "RisExcept.hpp"
+
+#include <fmt/format.h>
 
 #include <vector>
 #include <algorithm>
+#include <limits>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define RIS_PLANES_SSE
+#include <emmintrin.h>
+#endif
 
 namespace RIS::Physics
 {
-    WorldSolids::WorldSolids(std::vector<Brush> &&brushes)
-        : brushes(std::move(brushes))
-    {}
-
-    bool WorldSolids::Collides(const glm::vec3 &position) const
+    namespace
     {
-        for(const auto &brush : brushes)
+        // bounds from the corners of the brush, every corner is where three planes meet
+        BVH::Item BrushBounds(const Brush &brush)
         {
-            bool isInside = true;
-            for(const auto &plane : brush.planes)
-            {
-                float side = glm::dot(position, plane.normal) + plane.d;
-                isInside &= side < 0;
-            }
-            if(isInside)
+            constexpr float EPSILON = 0.01f;
+            constexpr float HUGE_EXTENT = 1e30f;
+
+            BVH::Item item = { { glm::vec3(HUGE_EXTENT), glm::vec3(-HUGE_EXTENT) }, glm::vec3(0.0f) };
+            const auto &planes = brush.planes;
+            for(std::size_t i = 0; i < planes.size(); ++i)
             {
-                return true;
+                for(std::size_t j = i + 1; j < planes.size(); ++j)
+                {
+                    for(std::size_t k = j + 1; k < planes.size(); ++k)
+                    {
+                        const Plane &p1 = planes[i], &p2 = planes[j], &p3 = planes[k];
+                        glm::vec3 a = glm::cross(p2.normal, p3.normal);
+                        glm::vec3 b = glm::cross(p3.normal, p1.normal);
+                        glm::vec3 c = glm::cross(p1.normal, p2.normal);
+                        float det = glm::dot(p1.normal, a);
+                        if(glm::abs(det) < 1e-6f)
+                            continue;
+
+                        glm::vec3 corner = -(p1.d * a + p2.d * b + p3.d * c) / det;
+                        bool isCorner = std::all_of(std::begin(planes), std::end(planes), [&corner](const Plane &plane){ return glm::dot(corner, plane.normal) + plane.d <= EPSILON; });
+                        if(!isCorner)
+                            continue;
+
+                        item.bounds.min = glm::min(item.bounds.min, corner);
+                        item.bounds.max = glm::max(item.bounds.max, corner);
+                        // how far the corner moves when the planes are pushed out by one unit
+                        item.expansion = glm::max(item.expansion, glm::abs((a + b + c) / det));
+                    }
+                }
             }
+
+            // open or broken brushes can't be bounded, keep them in every query
+            if(glm::any(glm::greaterThan(item.bounds.min, item.bounds.max)))
+                item = { { glm::vec3(-HUGE_EXTENT), glm::vec3(HUGE_EXTENT) }, glm::vec3(0.0f) };
+            return item;
         }
-        return false;
     }
 
-    bool WorldSolids::Collides(const glm::vec3 &position, float radius) const
+    WorldSolids::WorldSolids(std::vector<Brush> &&brushes, std::vector<std::uint32_t> &&entityFirstBrushes)
+        : brushes(std::move(brushes)), solid(this->brushes.size(), 1), entityFirstBrushes(std::move(entityFirstBrushes))
     {
-        for(const auto &brush : brushes)
+        brushBounds.reserve(this->brushes.size());
+        for(const auto &brush : this->brushes)
+            brushBounds.push_back(BrushBounds(brush));
+        bvh = BVH(brushBounds);
+
+        // every brush gets a multiple of four planes, the padding planes never reject a point
+        ranges.reserve(this->brushes.size());
+        for(const auto &brush : this->brushes)
         {
-            bool isInside = true;
-            for(const auto &plane : brush.planes)
-            {
-                glm::vec3 p = position - (plane.normal * radius);
-                float side = glm::dot(p, plane.normal) + plane.d;
-                isInside &= side < 0;
-            }
-            if(isInside)
+            std::uint32_t first = static_cast<std::uint32_t>(planes.d.size());
+            std::uint32_t count = static_cast<std::uint32_t>((brush.planes.size() + 3) & ~std::size_t(3));
+            for(std::uint32_t i = 0; i < count; ++i)
             {
-                return true;
+                bool isPadding = i >= brush.planes.size();
+                glm::vec3 normal = isPadding ? glm::vec3(0.0f) : brush.planes[i].normal;
+                planes.nx.push_back(normal.x);
+                planes.ny.push_back(normal.y);
+                planes.nz.push_back(normal.z);
+                planes.d.push_back(isPadding ? -1.0f : brush.planes[i].d);
             }
+            ranges.push_back({ first, count });
         }
-        return false;
+    }
+
+    // same arithmetic as glm::dot(position - normal * radius, normal) + d so both paths agree exactly
+    bool WorldSolids::IsInside(std::uint32_t id, const glm::vec3 &position, float radius) const
+    {
+        if(!solid[id])
+            return false;
+
+        const PlaneRange &range = ranges[id];
+        const float *nx = planes.nx.data() + range.first;
+        const float *ny = planes.ny.data() + range.first;
+        const float *nz = planes.nz.data() + range.first;
+        const float *d = planes.d.data() + range.first;
+
+#ifdef RIS_PLANES_SSE
+        const __m128 px = _mm_set1_ps(position.x);
+        const __m128 py = _mm_set1_ps(position.y);
+        const __m128 pz = _mm_set1_ps(position.z);
+        const __m128 r = _mm_set1_ps(radius);
+        for(std::uint32_t i = 0; i < range.count; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(nx + i);
+            __m128 y = _mm_loadu_ps(ny + i);
+            __m128 z = _mm_loadu_ps(nz + i);
+            __m128 side = _mm_mul_ps(_mm_sub_ps(px, _mm_mul_ps(x, r)), x);
+            side = _mm_add_ps(side, _mm_mul_ps(_mm_sub_ps(py, _mm_mul_ps(y, r)), y));
+            side = _mm_add_ps(side, _mm_mul_ps(_mm_sub_ps(pz, _mm_mul_ps(z, r)), z));
+            side = _mm_add_ps(side, _mm_loadu_ps(d + i));
+            // outside of any of the four planes
+            if(_mm_movemask_ps(_mm_cmplt_ps(side, _mm_setzero_ps())) != 0xF)
+                return false;
+        }
+        return true;
+#else
+        return IsInsideScalar(id, position, radius);
+#endif
+    }
+
+    bool WorldSolids::IsInsideScalar(std::uint32_t id, const glm::vec3 &position, float radius) const
+    {
+        if(!solid[id])
+            return false;
+
+        const PlaneRange &range = ranges[id];
+        for(std::uint32_t i = range.first; i < range.first + range.count; ++i)
+        {
+            float side = (position.x - planes.nx[i] * radius) * planes.nx[i];
+            side += (position.y - planes.ny[i] * radius) * planes.ny[i];
+            side += (position.z - planes.nz[i] * radius) * planes.nz[i];
+            side += planes.d[i];
+            if(!(side < 0))
+                return false;
+        }
+        return true;
+    }
+
+    // the first colliding brush in map order, like a linear search would find
+    const Brush* WorldSolids::FindFirst(const glm::vec3 &position, float radius) const
+    {
+        std::uint32_t first = UINT32_MAX;
+        bvh.Any(position, radius, [&](std::uint32_t id)
+        {
+            if(id < first && IsInside(id, position, radius))
+                first = id;
+            return false;
+        });
+        return first == UINT32_MAX ? nullptr : &brushes[first];
+    }
+
+    bool WorldSolids::Collides(const glm::vec3 &position) const
+    {
+        return bvh.Any(position, 0.0f, [&](std::uint32_t id){ return IsInside(id, position, 0.0f); });
+    }
+
+    bool WorldSolids::Collides(const glm::vec3 &position, float radius) const
+    {
+        return bvh.Any(position, radius, [&](std::uint32_t id){ return IsInside(id, position, radius); });
     }
 
     bool WorldSolids::Collides(const glm::vec3 &oldPosition, const glm::vec3 &newPosition, glm::vec3 &adjustedPos) const
     {
         glm::vec3 lineDir = (newPosition - oldPosition);
 
-        for(const auto &brush : brushes)
+        if(const Brush *found = FindFirst(newPosition, 0.0f))
         {
-            bool isInside = true;
+            const Brush &brush = *found;
+
+            //check which planes we crossed, keep the crossing closest to the old position
+            float closest = std::numeric_limits<float>::max();
             for(const auto &plane : brush.planes)
             {
-                float side = glm::dot(newPosition, plane.normal) + plane.d;
-                isInside &= side < 0;
-            }
-            if(isInside)
-            {
-                //check which planes we crossed
-                std::vector<glm::vec3> adjPoses;
-                for(const auto &plane : brush.planes)
+                float newSide = glm::dot(newPosition, plane.normal) + plane.d;
+                float oldSide = glm::dot(oldPosition, plane.normal) + plane.d;
+                if(newSide * oldSide < 0)
                 {
-                    float newSide = glm::dot(newPosition, plane.normal) + plane.d;
-                    float oldSide = glm::dot(oldPosition, plane.normal) + plane.d;
-                    if(newSide * oldSide < 0)
+                    //float t = (plane.d - glm::dot(plane.normal, oldPosition)) / glm::dot(plane.normal, lineDir);
+                    float t = (-(glm::dot(plane.normal, oldPosition) + plane.d)) / glm::dot(plane.normal, lineDir);
+                    if(t <= 1.0f && t >= 0.0f)
                     {
-                        //float t = (plane.d - glm::dot(plane.normal, oldPosition)) / glm::dot(plane.normal, lineDir);
-                        float t = (-(glm::dot(plane.normal, oldPosition) + plane.d)) / glm::dot(plane.normal, lineDir);
-                        if(t <= 1.0f && t >= 0.0f)
+                        glm::vec3 newPos = oldPosition + (lineDir * t);
+                        float distance = glm::distance(newPos, oldPosition);
+                        if(distance < closest)
                         {
-                            adjPoses.push_back(oldPosition + (lineDir * t));
+                            closest = distance;
+                            adjustedPos = newPos;
                         }
                     }
                 }
-
-                auto minElement = std::min_element(std::begin(adjPoses), std::end(adjPoses), [oldPosition](const auto &first, const auto &smallest) { return glm::distance(first, oldPosition) < glm::distance(smallest, oldPosition); });
-                if(minElement != std::end(adjPoses))
-                    adjustedPos = *minElement;
-
-                return true;
             }
+
+            return true;
         }
         return false;
     }
@@ -91,46 +204,352 @@ namespace RIS::Physics
     {
         glm::vec3 lineDir = (newPosition - oldPosition);
 
-        for(const auto &brush : brushes)
+        if(const Brush *found = FindFirst(newPosition, radius))
         {
-            bool isInside = true;
+            const Brush &brush = *found;
+
+            //check which planes we crossed, keep the crossing closest to the old position
+            float closest = std::numeric_limits<float>::max();
             for(const auto &plane : brush.planes)
             {
                 glm::vec3 np = newPosition - (plane.normal * radius);
-                float side = glm::dot(np, plane.normal) + plane.d;
-                isInside &= side < 0;
+                glm::vec3 op = oldPosition - (plane.normal * radius);
+                
+                float newSide = glm::dot(np, plane.normal) + plane.d;
+                float oldSide = glm::dot(op, plane.normal) + plane.d;
+
+                if(newSide * oldSide < 0)
+                {
+                    float t = (-(glm::dot(plane.normal, op) + plane.d)) / glm::dot(plane.normal, lineDir);
+                    if(t <= 1.0f && t >= 0.0f)
+                    {
+                        glm::vec3 newPos = op + (lineDir * t);
+                        newPos += plane.normal * radius;
+                        float distance = glm::distance(newPos, oldPosition);
+                        if(distance < closest)
+                        {
+                            closest = distance;
+                            adjustedPos = newPos;
+                        }
+                    }
+                }
             }
-            if(isInside)
+
+            return true;
+        }
+        return false;
+    }
+
+    namespace
+    {
+        // queries close to each other walk the bvh together
+        constexpr std::size_t SPHERE_GROUP_SIZE = 16;
+        // below this a batch isn't worth the threads
+        constexpr std::size_t PARALLEL_BATCH_SIZE = 4096;
+
+        std::uint32_t SpreadBits(std::uint32_t v)
+        {
+            v = (v | (v << 16)) & 0x030000FF;
+            v = (v | (v << 8)) & 0x0300F00F;
+            v = (v | (v << 4)) & 0x030C30C3;
+            v = (v | (v << 2)) & 0x09249249;
+            return v;
+        }
+
+        std::uint32_t MortonCode(const glm::vec3 &position, const AABB &bounds)
+        {
+            glm::vec3 extent = glm::max(bounds.max - bounds.min, glm::vec3(1e-6f));
+            glm::uvec3 cell(glm::clamp((position - bounds.min) / extent * 1023.0f, glm::vec3(0.0f), glm::vec3(1023.0f)));
+            return SpreadBits(cell.x) | (SpreadBits(cell.y) << 1) | (SpreadBits(cell.z) << 2);
+        }
+    }
+
+    void WorldSolids::CollideSpheres(gsl::span<const Sphere> spheres, gsl::span<SphereHit> results) const
+    {
+        if(results.size() < spheres.size())
+            throw RISException(fmt::format("CollideSpheres needs room for {} results, got {}", spheres.size(), results.size()));
+        if(spheres.empty())
+            return;
+
+        AABB bounds = { spheres[0].center, spheres[0].center };
+        for(const auto &sphere : spheres)
+        {
+            bounds.min = glm::min(bounds.min, sphere.center);
+            bounds.max = glm::max(bounds.max, sphere.center);
+        }
+
+        std::vector<std::uint64_t> keys(spheres.size());
+        for(std::size_t i = 0; i < spheres.size(); ++i)
+            keys[i] = (static_cast<std::uint64_t>(MortonCode(spheres[i].center, bounds)) << 32) | i;
+        std::sort(std::begin(keys), std::end(keys));
+
+        std::vector<std::uint32_t> order(spheres.size());
+        for(std::size_t i = 0; i < keys.size(); ++i)
+            order[i] = static_cast<std::uint32_t>(keys[i]);
+
+        // a few chunks per thread, so a worker that is busy with a load doesn't hold up the rest
+        auto &pool = GetWorkerPool();
+        std::size_t numChunks = 1;
+        if(spheres.size() >= PARALLEL_BATCH_SIZE)
+            numChunks = std::clamp<std::size_t>((pool.NumWorkers() + 1) * 4, 1, spheres.size() / (PARALLEL_BATCH_SIZE / 4));
+
+        // every chunk is a contiguous piece of the sorted queries, the calling thread takes chunks too
+        gsl::span<const std::uint32_t> orderSpan(order);
+        std::size_t chunkSize = (order.size() + numChunks - 1) / numChunks;
+        pool.ParallelFor(numChunks, [&](std::size_t chunk)
+        {
+            std::size_t begin = chunk * chunkSize;
+            if(begin < order.size())
+                CollideSphereRange(spheres, orderSpan.subspan(begin, std::min(chunkSize, order.size() - begin)), results);
+        });
+    }
+
+    void WorldSolids::CollideSphereRange(gsl::span<const Sphere> spheres, gsl::span<const std::uint32_t> order, gsl::span<SphereHit> results) const
+    {
+        std::vector<std::uint32_t> candidates;
+        for(std::size_t groupStart = 0; groupStart < order.size(); groupStart += SPHERE_GROUP_SIZE)
+        {
+            auto group = order.subspan(groupStart, std::min(SPHERE_GROUP_SIZE, order.size() - groupStart));
+
+            // one walk for the whole group, the centers are grown by the largest radius
+            AABB groupBounds = { spheres[group[0]].center, spheres[group[0]].center };
+            float maxRadius = 0.0f;
+            for(std::uint32_t id : group)
             {
-                //check which planes we crossed
-                std::vector<glm::vec3> adjPoses;
-                for(const auto &plane : brush.planes)
+                groupBounds.min = glm::min(groupBounds.min, spheres[id].center);
+                groupBounds.max = glm::max(groupBounds.max, spheres[id].center);
+                maxRadius = std::max(maxRadius, spheres[id].radius);
+            }
+
+            candidates.clear();
+            bvh.Any(groupBounds, maxRadius, [&candidates](std::uint32_t brush)
+            {
+                candidates.push_back(brush);
+                return false;
+            });
+
+            for(std::uint32_t id : group)
+            {
+                const Sphere &sphere = spheres[id];
+                SphereHit hit;
+                for(std::uint32_t brush : candidates)
                 {
-                    glm::vec3 np = newPosition - (plane.normal * radius);
-                    glm::vec3 op = oldPosition - (plane.normal * radius);
-                    
-                    float newSide = glm::dot(np, plane.normal) + plane.d;
-                    float oldSide = glm::dot(op, plane.normal) + plane.d;
+                    const BVH::Item &item = brushBounds[brush];
+                    glm::vec3 grow = item.expansion * sphere.radius;
+                    if(glm::any(glm::lessThan(sphere.center, item.bounds.min - grow)) || glm::any(glm::greaterThan(sphere.center, item.bounds.max + grow)))
+                        continue;
 
-                    if(newSide * oldSide < 0)
+                    if(IsInside(brush, sphere.center, sphere.radius))
                     {
-                        float t = (-(glm::dot(plane.normal, op) + plane.d)) / glm::dot(plane.normal, lineDir);
-                        if(t <= 1.0f && t >= 0.0f)
-                        {
-                            glm::vec3 newPos = op + (lineDir * t);
-                            newPos += plane.normal * radius;
-                            adjPoses.push_back(newPos);
-                        }
+                        hit.collides = true;
+                        hit.brush = brush;
+                        break;
                     }
                 }
+                results[id] = hit;
+            }
+        }
+    }
+
+    // keeps swept spheres a little away from the planes they hit so the next sweep doesn't start inside
+    constexpr float SWEEP_EPSILON = 1.0f / 32.0f;
+
+    // clips the segment against the planes of one brush pushed out by radius
+    void WorldSolids::SweepBrush(std::uint32_t id, const glm::vec3 &start, const glm::vec3 &end, float radius, SweepResult &result) const
+    {
+        if(!solid[id])
+            return;
+
+        const PlaneRange &range = ranges[id];
+        const std::uint32_t numPlanes = static_cast<std::uint32_t>(brushes[id].planes.size());
+
+        float enter = -1.0f;
+        float exit = 1.0f;
+        std::uint32_t enterPlane = UINT32_MAX;
+        bool startsOutside = false;
+        bool endsOutside = false;
+        for(std::uint32_t i = 0; i < numPlanes; ++i)
+        {
+            std::uint32_t p = range.first + i;
+            glm::vec3 normal(planes.nx[p], planes.ny[p], planes.nz[p]);
+            float offset = planes.d[p] - radius * glm::dot(normal, normal);
+            float startSide = glm::dot(start, normal) + offset;
+            float endSide = glm::dot(end, normal) + offset;
 
-                auto minElement = std::min_element(std::begin(adjPoses), std::end(adjPoses), [oldPosition](const auto &first, const auto &smallest) { return glm::distance(first, oldPosition) < glm::distance(smallest, oldPosition); });
-                if(minElement != std::end(adjPoses))
-                    adjustedPos = *minElement;
+            if(startSide > 0)
+                startsOutside = true;
+            if(endSide > 0)
+                endsOutside = true;
+            // completely in front of this plane, the segment misses the brush
+            if(startSide > 0 && endSide >= startSide)
+                return;
+            // completely behind, this plane doesn't clip
+            if(startSide <= 0 && endSide <= 0)
+                continue;
 
-                return true;
+            if(startSide > endSide)
+            {
+                float f = (startSide - SWEEP_EPSILON) / (startSide - endSide);
+                if(f > enter)
+                {
+                    enter = f;
+                    enterPlane = i;
+                }
+            }
+            else
+            {
+                float f = (startSide + SWEEP_EPSILON) / (startSide - endSide);
+                exit = std::min(exit, f);
             }
         }
-        return false;
+
+        // like quake a sweep that starts inside may still leave the brush, only one that stays inside is blocked
+        if(!startsOutside)
+        {
+            result.startSolid = true;
+            if(!endsOutside)
+            {
+                result.hit = true;
+                result.allSolid = true;
+                result.fraction = 0.0f;
+            }
+            return;
+        }
+
+        if(enterPlane != UINT32_MAX && enter < exit && enter < result.fraction)
+        {
+            result.hit = true;
+            result.fraction = std::max(enter, 0.0f);
+            result.plane = brushes[id].planes[enterPlane];
+            result.normal = result.plane.normal;
+        }
+    }
+
+    SweepResult WorldSolids::SweepSphere(const glm::vec3 &start, const glm::vec3 &end, float radius) const
+    {
+        SweepResult result;
+        result.position = end;
+
+        AABB sweepBounds = { glm::min(start, end), glm::max(start, end) };
+        bvh.Any(sweepBounds, radius, [&](std::uint32_t id)
+        {
+            SweepBrush(id, start, end, radius, result);
+            return result.allSolid;
+        });
+
+        if(result.hit)
+            result.position = start + (end - start) * result.fraction;
+        return result;
+    }
+
+    // moves a sphere that is inside a brush out through the plane of the brush that is closest
+    bool WorldSolids::PushOut(glm::vec3 &position, float radius) const
+    {
+        const Brush *brush = FindFirst(position, radius);
+        if(!brush || brush->planes.empty())
+            return false;
+
+        const Plane *closest = nullptr;
+        float closestSide = -std::numeric_limits<float>::max();
+        for(const auto &plane : brush->planes)
+        {
+            float side = glm::dot(position - plane.normal * radius, plane.normal) + plane.d;
+            if(side > closestSide)
+            {
+                closestSide = side;
+                closest = &plane;
+            }
+        }
+        position += closest->normal * (SWEEP_EPSILON - closestSide);
+        return true;
+    }
+
+    glm::vec3 WorldSolids::SlideMove(const glm::vec3 &start, const glm::vec3 &movement, float radius, int maxIterations) const
+    {
+        constexpr int MAX_CLIP_PLANES = 5;
+        glm::vec3 clipPlanes[MAX_CLIP_PLANES];
+        int numClipPlanes = 0;
+
+        glm::vec3 position = start;
+        glm::vec3 remaining = movement;
+        for(int iteration = 0; iteration < maxIterations; ++iteration)
+        {
+            if(glm::dot(remaining, remaining) < 1e-8f)
+                break;
+
+            SweepResult sweep = SweepSphere(position, position + remaining, radius);
+            // the move can't get out of a brush the sphere is stuck in, get out of it first and move from there
+            if(sweep.allSolid)
+            {
+                if(!PushOut(position, radius))
+                    return position;
+                continue;
+            }
+
+            position = sweep.position;
+            if(!sweep.hit)
+                break;
+
+            remaining *= 1.0f - sweep.fraction;
+            if(numClipPlanes == MAX_CLIP_PLANES)
+                return position;
+            clipPlanes[numClipPlanes++] = sweep.normal;
+
+            // find a plane to slide along that doesn't push us into any of the others
+            bool found = false;
+            for(int i = 0; i < numClipPlanes && !found; ++i)
+            {
+                glm::vec3 clipped = remaining - clipPlanes[i] * glm::dot(remaining, clipPlanes[i]);
+                found = true;
+                for(int j = 0; j < numClipPlanes; ++j)
+                {
+                    if(j != i && glm::dot(clipped, clipPlanes[j]) < 0)
+                    {
+                        found = false;
+                        break;
+                    }
+                }
+                if(found)
+                    remaining = clipped;
+            }
+
+            if(!found)
+            {
+                // stuck in a corner of two planes, move along the crease
+                if(numClipPlanes != 2)
+                    return position;
+                glm::vec3 crease = glm::cross(clipPlanes[0], clipPlanes[1]);
+                float length = glm::length(crease);
+                if(length < 1e-6f)
+                    return position;
+                crease /= length;
+                remaining = crease * glm::dot(crease, remaining);
+            }
+
+            // never slide back against the original movement
+            if(glm::dot(remaining, movement) <= 0)
+                break;
+        }
+        return position;
+    }
+
+    const std::vector<Brush>& WorldSolids::GetBrushes() const
+    {
+        return brushes;
+    }
+
+    std::uint32_t WorldSolids::EntityFirstBrush(std::size_t entity) const
+    {
+        return entity < entityFirstBrushes.size() ? entityFirstBrushes[entity] : UINT32_MAX;
+    }
+
+    void WorldSolids::SetSolid(std::uint32_t id, bool solid)
+    {
+        this->solid.at(id) = solid ? 1 : 0;
+    }
+
+    bool WorldSolids::IsSolid(std::uint32_t id) const
+    {
+        return solid.at(id) != 0;
     }
 }
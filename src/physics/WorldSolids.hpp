@@ -2,26 +2,106 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
+
+#include <gsl/span>
 
 #include "physics/Brush.hpp"
+#include "physics/BVH.hpp"
 
 namespace RIS::Physics
 {
+    // result of sweeping a sphere through the world
+    struct SweepResult
+    {
+        bool hit = false;
+        bool startSolid = false;    // the sphere already overlapped a brush at the start
+        bool allSolid = false;      // it overlapped the brush for the whole sweep, fraction is 0
+        float fraction = 1.0f;      // time of impact along the sweep, 1 if nothing was hit
+        glm::vec3 position;         // center of the sphere at the time of impact
+        glm::vec3 normal;           // contact normal, points away from the brush
+        Plane plane;                // the brush plane that was hit
+    };
+
+    struct Sphere
+    {
+        glm::vec3 center;
+        float radius;
+    };
+
+    struct SphereHit
+    {
+        bool collides = false;
+        std::uint32_t brush = UINT32_MAX;   // one of the brushes the sphere is in
+    };
+
     class WorldSolids
     {
     public:
         using Ptr = std::shared_ptr<WorldSolids>;
 
     public:
-        WorldSolids(std::vector<Brush> &&brushes);
+        // entityFirstBrushes has the first brush of every map entity whose brushes were appended behind the world brushes
+        WorldSolids(std::vector<Brush> &&brushes, std::vector<std::uint32_t> &&entityFirstBrushes = {});
 
         bool Collides(const glm::vec3 &position) const;
         bool Collides(const glm::vec3 &position, float radius) const;
         bool Collides(const glm::vec3 &oldPosition, const glm::vec3 &newPosition, glm::vec3 &adjustedPos) const;
         bool Collides(const glm::vec3 &oldPosition, const glm::vec3 &newPosition, float radius, glm::vec3 &adjustedPos) const;
 
+        // answers many sphere queries at once, results has to be at least as large as spheres.
+        // queries are sorted spatially and neighbouring ones share a walk through the bvh,
+        // large batches are split across threads
+        void CollideSpheres(gsl::span<const Sphere> spheres, gsl::span<SphereHit> results) const;
+
+        SweepResult SweepSphere(const glm::vec3 &start, const glm::vec3 &end, float radius) const;
+        // moves a sphere by movement and slides it along everything it touches on the way.
+        // a sphere that starts inside a brush may move out of it, one that can't is pushed out through the closest plane
+        glm::vec3 SlideMove(const glm::vec3 &start, const glm::vec3 &movement, float radius, int maxIterations = 4) const;
+
+        const std::vector<Brush>& GetBrushes() const;
+        // the brushes of map entity i are EntityFirstBrush(i) to EntityFirstBrush(i) + its Brushes().size(),
+        // UINT32_MAX if the world solids weren't loaded with the entities
+        std::uint32_t EntityFirstBrush(std::size_t entity) const;
+
+        // brushes that aren't solid are skipped by every query, e.g. an open door or a trigger
+        void SetSolid(std::uint32_t id, bool solid);
+        bool IsSolid(std::uint32_t id) const;
+
+        // sphere against the planes of one brush, four planes at a time where simd is available
+        bool IsInside(std::uint32_t id, const glm::vec3 &position, float radius) const;
+        // plane by plane test without simd, gives the same results as the vectorized one
+        bool IsInsideScalar(std::uint32_t id, const glm::vec3 &position, float radius) const;
+
     private:
+        void CollideSphereRange(gsl::span<const Sphere> spheres, gsl::span<const std::uint32_t> order, gsl::span<SphereHit> results) const;
+        void SweepBrush(std::uint32_t id, const glm::vec3 &start, const glm::vec3 &end, float radius, SweepResult &result) const;
+        const Brush* FindFirst(const glm::vec3 &position, float radius) const;
+        bool PushOut(glm::vec3 &position, float radius) const;
+
+    private:
+        // the planes of all brushes packed for simd, each brush is padded to a multiple of four
+        struct PackedPlanes
+        {
+            std::vector<float> nx;
+            std::vector<float> ny;
+            std::vector<float> nz;
+            std::vector<float> d;
+        };
+
+        struct PlaneRange
+        {
+            std::uint32_t first;
+            std::uint32_t count;
+        };
+
         std::vector<Brush> brushes;
+        std::vector<BVH::Item> brushBounds;
+        BVH bvh;
+        PackedPlanes planes;
+        std::vector<PlaneRange> ranges;
+        std::vector<std::uint8_t> solid;
+        std::vector<std::uint32_t> entityFirstBrushes;
 
     };
 }
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <string>
+#include <atomic>
+#include <cstdio>
+
+// minimal checks for the test programs, a test returns Result() from main
+namespace RIS::Test
+{
+    inline std::atomic<int>& Failures()
+    {
+        static std::atomic<int> failures = 0;
+        return failures;
+    }
+
+    inline bool Check(bool condition, const std::string &message)
+    {
+        if(!condition)
+        {
+            ++Failures();
+            std::fprintf(stderr, "FAILED: %s\n", message.c_str());
+        }
+        return condition;
+    }
+
+    inline int Result(const std::string &name)
+    {
+        int failures = Failures();
+        if(failures > 0)
+            std::fprintf(stderr, "%s: %d checks failed\n", name.c_str(), failures);
+        else
+            std::printf("%s: passed\n", name.c_str());
+        return failures > 0 ? 1 : 0;
+    }
+}
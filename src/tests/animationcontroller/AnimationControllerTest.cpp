@@ -0,0 +1,232 @@
+#include "graphics/AnimationController.hpp"
+#include "tests/Test.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <fmt/format.h>
+
+#include <vector>
+#include <string>
+#include <numeric>
+#include <cmath>
+
+// blend space weights, fades that finish or run out of slots and masked layers of the animation controller
+
+using namespace RIS;
+using namespace RIS::Graphics;
+using namespace RIS::Graphics::Animation;
+
+namespace
+{
+    constexpr std::size_t NUM_JOINTS = 6;
+    constexpr float TOLERANCE = 1e-5f;
+
+    Skeleton::Ptr MakeSkeleton()
+    {
+        Pose rest(NUM_JOINTS);
+        for(std::size_t i = 0; i < NUM_JOINTS; ++i)
+        {
+            rest.SetParent(i, static_cast<int>(i) - 1);
+            rest.SetLocalTransform(i, Transform(glm::vec3(0.0f, 1.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f)));
+        }
+        Pose bind = rest;
+        return std::make_shared<Skeleton>(std::move(rest), std::move(bind), std::vector<std::string>(NUM_JOINTS));
+    }
+
+    // every clip moves and turns every joint its own way, over one second
+    Clip MakeClip(float seed)
+    {
+        Clip clip;
+        clip.SetName(fmt::format("clip {}", seed));
+        for(std::size_t joint = 0; joint < NUM_JOINTS; ++joint)
+        {
+            float j = static_cast<float>(joint);
+            auto &position = clip[joint].GetPositionTrack();
+            position.SetInterpolation(Interpolation::LINEAR);
+            position.Resize(2);
+            auto &rotation = clip[joint].GetRotationTrack();
+            rotation.SetInterpolation(Interpolation::LINEAR);
+            rotation.Resize(2);
+            for(std::size_t k = 0; k < 2; ++k)
+            {
+                float t = static_cast<float>(k);
+                glm::quat q = glm::normalize(glm::quat(1.0f, 0.1f * seed * (t + 1.0f), 0.05f * j, 0.2f * seed - 0.1f * t));
+                position[k].time = t;
+                position[k].value = { seed + j, seed * t, j * t - seed };
+                rotation[k].time = t;
+                rotation[k].value = { q.x, q.y, q.z, q.w };
+            }
+        }
+        clip.RecalculateDuration();
+        return clip;
+    }
+
+    Animation::Animation::Ptr MakeAnimation(std::size_t numClips)
+    {
+        std::vector<FastClip> clips;
+        for(std::size_t i = 0; i < numClips; ++i)
+            clips.push_back(OptimizeClip(MakeClip(static_cast<float>(i + 1))));
+        return std::make_shared<Animation::Animation>(std::move(clips));
+    }
+
+    bool Near(const Transform &a, const Transform &b)
+    {
+        return glm::length(a.position - b.position) <= TOLERANCE && std::abs(glm::dot(a.rotation, b.rotation)) >= 1.0f - TOLERANCE
+            && glm::length(a.scale - b.scale) <= TOLERANCE;
+    }
+
+    // the rest pose with clip sampled at time, what the controller has to show for a single motion
+    Pose Expected(const Skeleton &skeleton, const Animation::Animation &animation, std::size_t clip, float time)
+    {
+        Pose pose = skeleton.GetRestPose();
+        animation.GetByIndex(clip).Sample(pose, time);
+        return pose;
+    }
+
+    void CheckPose(const Pose &expected, const SoAPose &actual, const std::string &what)
+    {
+        for(std::size_t i = 0; i < expected.Size(); ++i)
+            Test::Check(Near(expected.GetLocalTransform(i), actual.GetLocalTransform(i)), fmt::format("{}: joint {} differs", what, i));
+    }
+
+    void CheckWeights(const BlendSpace &space, const glm::vec2 &parameters, const std::vector<float> &expected, const std::string &what)
+    {
+        std::vector<float> weights(space.Size(), -1.0f);
+        space.GetWeights(parameters, weights.data());
+
+        float sum = std::accumulate(std::begin(weights), std::end(weights), 0.0f);
+        Test::Check(std::abs(sum - 1.0f) <= TOLERANCE, fmt::format("{}: weights sum up to {}", what, sum));
+        for(std::size_t i = 0; i < weights.size(); ++i)
+        {
+            Test::Check(weights[i] >= 0.0f && weights[i] <= 1.0f, fmt::format("{}: weight {} is {}", what, i, weights[i]));
+            if(!expected.empty())
+                Test::Check(std::abs(weights[i] - expected[i]) <= TOLERANCE, fmt::format("{}: weight {} is {} instead of {}", what, i, weights[i], expected[i]));
+        }
+    }
+
+    void TestBlendSpaceWeights()
+    {
+        // not sorted by position on purpose
+        BlendSpace line;
+        line.Add(0, 1.0f);
+        line.Add(1, -1.0f);
+        line.Add(2, 3.0f);
+        CheckWeights(line, glm::vec2(0.0f, 0.0f), { 0.5f, 0.5f, 0.0f }, "1D between two entries");
+        CheckWeights(line, glm::vec2(2.5f, 7.0f), { 0.25f, 0.0f, 0.75f }, "1D ignores y");
+        CheckWeights(line, glm::vec2(1.0f, 0.0f), { 1.0f, 0.0f, 0.0f }, "1D on an entry");
+        CheckWeights(line, glm::vec2(-5.0f, 0.0f), { 0.0f, 1.0f, 0.0f }, "1D below the range");
+        CheckWeights(line, glm::vec2(10.0f, 0.0f), { 0.0f, 0.0f, 1.0f }, "1D above the range");
+
+        BlendSpace square;
+        square.Add(0, -1.0f, -1.0f);
+        square.Add(1, 1.0f, -1.0f);
+        square.Add(2, -1.0f, 1.0f);
+        square.Add(3, 1.0f, 1.0f);
+        CheckWeights(square, glm::vec2(0.0f, 0.0f), { 0.25f, 0.25f, 0.25f, 0.25f }, "2D in the middle");
+        CheckWeights(square, glm::vec2(1.0f, -1.0f), { 0.0f, 1.0f, 0.0f, 0.0f }, "2D on an entry");
+        CheckWeights(square, glm::vec2(0.3f, -0.6f), {}, "2D inside");
+        CheckWeights(square, glm::vec2(40.0f, 25.0f), {}, "2D outside the range");
+
+        // outside of the range the closest entry weighs the most
+        std::vector<float> weights(square.Size());
+        square.GetWeights(glm::vec2(40.0f, 25.0f), weights.data());
+        Test::Check(weights[3] > weights[0] && weights[3] > weights[1] && weights[3] > weights[2], "2D outside the range: the closest entry weighs the most");
+    }
+
+    // once a fade is over the old motion is gone and only the new clip is left
+    void TestFadeRetirement()
+    {
+        auto skeleton = MakeSkeleton();
+        auto animation = MakeAnimation(2);
+        AnimationController controller(skeleton, animation);
+
+        controller.Play(std::size_t(0));
+        controller.Update(0.2f);
+        CheckPose(Expected(*skeleton, *animation, 0, 0.2f), controller.GetPose(), "first clip");
+
+        controller.Play(std::size_t(1), 0.5f);
+        controller.Update(0.25f);
+        Pose halfway = Expected(*skeleton, *animation, 0, 0.45f);
+        Blend(halfway, halfway, Expected(*skeleton, *animation, 1, 0.25f), 0.5f);
+        CheckPose(halfway, controller.GetPose(), "halfway through the fade");
+
+        controller.Update(0.3f);
+        CheckPose(Expected(*skeleton, *animation, 1, 0.55f), controller.GetPose(), "finished fade");
+        controller.Update(0.1f);
+        CheckPose(Expected(*skeleton, *animation, 1, 0.65f), controller.GetPose(), "after the fade");
+    }
+
+    // more fades at once than there are slots cut off the oldest motion, what is left finishes normally
+    void TestFadeOverflow()
+    {
+        auto skeleton = MakeSkeleton();
+        auto animation = MakeAnimation(7);
+
+        // the same fades, only the first clip differs. it is cut off so both end up with the same pose
+        AnimationController a(skeleton, animation), b(skeleton, animation);
+        a.Play(std::size_t(0));
+        b.Play(std::size_t(6));
+        for(std::size_t clip = 1; clip <= 5; ++clip)
+        {
+            a.Update(0.05f);
+            b.Update(0.05f);
+            a.Play(clip, 10.0f);
+            b.Play(clip, 10.0f);
+        }
+        a.Update(0.05f);
+        b.Update(0.05f);
+        for(std::size_t i = 0; i < NUM_JOINTS; ++i)
+            Test::Check(Near(a.GetPose().GetLocalTransform(i), b.GetPose().GetLocalTransform(i)), fmt::format("overflowing fades: joint {} still depends on the cut off motion", i));
+
+        a.Update(10.0f);
+        CheckPose(Expected(*skeleton, *animation, 5, 10.05f), a.GetPose(), "overflowing fades after the last one finished");
+    }
+
+    // joints outside of the mask of a layer keep the pose under the layer
+    void TestMaskedLayers()
+    {
+        auto skeleton = MakeSkeleton();
+        auto animation = MakeAnimation(3);
+
+        BoneMask mask(NUM_JOINTS);
+        mask.Set(2, 1.0f);
+        mask.Set(3, 0.5f);
+
+        for(auto mode : { AnimationController::LayerMode::OVERRIDE, AnimationController::LayerMode::ADDITIVE })
+        {
+            std::string what = mode == AnimationController::LayerMode::OVERRIDE ? "override layer" : "additive layer";
+            AnimationController controller(skeleton, animation);
+            controller.Play(std::size_t(0));
+            controller.AddLayer(mode == AnimationController::LayerMode::OVERRIDE ? 1 : 2, mode, BoneMask(mask));
+            controller.Update(0.4f);
+
+            Pose base = Expected(*skeleton, *animation, 0, 0.4f);
+            for(std::size_t i = 0; i < NUM_JOINTS; ++i)
+            {
+                bool same = Near(base.GetLocalTransform(i), controller.GetPose().GetLocalTransform(i));
+                if(mask.Includes(i))
+                    Test::Check(!same, fmt::format("{}: joint {} in the mask isn't changed", what, i));
+                else
+                    Test::Check(same, fmt::format("{}: joint {} outside of the mask is changed", what, i));
+            }
+
+            if(mode == AnimationController::LayerMode::OVERRIDE)
+            {
+                Pose expected = base;
+                Blend(expected, base, Expected(*skeleton, *animation, 1, 0.4f), 1.0f, &mask);
+                CheckPose(expected, controller.GetPose(), what);
+            }
+        }
+    }
+}
+
+int main()
+{
+    TestBlendSpaceWeights();
+    TestFadeRetirement();
+    TestFadeOverflow();
+    TestMaskedLayers();
+
+    return Test::Result("AnimationController");
+}
@@ -0,0 +1,165 @@
+#include "graphics/AnimationSystem.hpp"
+#include "RisExcept.hpp"
+#include "tests/Test.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <fmt/format.h>
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+// every instance of the animation system has to find its own palette at its offset, also after
+// ids were removed and handed out again to controllers with a different number of joints
+
+using namespace RIS;
+using namespace RIS::Graphics;
+using namespace RIS::Graphics::Animation;
+
+namespace
+{
+    constexpr float TOLERANCE = 1e-5f;
+
+    // a chain of joints with one clip that moves and turns all of them, different for every seed
+    AnimationController::Ptr MakeController(std::size_t numJoints, float seed)
+    {
+        Pose rest(numJoints);
+        Clip clip;
+        for(std::size_t joint = 0; joint < numJoints; ++joint)
+        {
+            float j = static_cast<float>(joint);
+            rest.SetParent(joint, static_cast<int>(joint) - 1);
+            rest.SetLocalTransform(joint, Transform(glm::vec3(0.0f, 1.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f)));
+
+            auto &position = clip[joint].GetPositionTrack();
+            position.SetInterpolation(Interpolation::LINEAR);
+            position.Resize(2);
+            auto &rotation = clip[joint].GetRotationTrack();
+            rotation.SetInterpolation(Interpolation::LINEAR);
+            rotation.Resize(2);
+            for(std::size_t k = 0; k < 2; ++k)
+            {
+                float t = static_cast<float>(k);
+                glm::quat q = glm::normalize(glm::quat(1.0f, 0.1f * seed * (t + 1.0f), 0.05f * j, 0.1f * seed - 0.2f * t));
+                position[k].time = t;
+                position[k].value = { seed, j * t, seed * t };
+                rotation[k].time = t;
+                rotation[k].value = { q.x, q.y, q.z, q.w };
+            }
+        }
+        clip.RecalculateDuration();
+
+        Pose bind = rest;
+        auto skeleton = std::make_shared<Skeleton>(std::move(rest), std::move(bind), std::vector<std::string>(numJoints));
+        std::vector<FastClip> clips;
+        clips.push_back(OptimizeClip(clip));
+        auto animation = std::make_shared<Animation::Animation>(std::move(clips));
+
+        auto controller = std::make_shared<AnimationController>(skeleton, animation);
+        controller->Play(std::size_t(0));
+        return controller;
+    }
+
+    struct Entry
+    {
+        AnimationSystem::InstanceId id;
+        AnimationController::Ptr controller;
+    };
+
+    // the palette in the shared buffer is the one the controller gives for itself, and no two palettes overlap
+    void CheckPalettes(const AnimationSystem &system, const std::vector<Entry> &entries, const std::string &what)
+    {
+        auto palettes = system.GetPalettes();
+        std::vector<int> owner(palettes.size(), -1);
+        for(std::size_t e = 0; e < entries.size(); ++e)
+        {
+            const auto &entry = entries[e];
+            std::vector<glm::mat4> expected;
+            entry.controller->GetSkinningPalette(expected);
+
+            std::size_t offset = system.GetPaletteOffset(entry.id);
+            if(!Test::Check(offset + expected.size() <= static_cast<std::size_t>(palettes.size()), fmt::format("{}: palette of instance {} ends past the buffer", what, entry.id)))
+                continue;
+
+            for(std::size_t i = 0; i < expected.size(); ++i)
+            {
+                bool same = true;
+                for(int c = 0; c < 4; ++c)
+                {
+                    for(int r = 0; r < 4; ++r)
+                        same &= std::abs(expected[i][c][r] - palettes[offset + i][c][r]) <= TOLERANCE;
+                }
+                Test::Check(same, fmt::format("{}: matrix {} of instance {} differs", what, i, entry.id));
+                Test::Check(owner[offset + i] == -1, fmt::format("{}: instances {} and {} share matrix {}", what, owner[offset + i], entry.id, offset + i));
+                owner[offset + i] = static_cast<int>(entry.id);
+            }
+        }
+    }
+
+    void TestPaletteOffsets()
+    {
+        WorkerPool pool(2);
+        AnimationSystem system(pool);
+
+        // enough instances for several batches, every one with its own joint count and motion
+        std::vector<Entry> entries;
+        for(std::size_t i = 0; i < 23; ++i)
+        {
+            auto controller = MakeController(2 + i % 7, static_cast<float>(i + 1) * 0.1f);
+            entries.push_back({ system.Add(controller), controller });
+        }
+        Test::Check(system.NumInstances() == entries.size(), fmt::format("{} instances instead of {}", system.NumInstances(), entries.size()));
+        system.Update(0.3f);
+        CheckPalettes(system, entries, "after adding");
+
+        // removed ids aren't valid anymore, the others keep their palettes
+        std::vector<AnimationSystem::InstanceId> removed = { entries[3].id, entries[10].id, entries[22].id };
+        for(std::size_t e : { 22, 10, 3 })
+            entries.erase(std::begin(entries) + e);
+        for(auto id : removed)
+        {
+            system.Remove(id);
+            bool threw = false;
+            try
+            {
+                system.Get(id);
+            }
+            catch(const RISException&)
+            {
+                threw = true;
+            }
+            Test::Check(threw, fmt::format("removed instance {} can still be used", id));
+        }
+        system.Update(0.2f);
+        CheckPalettes(system, entries, "after removing");
+
+        // the ids are given out again, to skeletons of other sizes than the ones before
+        for(std::size_t i = 0; i < removed.size(); ++i)
+        {
+            auto controller = MakeController(11 + i * 5, 2.0f + static_cast<float>(i));
+            auto id = system.Add(controller);
+            bool reused = std::find(std::begin(removed), std::end(removed), id) != std::end(removed);
+            Test::Check(reused, fmt::format("instance {} doesn't reuse a removed id", id));
+            entries.push_back({ id, controller });
+        }
+        Test::Check(system.NumInstances() == entries.size(), fmt::format("{} instances instead of {}", system.NumInstances(), entries.size()));
+        system.Update(0.25f);
+        CheckPalettes(system, entries, "after reusing ids");
+
+        // and a new one past the reused ids
+        auto controller = MakeController(4, 5.0f);
+        entries.push_back({ system.Add(controller), controller });
+        system.Update(0.1f);
+        CheckPalettes(system, entries, "after adding a new id");
+    }
+}
+
+int main()
+{
+    TestPaletteOffsets();
+
+    return Test::Result("AnimationSystem");
+}
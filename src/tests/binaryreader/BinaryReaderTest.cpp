@@ -0,0 +1,365 @@
+#include "loader/BinaryReader.hpp"
+#include "loader/PolyFile.hpp"
+#include "loader/WorldSolidsLoader.hpp"
+#include "loader/MapEntityLoader.hpp"
+#include "game/MapEntity.hpp"
+#include "tests/Test.hpp"
+
+#include <fmt/format.h>
+
+#include <vector>
+#include <string>
+#include <random>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#include <cstdint>
+
+// fuzzes the poly, brush and entity parsers with truncated and mutated copies of valid files.
+// a broken file has to end in a RISException, never in a crash, another exception or out of range indices
+
+using namespace RIS;
+using namespace RIS::Loader;
+
+namespace
+{
+    constexpr std::size_t MUTATIONS_PER_FILE = 20000;
+    constexpr std::size_t READER_RUNS = 2000;
+
+    class Writer
+    {
+    public:
+        template<typename T>
+        void Put(const T &value)
+        {
+            const auto *bytes = reinterpret_cast<const std::byte*>(&value);
+            data.insert(std::end(data), bytes, bytes + sizeof(T));
+        }
+
+        void PutName(const std::string &name, std::size_t length)
+        {
+            std::vector<char> chars(length, '\0');
+            std::memcpy(chars.data(), name.data(), std::min(name.size(), length - 1));
+            for(char c : chars)
+                Put(c);
+        }
+
+        void PutMagic(const char (&magic)[5])
+        {
+            for(int i = 0; i < 4; ++i)
+                Put(magic[i]);
+        }
+
+        std::vector<std::byte> data;
+
+    };
+
+    VertexType::MapVertex Vertex(std::mt19937 &random)
+    {
+        std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+        return { { dist(random), dist(random), dist(random) }, { 0.0f, 0.0f, 1.0f }, { dist(random), dist(random) } };
+    }
+
+    void PutPlanes(Writer &writer, std::mt19937 &random, std::uint32_t numPlanes)
+    {
+        writer.Put(numPlanes);
+        for(std::uint32_t i = 0; i < numPlanes; ++i)
+        {
+            Physics::Plane plane = { { 0.0f, 0.0f, 1.0f }, Vertex(random).position, static_cast<float>(i) };
+            writer.Put(plane);
+        }
+    }
+
+    // polygons with their own vertices and 16 bit indices, shared by poly version 1 and the entity files
+    void PutPolygons(Writer &writer, std::mt19937 &random, std::uint32_t numPolygons)
+    {
+        writer.Put(numPolygons);
+        for(std::uint32_t p = 0; p < numPolygons; ++p)
+        {
+            std::uint32_t numVertices = 3 + p % 4;
+            std::uint32_t numIndices = (numVertices - 2) * 3;
+            writer.Put(numVertices);
+            writer.Put(numIndices);
+            for(std::uint32_t v = 0; v < numVertices; ++v)
+                writer.Put(Vertex(random));
+            for(std::uint32_t t = 0; t < numVertices - 2; ++t)
+            {
+                writer.Put<std::uint16_t>(0);
+                writer.Put(static_cast<std::uint16_t>(t + 1));
+                writer.Put(static_cast<std::uint16_t>(t + 2));
+            }
+        }
+    }
+
+    std::vector<std::byte> PolyV1(std::mt19937 &random)
+    {
+        Writer writer;
+        writer.PutMagic("POLY");
+        writer.Put(POLY_FILE_VERSION_1);
+        writer.Put<std::uint32_t>(4);
+        for(int s = 0; s < 4; ++s)
+        {
+            writer.PutName(fmt::format("section{}", s), 64);
+            PutPolygons(writer, random, 3);
+        }
+        return writer.data;
+    }
+
+    std::vector<std::byte> PolyV2(std::mt19937 &random)
+    {
+        constexpr std::uint32_t NUM_SECTIONS = 4, SECTION_VERTICES = 6, SECTION_INDICES = 12;
+
+        Writer writer;
+        writer.PutMagic("POLY");
+        writer.Put(POLY_FILE_VERSION_2);
+        writer.Put(NUM_SECTIONS);
+        writer.Put(NUM_SECTIONS * SECTION_VERTICES);
+        writer.Put(NUM_SECTIONS * SECTION_INDICES);
+        for(std::uint32_t s = 0; s < NUM_SECTIONS; ++s)
+        {
+            writer.PutName(fmt::format("section{}", s), 64);
+            writer.Put(SECTION_VERTICES);
+            writer.Put(SECTION_INDICES);
+            for(std::uint32_t v = 0; v < SECTION_VERTICES; ++v)
+                writer.Put(Vertex(random));
+            for(std::uint32_t i = 0; i < SECTION_INDICES; ++i)
+                writer.Put(i % SECTION_VERTICES);
+        }
+        return writer.data;
+    }
+
+    std::vector<std::byte> Brushes(std::mt19937 &random)
+    {
+        Writer writer;
+        writer.PutMagic("BRUS");
+        writer.Put<std::uint32_t>(1);
+        writer.Put<std::uint32_t>(8);
+        for(std::uint32_t b = 0; b < 8; ++b)
+            PutPlanes(writer, random, 4 + b % 3);
+        return writer.data;
+    }
+
+    // one property of every value type, geometry and brushes on every other entity
+    std::vector<std::byte> Entities(std::mt19937 &random)
+    {
+        Writer writer;
+        writer.PutMagic("ENTI");
+        writer.Put<std::uint32_t>(1);
+        writer.Put<std::uint32_t>(4);
+        for(std::uint32_t e = 0; e < 4; ++e)
+        {
+            writer.PutName(fmt::format("func_door{}", e), 64);
+            writer.Put<std::uint32_t>(6);
+            for(std::uint32_t type = 0; type < 6; ++type)
+            {
+                writer.PutName(fmt::format("key{}", type), 64);
+                writer.Put(type);
+                switch(type)
+                {
+                case 0: writer.PutName("value", 128); break;
+                case 1: writer.Put<int>(42); break;
+                case 2: writer.Put(1.5f); break;
+                case 3: writer.Put(glm::vec2(1.0f, 2.0f)); break;
+                case 4: writer.Put(glm::vec3(1.0f, 2.0f, 3.0f)); break;
+                case 5: writer.Put<std::uint8_t>(1); break;
+                }
+            }
+
+            std::uint32_t numSections = e % 2 == 0 ? 2 : 0;
+            writer.Put(numSections);
+            for(std::uint32_t s = 0; s < numSections; ++s)
+            {
+                writer.PutName(fmt::format("door{}", s), 64);
+                PutPolygons(writer, random, 2);
+            }
+            writer.Put<std::uint32_t>(e % 2 == 0 ? 1 : 0);
+            if(e % 2 == 0)
+                PutPlanes(writer, random, 6);
+        }
+        return writer.data;
+    }
+
+    bool Valid(const PolyFile &poly)
+    {
+        for(auto index : poly.indices)
+            if(index >= poly.vertices.size())
+                return false;
+        for(const auto &section : poly.sections)
+            if(section.offset > poly.indices.size() || section.count > poly.indices.size() - section.offset)
+                return false;
+        return true;
+    }
+
+    bool Valid(const std::vector<Game::MapEntity> &entities)
+    {
+        for(const auto &entity : entities)
+        {
+            const auto &mesh = entity.Mesh();
+            for(auto index : mesh.indices)
+                if(index >= mesh.vertices.size())
+                    return false;
+            for(const auto &section : mesh.sections)
+                if(section.indexOffset > mesh.indices.size() || section.indexCount > mesh.indices.size() - section.indexOffset)
+                    return false;
+        }
+        return true;
+    }
+
+    // parses the bytes, returns false if the parser rejected them. everything but a RISException is a failure
+    using Parser = std::function<bool(const std::vector<std::byte>&)>;
+
+    bool Parse(const std::string &format, const Parser &parser, const std::vector<std::byte> &bytes, const std::string &what)
+    {
+        try
+        {
+            return parser(bytes);
+        }
+        catch(const RISException &)
+        {
+            return false;
+        }
+        catch(const std::exception &e)
+        {
+            Test::Check(false, fmt::format("{} {}: {}", format, what, e.what()));
+            return false;
+        }
+    }
+
+    void Fuzz(const std::string &format, const std::vector<std::byte> &valid, const Parser &parser, std::mt19937 &random)
+    {
+        Test::Check(Parse(format, parser, valid, "valid file"), format + " valid file wasn't read");
+
+        // every count is used up exactly, so any shorter file runs out of data
+        for(std::size_t size = 0; size < valid.size(); ++size)
+        {
+            std::vector<std::byte> truncated(std::begin(valid), std::begin(valid) + size);
+            if(!Test::Check(!Parse(format, parser, truncated, "truncated"), fmt::format("{} truncated to {} bytes was read", format, size)))
+                break;
+        }
+
+        const std::uint32_t counts[] = { 0, 1, 2, 0xFF, 0xFFFF, 0x10000, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF };
+        for(std::size_t i = 0; i < MUTATIONS_PER_FILE; ++i)
+        {
+            std::vector<std::byte> bytes = valid;
+            int numMutations = 1 + static_cast<int>(random() % 4);
+            for(int m = 0; m < numMutations && !bytes.empty(); ++m)
+            {
+                std::size_t at = random() % bytes.size();
+                switch(random() % 4)
+                {
+                case 0:
+                    bytes[at] ^= static_cast<std::byte>(1 << (random() % 8));
+                    break;
+                case 1:
+                    // counts are 4 byte aligned in every format
+                    at &= ~std::size_t(3);
+                    if(at + 4 <= bytes.size())
+                    {
+                        std::uint32_t count = counts[random() % std::size(counts)];
+                        std::memcpy(bytes.data() + at, &count, sizeof count);
+                    }
+                    break;
+                case 2:
+                    bytes.resize(at);
+                    break;
+                case 3:
+                    bytes.insert(std::begin(bytes) + at, static_cast<std::byte>(random()));
+                    break;
+                }
+            }
+            Parse(format, parser, bytes, fmt::format("mutation {}", i));
+        }
+    }
+
+    // random reads against a model of the offset, a read has to throw exactly when it doesn't fit
+    void FuzzReader(std::mt19937 &random)
+    {
+        for(std::size_t run = 0; run < READER_RUNS; ++run)
+        {
+            std::vector<std::byte> bytes(random() % 256);
+            BinaryReader reader(bytes.data(), bytes.size());
+            std::size_t offset = 0;
+            for(int op = 0; op < 32; ++op)
+            {
+                std::size_t count = random() % 4 == 0 ? random() : random() % 64;
+                std::size_t needed = 0;
+                bool fits = true;
+                try
+                {
+                    switch(random() % 5)
+                    {
+                    case 0:
+                        needed = sizeof(std::uint32_t);
+                        fits = needed <= bytes.size() - offset;
+                        reader.Read<std::uint32_t>();
+                        break;
+                    case 1:
+                        {
+                            std::vector<std::uint16_t> dst(std::min<std::size_t>(count, 64));
+                            count = dst.size();
+                            needed = count * sizeof(std::uint16_t);
+                            fits = needed <= bytes.size() - offset;
+                            reader.ReadArray(dst.data(), count);
+                        }
+                        break;
+                    case 2:
+                        fits = count <= (bytes.size() - offset) / sizeof(VertexType::MapVertex);
+                        needed = fits ? count * sizeof(VertexType::MapVertex) : 0;
+                        Test::Check(reader.View<VertexType::MapVertex>(count).size() == count, "View has the wrong size");
+                        break;
+                    case 3:
+                        fits = count <= (bytes.size() - offset) / sizeof(Physics::Plane);
+                        needed = fits ? count * sizeof(Physics::Plane) : 0;
+                        reader.SkipArray<Physics::Plane>(count);
+                        break;
+                    case 4:
+                        needed = count % 128;
+                        fits = needed <= bytes.size() - offset;
+                        Test::Check(reader.ReadString(needed).size() <= needed, "ReadString is longer than its field");
+                        break;
+                    }
+                    Test::Check(fits, fmt::format("read of {} bytes at {} of {} didn't throw", needed, offset, bytes.size()));
+                    offset += needed;
+                }
+                catch(const RISException &)
+                {
+                    Test::Check(!fits, fmt::format("read of {} bytes at {} of {} threw", needed, offset, bytes.size()));
+                }
+                Test::Check(reader.Offset() == offset, "reader moved on a failed read");
+                Test::Check(reader.Remaining() == bytes.size() - offset, "Remaining doesn't match the offset");
+            }
+        }
+    }
+}
+
+int main()
+{
+    std::mt19937 random(1234);
+
+    FuzzReader(random);
+
+    Parser poly = [](const std::vector<std::byte> &bytes)
+    {
+        auto file = ParsePolyFile(bytes.data(), bytes.size());
+        Test::Check(!file || Valid(*file), "poly file with indices out of range was read");
+        return file.has_value();
+    };
+    Parser brushes = [](const std::vector<std::byte> &bytes)
+    {
+        return ParseBrushFile(bytes.data(), bytes.size()).has_value();
+    };
+    Parser entities = [](const std::vector<std::byte> &bytes)
+    {
+        auto file = ParseEntityFile(bytes.data(), bytes.size());
+        Test::Check(!file || Valid(*file), "entity file with indices out of range was read");
+        return file != nullptr;
+    };
+
+    Fuzz("poly v1", PolyV1(random), poly, random);
+    Fuzz("poly v2", PolyV2(random), poly, random);
+    Fuzz("brush", Brushes(random), brushes, random);
+    Fuzz("entity", Entities(random), entities, random);
+
+    return Test::Result("BinaryReaderTest");
+}
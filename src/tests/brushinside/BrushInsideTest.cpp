@@ -0,0 +1,143 @@
+#include "physics/WorldSolids.hpp"
+#include "tests/Test.hpp"
+
+#include <glm/glm.hpp>
+
+#include <fmt/format.h>
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdint>
+
+// the vectorized IsInside has to give exactly the answers of IsInsideScalar. the brushes have the
+// shapes of map brushes (boxes, wedges, prisms, cut polytopes) with plane counts that aren't a
+// multiple of four, so the padding planes are covered too
+
+using namespace RIS;
+using namespace RIS::Physics;
+
+namespace
+{
+    constexpr std::size_t NUM_BRUSHES = 400;
+    constexpr std::size_t QUERIES_PER_BRUSH = 2000;
+    constexpr float PI = 3.14159265f;
+
+    Plane MakePlane(const glm::vec3 &normal, const glm::vec3 &point)
+    {
+        glm::vec3 n = glm::normalize(normal);
+        return { n, point, -glm::dot(n, point) };
+    }
+
+    void AddBox(Brush &brush, const glm::vec3 &min, const glm::vec3 &max)
+    {
+        brush.planes.push_back(MakePlane(glm::vec3(1, 0, 0), max));
+        brush.planes.push_back(MakePlane(glm::vec3(0, 1, 0), max));
+        brush.planes.push_back(MakePlane(glm::vec3(0, 0, 1), max));
+        brush.planes.push_back(MakePlane(glm::vec3(-1, 0, 0), min));
+        brush.planes.push_back(MakePlane(glm::vec3(0, -1, 0), min));
+        brush.planes.push_back(MakePlane(glm::vec3(0, 0, -1), min));
+    }
+
+    Brush CreateBrush(std::mt19937 &random, std::size_t index, const glm::vec3 &center)
+    {
+        std::uniform_real_distribution<float> size(8.0f, 128.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        glm::vec3 half(size(random), size(random), size(random));
+
+        Brush brush;
+        switch(index % 4)
+        {
+        case 0:
+            AddBox(brush, center - half, center + half);
+            break;
+        case 1:
+            // box with a slanted top, like a ramp
+            AddBox(brush, center - half, center + half);
+            brush.planes.push_back(MakePlane(glm::vec3(unit(random), unit(random), 1.0f), center + glm::vec3(0, 0, half.z * 0.5f)));
+            break;
+        case 2:
+            {
+                // prism around the z axis with 3 to 12 sides
+                int sides = 3 + static_cast<int>(random() % 10);
+                for(int i = 0; i < sides; ++i)
+                {
+                    float angle = 2.0f * PI * i / sides;
+                    glm::vec3 normal(std::cos(angle), std::sin(angle), 0.0f);
+                    brush.planes.push_back(MakePlane(normal, center + normal * half.x));
+                }
+                brush.planes.push_back(MakePlane(glm::vec3(0, 0, 1), center + half));
+                brush.planes.push_back(MakePlane(glm::vec3(0, 0, -1), center - half));
+            }
+            break;
+        case 3:
+            {
+                // planes in random directions tangent to a sphere, closed off by a box
+                AddBox(brush, center - half, center + half);
+                int cuts = 1 + static_cast<int>(random() % 9);
+                float radius = glm::min(half.x, glm::min(half.y, half.z)) * 0.8f;
+                for(int i = 0; i < cuts; ++i)
+                {
+                    glm::vec3 normal(unit(random), unit(random), unit(random));
+                    if(glm::dot(normal, normal) < 1e-4f)
+                        normal = glm::vec3(0, 0, 1);
+                    brush.planes.push_back(MakePlane(normal, center + glm::normalize(normal) * radius));
+                }
+            }
+            break;
+        }
+        return brush;
+    }
+
+    // points around the brush, on its planes and exactly on the planes pushed out by the radius
+    glm::vec3 CreateQuery(std::mt19937 &random, const Brush &brush, const glm::vec3 &center, float radius)
+    {
+        std::uniform_real_distribution<float> offset(-160.0f, 160.0f);
+        glm::vec3 point = center + glm::vec3(offset(random), offset(random), offset(random));
+        if(random() % 2 == 0)
+        {
+            const Plane &plane = brush.planes[random() % brush.planes.size()];
+            float side = glm::dot(point - plane.normal * radius, plane.normal) + plane.d;
+            point -= plane.normal * side;
+        }
+        return point;
+    }
+}
+
+int main()
+{
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> position(-4096.0f, 4096.0f);
+    std::uniform_real_distribution<float> radii(0.0f, 32.0f);
+
+    std::vector<Brush> brushes;
+    std::vector<glm::vec3> centers;
+    for(std::size_t i = 0; i < NUM_BRUSHES; ++i)
+    {
+        centers.emplace_back(position(random), position(random), position(random));
+        brushes.push_back(CreateBrush(random, i, centers.back()));
+    }
+    std::vector<Brush> copy = brushes;
+    WorldSolids worldSolids(std::move(copy));
+
+    std::size_t inside = 0, total = 0;
+    for(std::uint32_t id = 0; id < brushes.size(); ++id)
+    {
+        for(std::size_t q = 0; q < QUERIES_PER_BRUSH; ++q)
+        {
+            float radius = q % 3 == 0 ? 0.0f : radii(random);
+            glm::vec3 point = CreateQuery(random, brushes[id], centers[id], radius);
+
+            bool simd = worldSolids.IsInside(id, point, radius);
+            bool scalar = worldSolids.IsInsideScalar(id, point, radius);
+            Test::Check(simd == scalar, fmt::format("brush {} with {} planes, ({} {} {}) radius {}: IsInside {} IsInsideScalar {}", id, brushes[id].planes.size(), point.x, point.y, point.z, radius, simd, scalar));
+            inside += scalar;
+            ++total;
+        }
+    }
+
+    // the queries have to reach both answers or the comparison proves nothing
+    Test::Check(inside > total / 20 && inside < total - total / 20, fmt::format("{} of {} queries inside", inside, total));
+
+    return Test::Result("BrushInsideTest");
+}
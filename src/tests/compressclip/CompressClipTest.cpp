@@ -0,0 +1,264 @@
+#include "graphics/Animation.hpp"
+#include "tests/Test.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <fmt/format.h>
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+
+// compresses a clip with smooth, noisy, stepped, constant and shorter looping tracks and checks that
+// the compressed clip stays within the tolerances of CompressionSettings, for looping clips too.
+// clips with keys between the samples, cubic tracks and translations far larger than 65535 times
+// the tolerance are checked between the samples as well
+
+using namespace RIS;
+using namespace RIS::Graphics;
+using namespace RIS::Graphics::Animation;
+
+namespace
+{
+    constexpr std::size_t NUM_JOINTS = 24;
+    constexpr float KEY_RATE = 30.0f;
+    constexpr float DURATION = 4.0f;
+    constexpr float SHORT_DURATION = 2.0f;
+    constexpr float PI = 3.14159265f;
+    // rounding of the float math, far below the tolerances
+    constexpr float SLACK = 1e-5f;
+    // fine enough to see the error between two samples of the compressed clip. it isn't a multiple of the key
+    // rates, no check lands right on a step where float rounding decides which side of it the check is on
+    constexpr float FINE_CHECK_RATE = 1999.0f;
+
+    void SetValue(VectorFrame &frame, const glm::vec3 &v)
+    {
+        frame.value = { v.x, v.y, v.z };
+    }
+
+    void SetValue(QuaternionFrame &frame, const glm::quat &q)
+    {
+        frame.value = { q.x, q.y, q.z, q.w };
+    }
+
+    // keys at KEY_RATE like baked exports, returns the bytes the keys take up
+    template<typename TRACK, typename F>
+    std::size_t FillTrack(TRACK &track, float duration, Interpolation interpolation, F &&value)
+    {
+        std::size_t numKeys = static_cast<std::size_t>(std::lround(duration * KEY_RATE)) + 1;
+        track.SetInterpolation(interpolation);
+        track.Resize(numKeys);
+        for(std::size_t i = 0; i < numKeys; ++i)
+        {
+            auto &frame = track[i];
+            frame.time = static_cast<float>(i) / KEY_RATE;
+            SetValue(frame, value(frame.time));
+        }
+        return numKeys * sizeof(track[0]);
+    }
+
+    // keys at the given times, cubic keys get the slope of value at their time on both sides
+    template<typename F>
+    void FillTrackAt(VectorTrack &track, const std::vector<float> &times, Interpolation interpolation, F &&value)
+    {
+        track.SetInterpolation(interpolation);
+        track.Resize(times.size());
+        for(std::size_t i = 0; i < times.size(); ++i)
+        {
+            auto &frame = track[i];
+            frame.time = times[i];
+            SetValue(frame, value(frame.time));
+            glm::vec3 slope = (value(frame.time + 1e-3f) - value(frame.time - 1e-3f)) / 2e-3f;
+            frame.in = { slope.x, slope.y, slope.z };
+            frame.out = frame.in;
+        }
+    }
+
+    std::vector<float> KeyTimes(float duration, float rate)
+    {
+        std::vector<float> times(static_cast<std::size_t>(std::lround(duration * rate)) + 1);
+        for(std::size_t i = 0; i < times.size(); ++i)
+            times[i] = static_cast<float>(i) / rate;
+        return times;
+    }
+
+    glm::quat AxisAngle(const glm::vec3 &axis, float angle)
+    {
+        glm::vec3 v = axis * std::sin(angle * 0.5f);
+        return glm::quat(std::cos(angle * 0.5f), v.x, v.y, v.z);
+    }
+
+    // same measure as MeasureCompressionError, half the angle between the unit quaternions
+    float AngleBetween(const glm::quat &a, glm::quat b)
+    {
+        if(glm::dot(a, b) < 0.0f)
+            b = -b;
+        return 4.0f * std::atan2(glm::length(a - b), glm::length(a + b));
+    }
+
+    glm::vec3 RandomVec3(std::mt19937 &random, float min, float max)
+    {
+        std::uniform_real_distribution<float> range(min, max);
+        return glm::vec3(range(random), range(random), range(random));
+    }
+
+    // local joint offsets of a few units and rotations of up to 1.5 radians
+    std::size_t AddJoint(Clip &clip, std::mt19937 &random, std::size_t joint)
+    {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        glm::vec3 base = RandomVec3(random, -5.0f, 5.0f);
+        glm::vec3 amplitude = RandomVec3(random, 0.5f, 3.0f);
+        glm::vec3 axis = glm::normalize(RandomVec3(random, -1.0f, 1.0f) + glm::vec3(0.0f, 0.0f, 0.1f));
+        float angle = 0.2f + 1.3f * std::abs(unit(random));
+        float phase = PI * unit(random);
+        float cycles = 1.0f + static_cast<float>(random() % 3);
+
+        TransformTrack &track = clip[joint];
+        std::size_t size = 0;
+        switch(joint % 4)
+        {
+        case 0:
+            // smooth everywhere
+            size += FillTrack(track.GetPositionTrack(), DURATION, Interpolation::LINEAR, [&](float t){ return base + amplitude * std::sin(2.0f * PI * cycles * t / DURATION + phase); });
+            size += FillTrack(track.GetRotationTrack(), DURATION, Interpolation::LINEAR, [&](float t){ return AxisAngle(axis, angle * std::sin(PI * t / DURATION + phase)); });
+            size += FillTrack(track.GetScaleTrack(), DURATION, Interpolation::LINEAR, [&](float t){ return glm::vec3(1.0f + 0.25f * std::sin(2.0f * PI * t / DURATION + phase)); });
+            break;
+        case 1:
+            // noise keeps most keys, the scale never changes
+            size += FillTrack(track.GetPositionTrack(), DURATION, Interpolation::LINEAR, [&](float t){ return base + amplitude * std::sin(PI * t / DURATION) + RandomVec3(random, -0.05f, 0.05f); });
+            size += FillTrack(track.GetRotationTrack(), DURATION, Interpolation::LINEAR, [&](float t){ return AxisAngle(axis, angle * t / DURATION + 0.02f * unit(random)); });
+            size += FillTrack(track.GetScaleTrack(), DURATION, Interpolation::LINEAR, [&](float){ return glm::vec3(1.0f); });
+            break;
+        case 2:
+            // stepped position and no scale track
+            size += FillTrack(track.GetPositionTrack(), DURATION, Interpolation::CONSTANT, [&](float t){ return base + amplitude * std::floor(t * 2.0f); });
+            size += FillTrack(track.GetRotationTrack(), DURATION, Interpolation::LINEAR, [&](float t){ return AxisAngle(axis, angle * std::cos(2.0f * PI * t / DURATION)); });
+            break;
+        case 3:
+            // half as long as the clip and seamless, so a looping clip plays it twice
+            size += FillTrack(track.GetPositionTrack(), SHORT_DURATION, Interpolation::LINEAR, [&](float t){ return base + amplitude * std::sin(2.0f * PI * t / SHORT_DURATION + phase); });
+            size += FillTrack(track.GetRotationTrack(), SHORT_DURATION, Interpolation::LINEAR, [&](float t){ return AxisAngle(axis, angle * std::sin(2.0f * PI * t / SHORT_DURATION)); });
+            break;
+        }
+        return size;
+    }
+
+    // tracks the resampling at 30 samples per second used to miss: corners and steps on keys at 24 and 40 per second,
+    // cubic curves that bulge out between their keys and a root moving 400 units with a small sway
+    Clip BetweenSamplesClip()
+    {
+        Clip clip;
+        clip.SetName("between samples");
+        FillTrackAt(clip[0].GetPositionTrack(), KeyTimes(DURATION, 24.0f), Interpolation::LINEAR, [](float t){ return glm::vec3(std::lround(t * 24.0f) % 2 == 0 ? 0.0f : 0.5f, t, 0.0f); });
+        FillTrackAt(clip[1].GetPositionTrack(), KeyTimes(DURATION, 40.0f), Interpolation::CONSTANT, [](float t){ return glm::vec3(std::floor(t * 40.0f) * 0.1f, 0.0f, 1.0f); });
+        FillTrackAt(clip[2].GetPositionTrack(), KeyTimes(DURATION, KEY_RATE), Interpolation::CUBIC, [](float t){ return glm::vec3(0.01f * std::sin(t * KEY_RATE * PI), 1.0f, 2.0f); });
+        FillTrackAt(clip[3].GetScaleTrack(), KeyTimes(DURATION, KEY_RATE), Interpolation::CUBIC, [](float t){ return glm::vec3(1.0f + 0.25f * std::sin(2.0f * PI * t / DURATION)); });
+        FillTrackAt(clip[4].GetPositionTrack(), KeyTimes(DURATION, KEY_RATE), Interpolation::LINEAR, [](float t){ return glm::vec3(100.0f * t, 0.05f * std::sin(2.0f * PI * t), -50.0f * t); });
+        clip.RecalculateDuration();
+        return clip;
+    }
+
+    // steps at random times, no sample rate puts all of them on a sample
+    Clip RandomStepsClip(std::mt19937 &random)
+    {
+        std::uniform_real_distribution<float> interval(0.05f, 0.15f);
+        std::vector<float> times = { 0.0f };
+        while(times.back() < DURATION)
+            times.push_back(times.back() + interval(random));
+
+        Clip clip;
+        clip.SetName("random steps");
+        FillTrackAt(clip[0].GetPositionTrack(), times, Interpolation::CONSTANT, [&times](float t)
+        {
+            auto step = std::upper_bound(std::begin(times), std::end(times), t) - std::begin(times);
+            return glm::vec3(static_cast<float>(step % 2), 0.0f, 0.0f);
+        });
+        clip.RecalculateDuration();
+        return clip;
+    }
+}
+
+int main()
+{
+    std::mt19937 random(1234);
+
+    Clip clip;
+    clip.SetName("test");
+    std::size_t sourceSize = 0;
+    for(std::size_t joint = 0; joint < NUM_JOINTS; ++joint)
+        sourceSize += AddJoint(clip, random, joint);
+    clip.RecalculateDuration();
+
+    const CompressionSettings tight;
+    const CompressionSettings loose{ 30.0f, 0.01f, 0.01f, 0.01f };
+
+    for(bool looping : { false, true })
+    {
+        clip.SetLooping(looping);
+
+        std::size_t tightSize = 0;
+        for(const CompressionSettings *settings : { &tight, &loose })
+        {
+            CompressedClip compressed = CompressClip(clip, *settings);
+            CompressionError error = MeasureCompressionError(clip, compressed);
+            std::string name = fmt::format("{} clip, tolerances {} {} {}", looping ? "looping" : "clamped", settings->positionTolerance, settings->rotationTolerance, settings->scaleTolerance);
+
+            Test::Check(compressed.GetLooping() == looping, fmt::format("{}: looping isn't kept", name));
+            Test::Check(compressed.Size() == clip.Size(), fmt::format("{}: {} of {} tracks", name, compressed.Size(), clip.Size()));
+            Test::Check(error.position <= settings->positionTolerance + SLACK, fmt::format("{}: position error {}", name, error.position));
+            Test::Check(error.rotation <= settings->rotationTolerance + SLACK, fmt::format("{}: rotation error {}", name, error.rotation));
+            Test::Check(error.scale <= settings->scaleTolerance + SLACK, fmt::format("{}: scale error {}", name, error.scale));
+            Test::Check(compressed.MemorySize() < sourceSize, fmt::format("{}: {} bytes compressed, {} bytes source", name, compressed.MemorySize(), sourceSize));
+
+            // playing both clips for two loops gives the same poses, no matter how the clip wraps its time
+            Pose expected(NUM_JOINTS), actual(NUM_JOINTS);
+            CompressedClip::Cursor cursor;
+            float worst[3] = { 0.0f, 0.0f, 0.0f };
+            for(float time = 0.0f; time < clip.GetDuration() * 2.0f; time += 1.0f / 60.0f)
+            {
+                clip.Sample(expected, time);
+                compressed.Sample(actual, time, cursor);
+                for(std::size_t joint = 0; joint < NUM_JOINTS; ++joint)
+                {
+                    Transform a = expected.GetLocalTransform(joint);
+                    Transform b = actual.GetLocalTransform(joint);
+                    worst[0] = std::max(worst[0], glm::length(a.position - b.position));
+                    worst[1] = std::max(worst[1], AngleBetween(glm::normalize(a.rotation), glm::normalize(b.rotation)));
+                    worst[2] = std::max(worst[2], glm::length(a.scale - b.scale));
+                }
+            }
+            Test::Check(worst[0] <= settings->positionTolerance + SLACK, fmt::format("{}: played position error {}", name, worst[0]));
+            Test::Check(worst[1] <= settings->rotationTolerance + SLACK, fmt::format("{}: played rotation error {}", name, worst[1]));
+            Test::Check(worst[2] <= settings->scaleTolerance + SLACK, fmt::format("{}: played scale error {}", name, worst[2]));
+
+            // larger tolerances have to drop more keys
+            if(settings == &tight)
+                tightSize = compressed.MemorySize();
+            else
+                Test::Check(compressed.MemorySize() < tightSize, fmt::format("{}: {} bytes, {} bytes with the default tolerances", name, compressed.MemorySize(), tightSize));
+        }
+    }
+
+    const CompressionSettings settings;
+    Clip between = BetweenSamplesClip();
+    for(bool looping : { false, true })
+    {
+        between.SetLooping(looping);
+        CompressedClip compressed = CompressClip(between, settings);
+        CompressionError error = MeasureCompressionError(between, compressed, FINE_CHECK_RATE);
+        std::string name = fmt::format("{} clip with keys between the samples", looping ? "looping" : "clamped");
+
+        Test::Check(compressed.WithinTolerance(), fmt::format("{}: isn't within the tolerances", name));
+        Test::Check(error.position <= settings.positionTolerance + SLACK, fmt::format("{}: position error {}", name, error.position));
+        Test::Check(error.scale <= settings.scaleTolerance + SLACK, fmt::format("{}: scale error {}", name, error.scale));
+    }
+
+    // what can't be kept is reported
+    Clip steps = RandomStepsClip(random);
+    Test::Check(!CompressClip(steps, settings).WithinTolerance(), "steps at random times are reported");
+
+    return Test::Result("CompressClipTest");
+}
@@ -0,0 +1,94 @@
+#include "physics/WorldSolids.hpp"
+#include "tests/Test.hpp"
+
+#include <glm/glm.hpp>
+
+#include <fmt/format.h>
+
+#include <vector>
+#include <cmath>
+
+// a sphere that starts in a brush, e.g. a player spawned or pushed into one, has to be able to move
+// out of it again. moves that start outside still stop at walls and slide along them
+
+using namespace RIS;
+using namespace RIS::Physics;
+
+namespace
+{
+    constexpr float RADIUS = 16.0f;
+
+    Plane MakePlane(const glm::vec3 &normal, const glm::vec3 &point)
+    {
+        glm::vec3 n = glm::normalize(normal);
+        return { n, point, -glm::dot(n, point) };
+    }
+
+    Brush MakeBox(const glm::vec3 &min, const glm::vec3 &max)
+    {
+        Brush brush;
+        brush.planes.push_back(MakePlane(glm::vec3(1, 0, 0), max));
+        brush.planes.push_back(MakePlane(glm::vec3(0, 1, 0), max));
+        brush.planes.push_back(MakePlane(glm::vec3(0, 0, 1), max));
+        brush.planes.push_back(MakePlane(glm::vec3(-1, 0, 0), min));
+        brush.planes.push_back(MakePlane(glm::vec3(0, -1, 0), min));
+        brush.planes.push_back(MakePlane(glm::vec3(0, 0, -1), min));
+        return brush;
+    }
+
+    std::string Format(const glm::vec3 &v)
+    {
+        return fmt::format("({} {} {})", v.x, v.y, v.z);
+    }
+}
+
+int main()
+{
+    // a wall at x 0 to 64 and a pillar far away from it
+    std::vector<Brush> brushes;
+    brushes.push_back(MakeBox(glm::vec3(0, -512, -512), glm::vec3(64, 512, 512)));
+    brushes.push_back(MakeBox(glm::vec3(-512, 256, -32), glm::vec3(-448, 320, 32)));
+    WorldSolids worldSolids(std::move(brushes));
+
+    // nothing in the way
+    {
+        glm::vec3 start(-128, 0, 0), movement(-32, 16, 0);
+        glm::vec3 end = worldSolids.SlideMove(start, movement, RADIUS);
+        Test::Check(glm::length(end - (start + movement)) < 1e-3f, fmt::format("free move ends at {}", Format(end)));
+    }
+
+    // into the wall at an angle, stops in front of it and slides along
+    {
+        glm::vec3 start(-64, 0, 0), movement(96, 64, 0);
+        glm::vec3 end = worldSolids.SlideMove(start, movement, RADIUS);
+        Test::Check(end.x <= -RADIUS + 1e-3f && end.x > -RADIUS - 1.0f, fmt::format("move into the wall ends at {}", Format(end)));
+        Test::Check(end.y > 32.0f, fmt::format("move into the wall doesn't slide, ends at {}", Format(end)));
+        Test::Check(!worldSolids.Collides(end, RADIUS), fmt::format("move into the wall ends in it at {}", Format(end)));
+    }
+
+    // overlapping the wall and walking away from it, the move goes through like it would from outside
+    {
+        glm::vec3 start(-8, 0, 0), movement(-32, 8, 0);
+        Test::Check(worldSolids.Collides(start, RADIUS), "the start doesn't overlap the wall");
+        glm::vec3 end = worldSolids.SlideMove(start, movement, RADIUS);
+        Test::Check(glm::length(end - (start + movement)) < 1e-3f, fmt::format("move out of the wall ends at {}", Format(end)));
+    }
+
+    // overlapping the wall and walking along it, the sphere can't stay stuck
+    {
+        glm::vec3 start(-8, 0, 0), movement(0, 32, 0);
+        glm::vec3 end = worldSolids.SlideMove(start, movement, RADIUS);
+        Test::Check(end != start, "move along the wall is stuck at the start");
+        Test::Check(!worldSolids.Collides(end, RADIUS), fmt::format("move along the wall ends in it at {}", Format(end)));
+    }
+
+    // deep inside the wall and walking further in, it gets out through the closest side
+    {
+        glm::vec3 start(8, 0, 0), movement(8, 0, 0);
+        glm::vec3 end = worldSolids.SlideMove(start, movement, RADIUS);
+        Test::Check(!worldSolids.Collides(end, RADIUS), fmt::format("move into the wall from inside ends in it at {}", Format(end)));
+        Test::Check(end.x < 0.0f, fmt::format("move into the wall from inside doesn't leave through the closest side, ends at {}", Format(end)));
+    }
+
+    return Test::Result("SlideMoveTest");
+}
@@ -0,0 +1,175 @@
+#include "graphics/Animation.hpp"
+#include "tests/Test.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <fmt/format.h>
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+// the SoAPose blends and palette have to give the results of the Pose versions. the joint counts
+// aren't multiples of four so the padding at the end of the last block is covered too
+
+using namespace RIS;
+using namespace RIS::Graphics;
+using namespace RIS::Graphics::Animation;
+
+namespace
+{
+    constexpr float TOLERANCE = 1e-5f;
+
+    Pose RandomPose(std::mt19937 &rng, std::size_t size)
+    {
+        std::uniform_real_distribution<float> position(-2.0f, 2.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> scale(0.8f, 1.2f);
+
+        // parents before their children, like every skeleton the controller gets
+        Pose pose(size);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            glm::quat rotation = glm::normalize(glm::quat(unit(rng), unit(rng), unit(rng), unit(rng)));
+            pose.SetLocalTransform(i, Transform(glm::vec3(position(rng), position(rng), position(rng)), rotation, glm::vec3(scale(rng), scale(rng), scale(rng))));
+            pose.SetParent(i, i == 0 ? -1 : static_cast<int>(rng() % i));
+        }
+        return pose;
+    }
+
+    // a few joints out, a few partially in and the last ones past the end of the mask
+    BoneMask RandomMask(std::mt19937 &rng, std::size_t size)
+    {
+        std::uniform_real_distribution<float> weight(0.0f, 1.0f);
+        BoneMask mask(size > 2 ? size - 2 : size);
+        for(std::size_t i = 0; i + 2 < size; ++i)
+            mask.Set(i, i % 3 == 0 ? 0.0f : weight(rng));
+        return mask;
+    }
+
+    bool Near(float a, float b)
+    {
+        return std::abs(a - b) <= TOLERANCE * std::max(1.0f, std::abs(a));
+    }
+
+    bool Near(const Transform &a, const Transform &b)
+    {
+        for(int i = 0; i < 3; ++i)
+        {
+            if(!Near(a.position[i], b.position[i]) || !Near(a.scale[i], b.scale[i]))
+                return false;
+        }
+        // q and -q are the same rotation
+        return std::abs(glm::dot(a.rotation, b.rotation)) >= 1.0f - TOLERANCE;
+    }
+
+    void CheckPoses(const Pose &expected, const SoAPose &actual, const std::string &what)
+    {
+        if(!Test::Check(expected.Size() == actual.Size(), fmt::format("{}: {} joints instead of {}", what, actual.Size(), expected.Size())))
+            return;
+        for(std::size_t i = 0; i < expected.Size(); ++i)
+        {
+            Test::Check(Near(expected.GetLocalTransform(i), actual.GetLocalTransform(i)), fmt::format("{}: joint {} differs", what, i));
+            Test::Check(expected.GetParent(i) == actual.GetParent(i), fmt::format("{}: parent of joint {} differs", what, i));
+        }
+    }
+
+    void TestBlend(std::mt19937 &rng, std::size_t size)
+    {
+        Pose a = RandomPose(rng, size), b = RandomPose(rng, size);
+        const BoneMask mask = RandomMask(rng, size);
+        SoAPose soaA(a), soaB(b);
+
+        for(float t : { 0.0f, 0.3f, 1.0f })
+        {
+            for(const BoneMask *m : { static_cast<const BoneMask*>(nullptr), &mask })
+            {
+                std::string what = fmt::format("Blend of {} joints at {}{}", size, t, m ? " with a mask" : "");
+                Pose expected;
+                Blend(expected, a, b, t, m);
+
+                SoAPose actual;
+                Blend(actual, soaA, soaB, t, m);
+                CheckPoses(expected, actual, what);
+
+                // in place, the way the controller blends
+                SoAPose inPlace = soaA;
+                Blend(inPlace, inPlace, soaB, t, m);
+                CheckPoses(expected, inPlace, what + " in place");
+            }
+        }
+    }
+
+    void TestBlendAdditive(std::mt19937 &rng, std::size_t size)
+    {
+        Pose in = RandomPose(rng, size), additive = RandomPose(rng, size), base = RandomPose(rng, size);
+        const BoneMask mask = RandomMask(rng, size);
+        SoAPose soaIn(in), soaAdditive(additive), soaBase(base);
+
+        for(float weight : { 0.0f, 0.5f, 1.0f })
+        {
+            for(const BoneMask *m : { static_cast<const BoneMask*>(nullptr), &mask })
+            {
+                std::string what = fmt::format("BlendAdditive of {} joints at {}{}", size, weight, m ? " with a mask" : "");
+                Pose expected;
+                BlendAdditive(expected, in, additive, base, weight, m);
+
+                SoAPose actual;
+                BlendAdditive(actual, soaIn, soaAdditive, soaBase, weight, m);
+                CheckPoses(expected, actual, what);
+
+                SoAPose inPlace = soaIn;
+                BlendAdditive(inPlace, inPlace, soaAdditive, soaBase, weight, m);
+                CheckPoses(expected, inPlace, what + " in place");
+            }
+        }
+    }
+
+    void TestMatrixPalette(std::mt19937 &rng, std::size_t size)
+    {
+        Pose pose = RandomPose(rng, size);
+        std::vector<glm::mat4> expected, actual;
+        pose.GetMatrixPalette(expected);
+        SoAPose(pose).GetMatrixPalette(actual);
+
+        if(!Test::Check(actual.size() == expected.size(), fmt::format("Palette of {} joints has {} matrices", size, actual.size())))
+            return;
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            bool same = true;
+            for(int c = 0; c < 4; ++c)
+            {
+                for(int r = 0; r < 4; ++r)
+                    same &= Near(expected[i][c][r], actual[i][c][r]);
+            }
+            Test::Check(same, fmt::format("Palette of {} joints: matrix {} differs", size, i));
+        }
+    }
+
+    // blending and palettes keep the padding an identity transform, growing the pose later shows it
+    void TestPadding(std::mt19937 &rng)
+    {
+        Pose a = RandomPose(rng, 5), b = RandomPose(rng, 5);
+        SoAPose soa(a);
+        Blend(soa, soa, SoAPose(b), 0.5f);
+        soa.Resize(8);
+        for(std::size_t i = 5; i < 8; ++i)
+            Test::Check(Near(soa.GetLocalTransform(i), Transform()), fmt::format("Padding joint {} isn't an identity transform", i));
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(7);
+    for(std::size_t size : { 1, 3, 5, 7, 18, 67 })
+    {
+        TestBlend(rng, size);
+        TestBlendAdditive(rng, size);
+        TestMatrixPalette(rng, size);
+    }
+    TestPadding(rng);
+
+    return Test::Result("SoAPose");
+}
@@ -0,0 +1,184 @@
+#include "loader/ZipPack.hpp"
+#include "tests/Test.hpp"
+
+#include <zlib.h>
+
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <random>
+#include <cstring>
+#include <cstdint>
+
+// reads stored and deflated entries of one archive from many threads at once and compares
+// every result with the original data, Read and Map don't take the archive lock for these
+
+using namespace RIS;
+using namespace RIS::Loader;
+
+namespace
+{
+    constexpr std::size_t NUM_ENTRIES = 64;
+    constexpr std::size_t NUM_THREADS = 8;
+    constexpr std::size_t READS_PER_THREAD = 2000;
+
+    struct TestEntry
+    {
+        std::string name;
+        std::vector<std::byte> data;
+        bool deflate;
+    };
+
+    void Write16(std::vector<std::byte> &out, std::uint16_t value)
+    {
+        for(int i = 0; i < 2; ++i)
+            out.push_back(static_cast<std::byte>(value >> (8 * i)));
+    }
+
+    void Write32(std::vector<std::byte> &out, std::uint32_t value)
+    {
+        for(int i = 0; i < 4; ++i)
+            out.push_back(static_cast<std::byte>(value >> (8 * i)));
+    }
+
+    std::vector<std::byte> Deflate(const std::vector<std::byte> &data)
+    {
+        z_stream stream = {};
+        deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+        std::vector<std::byte> out(deflateBound(&stream, static_cast<uLong>(data.size())));
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(data.data()));
+        stream.avail_in = static_cast<uInt>(data.size());
+        stream.next_out = reinterpret_cast<Bytef*>(out.data());
+        stream.avail_out = static_cast<uInt>(out.size());
+        deflate(&stream, Z_FINISH);
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        return out;
+    }
+
+    // just enough of the zip format for the index of ZipPack: local headers, central directory, end record
+    void WriteZip(const std::filesystem::path &path, const std::vector<TestEntry> &entries)
+    {
+        std::vector<std::byte> file;
+        std::vector<std::byte> directory;
+        for(const auto &entry : entries)
+        {
+            std::vector<std::byte> payload = entry.deflate ? Deflate(entry.data) : entry.data;
+            std::uint32_t crc = crc32(0, reinterpret_cast<const Bytef*>(entry.data.data()), static_cast<uInt>(entry.data.size()));
+            std::uint16_t method = entry.deflate ? 8 : 0;
+            std::uint32_t localOffset = static_cast<std::uint32_t>(file.size());
+
+            Write32(file, 0x04034b50);
+            Write16(file, 20);
+            Write16(file, 0);
+            Write16(file, method);
+            Write32(file, 0);
+            Write32(file, crc);
+            Write32(file, static_cast<std::uint32_t>(payload.size()));
+            Write32(file, static_cast<std::uint32_t>(entry.data.size()));
+            Write16(file, static_cast<std::uint16_t>(entry.name.size()));
+            Write16(file, 0);
+            for(char c : entry.name)
+                file.push_back(static_cast<std::byte>(c));
+            file.insert(std::end(file), std::begin(payload), std::end(payload));
+
+            Write32(directory, 0x02014b50);
+            Write16(directory, 20);
+            Write16(directory, 20);
+            Write16(directory, 0);
+            Write16(directory, method);
+            Write32(directory, 0);
+            Write32(directory, crc);
+            Write32(directory, static_cast<std::uint32_t>(payload.size()));
+            Write32(directory, static_cast<std::uint32_t>(entry.data.size()));
+            Write16(directory, static_cast<std::uint16_t>(entry.name.size()));
+            Write16(directory, 0);
+            Write16(directory, 0);
+            Write16(directory, 0);
+            Write16(directory, 0);
+            Write32(directory, 0);
+            Write32(directory, localOffset);
+            for(char c : entry.name)
+                directory.push_back(static_cast<std::byte>(c));
+        }
+
+        std::uint32_t directoryOffset = static_cast<std::uint32_t>(file.size());
+        file.insert(std::end(file), std::begin(directory), std::end(directory));
+        Write32(file, 0x06054b50);
+        Write16(file, 0);
+        Write16(file, 0);
+        Write16(file, static_cast<std::uint16_t>(entries.size()));
+        Write16(file, static_cast<std::uint16_t>(entries.size()));
+        Write32(file, static_cast<std::uint32_t>(directory.size()));
+        Write32(file, directoryOffset);
+        Write16(file, 0);
+
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(file.data()), file.size());
+    }
+
+    std::vector<TestEntry> CreateEntries()
+    {
+        std::mt19937 random(1234);
+        std::vector<TestEntry> entries(NUM_ENTRIES);
+        for(std::size_t i = 0; i < NUM_ENTRIES; ++i)
+        {
+            auto &entry = entries[i];
+            entry.name = fmt::format("data/Entry{}.bin", i);
+            entry.deflate = i % 2 == 0;
+            entry.data.resize(std::uniform_int_distribution<std::size_t>(0, 256 * 1024)(random));
+            // runs of repeated bytes, so deflate has something to do
+            for(std::size_t j = 0; j < entry.data.size(); ++j)
+                entry.data[j] = static_cast<std::byte>((j / 7 + i) % 251);
+        }
+        return entries;
+    }
+}
+
+int main()
+{
+    auto path = std::filesystem::temp_directory_path() / "ris_zipread_test.zip";
+    auto entries = CreateEntries();
+    WriteZip(path, entries);
+
+    {
+        ZipPack pack(path.string());
+        for(const auto &entry : entries)
+            Test::Check(pack.Contains(entry.name), fmt::format("{} is in the archive", entry.name));
+
+        std::vector<std::thread> threads;
+        for(std::size_t t = 0; t < NUM_THREADS; ++t)
+        {
+            threads.emplace_back([&pack, &entries, t]
+            {
+                std::mt19937 random(static_cast<std::uint32_t>(t));
+                for(std::size_t i = 0; i < READS_PER_THREAD; ++i)
+                {
+                    const auto &entry = entries[random() % entries.size()];
+                    // names are case insensitive
+                    std::string name = i % 3 == 0 ? "DATA/" + entry.name.substr(5) : entry.name;
+                    if(i % 2 == 0)
+                    {
+                        auto bytes = pack.Read(name);
+                        Test::Check(bytes == entry.data, fmt::format("Read {} on thread {}", name, t));
+                    }
+                    else
+                    {
+                        auto view = pack.Map(name);
+                        bool same = view.size() == entry.data.size() && (view.empty() || std::memcmp(view.data(), entry.data.data(), view.size()) == 0);
+                        Test::Check(same, fmt::format("Map {} on thread {}", name, t));
+                    }
+                }
+            });
+        }
+        for(auto &thread : threads)
+            thread.join();
+    }
+
+    std::filesystem::remove(path);
+    return Test::Result("ZipReadTest");
+}
@@ -0,0 +1,114 @@
+#include "loader/MeshData.hpp"
+#include "misc/Args.hpp"
+#include "misc/StringSupport.hpp"
+
+#include <fmt/format.h>
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <string>
+#include <cstring>
+
+// converts binary gltf meshes into .rmesh files that can be uploaded without parsing
+//   RisMeshCooker -in <mesh.glb|folder> -out <mesh.rmesh|folder>
+
+using namespace RIS;
+using namespace RIS::Loader;
+
+namespace
+{
+    std::vector<std::byte> ReadFile(const std::filesystem::path &path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if(!file)
+            throw std::runtime_error(fmt::format("Can't read {}", path.generic_string()));
+
+        std::size_t size = file.tellg();
+        file.seekg(0);
+        std::vector<std::byte> bytes(size);
+        file.read(reinterpret_cast<char*>(bytes.data()), size);
+        return bytes;
+    }
+
+    void Cook(const std::filesystem::path &inputPath, const std::filesystem::path &outputPath)
+    {
+        auto bytes = ReadFile(inputPath);
+
+        std::string warning;
+        auto meshData = ParseGLTFMesh(bytes.data(), bytes.size(), warning);
+        if(!warning.empty())
+            std::cerr << fmt::format("({}): {}\n", inputPath.generic_string(), warning);
+        if(!meshData)
+            throw std::runtime_error(fmt::format("Can't parse {}", inputPath.generic_string()));
+
+        RMeshHeader header = {};
+        std::memcpy(header.magic, RMESH_MAGIC, sizeof(header.magic));
+        header.version = RMESH_VERSION;
+        header.vertexSize = sizeof(VertexType::ModelVertex);
+        header.indexSize = static_cast<std::uint32_t>(meshData->indexSize);
+        header.numVertices = static_cast<std::uint32_t>(meshData->vertices.size());
+        header.numIndices = static_cast<std::uint32_t>(meshData->numIndices);
+        header.numSubMeshes = static_cast<std::uint32_t>(meshData->subMeshes.size());
+        std::memcpy(header.min, &meshData->min, sizeof(header.min));
+        std::memcpy(header.max, &meshData->max, sizeof(header.max));
+        header.vertexOffset = sizeof(RMeshHeader);
+        header.indexOffset = header.vertexOffset + meshData->vertices.size() * sizeof(VertexType::ModelVertex);
+        header.subMeshOffset = header.indexOffset + meshData->indices.size();
+
+        if(outputPath.has_parent_path())
+            std::filesystem::create_directories(outputPath.parent_path());
+
+        std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+        if(!out)
+            throw std::runtime_error(fmt::format("Can't write {}", outputPath.generic_string()));
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(meshData->vertices.data()), meshData->vertices.size() * sizeof(VertexType::ModelVertex));
+        out.write(reinterpret_cast<const char*>(meshData->indices.data()), meshData->indices.size());
+        out.write(reinterpret_cast<const char*>(meshData->subMeshes.data()), meshData->subMeshes.size() * sizeof(RMeshSubMesh));
+        if(!out)
+            throw std::runtime_error(fmt::format("Failed to write {}", outputPath.generic_string()));
+
+        std::cout << fmt::format("{} -> {} ({} vertices, {} indices, {} submeshes)\n", inputPath.generic_string(), outputPath.generic_string(), header.numVertices, header.numIndices, header.numSubMeshes);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        Args args(argc, argv);
+        if(!args.IsSet("-in") || !args.IsSet("-out"))
+        {
+            std::cout << "usage: RisMeshCooker -in <mesh.glb|folder> -out <mesh.rmesh|folder>\n";
+            return 1;
+        }
+
+        std::filesystem::path inputPath = args.GetParameter("-in");
+        std::filesystem::path outputPath = args.GetParameter("-out");
+        if(!std::filesystem::is_directory(inputPath))
+        {
+            Cook(inputPath, outputPath);
+            return 0;
+        }
+
+        // every .glb in the folder, keeping the folder structure
+        for(const auto &file : std::filesystem::recursive_directory_iterator(inputPath))
+        {
+            if(!file.is_regular_file() || lowerCase(file.path().extension().generic_string()) != ".glb")
+                continue;
+
+            auto target = outputPath / file.path().lexically_relative(inputPath);
+            target.replace_extension(".rmesh");
+            Cook(file.path(), target);
+        }
+    }
+    catch(const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,274 @@
+#include "loader/RisPackFormat.hpp"
+#include "misc/Args.hpp"
+#include "misc/StringSupport.hpp"
+
+#include <zip.hpp>
+#include <lz4.h>
+#include <lz4hc.h>
+#include <zstd.h>
+
+#include <fmt/format.h>
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <string>
+#include <set>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+
+// converts an asset folder or zip archive into a .rpak archive
+//   RisPacker -in <folder|archive.zip> -out <archive.rpak> [-codec lz4|zstd|none] [-level n] [-store ext...]
+
+using namespace RIS;
+using namespace RIS::Loader;
+
+namespace
+{
+    struct Options
+    {
+        RisPackCompression compression = RisPackCompression::LZ4;
+        int level = 0;
+        std::set<std::string> storeExtensions;
+    };
+
+    struct Input
+    {
+        std::string name;
+        std::function<std::vector<std::byte>()> read;
+    };
+
+    std::vector<std::byte> ReadFile(const std::filesystem::path &path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if(!file)
+            throw std::runtime_error(fmt::format("Can't read {}", path.generic_string()));
+
+        std::size_t size = file.tellg();
+        file.seekg(0);
+        std::vector<std::byte> bytes(size);
+        file.read(reinterpret_cast<char*>(bytes.data()), size);
+        return bytes;
+    }
+
+    std::vector<Input> ListFolder(const std::filesystem::path &folder)
+    {
+        std::vector<Input> inputs;
+        for(const auto &file : std::filesystem::recursive_directory_iterator(folder))
+        {
+            if(!file.is_regular_file())
+                continue;
+
+            auto path = file.path();
+            inputs.push_back({ path.lexically_relative(folder).generic_string(), [path]{ return ReadFile(path); } });
+        }
+        return inputs;
+    }
+
+    std::vector<Input> ListArchive(std::shared_ptr<libzip::archive> archive)
+    {
+        std::vector<Input> inputs;
+        int64_t numEntries = archive->num_entries();
+        for(int64_t i = 0; i < numEntries; ++i)
+        {
+            libzip::stat fileStat = archive->stat(i);
+            if(fileStat.name.empty() || fileStat.name.back() == '/')
+                continue;
+
+            inputs.push_back({ fileStat.name, [archive, i, size = fileStat.size]
+            {
+                std::vector<std::byte> bytes(static_cast<std::size_t>(size));
+                libzip::file file = archive->open(i);
+                if(file.read(bytes.data(), size) == -1)
+                    throw std::runtime_error(fmt::format("Can't read entry {} from the archive", i));
+                return bytes;
+            }});
+        }
+        return inputs;
+    }
+
+    // returns the compressed data, or nothing if the entry should be stored as is
+    std::vector<std::byte> Compress(const std::vector<std::byte> &bytes, RisPackCompression compression, int level)
+    {
+        std::vector<std::byte> compressed;
+        switch(compression)
+        {
+            case RisPackCompression::LZ4:
+            {
+                if(bytes.size() > LZ4_MAX_INPUT_SIZE)
+                    return {};
+                compressed.resize(LZ4_compressBound(static_cast<int>(bytes.size())));
+                int size = LZ4_compress_HC(reinterpret_cast<const char*>(bytes.data()), reinterpret_cast<char*>(compressed.data()), static_cast<int>(bytes.size()), static_cast<int>(compressed.size()), level > 0 ? level : LZ4HC_CLEVEL_DEFAULT);
+                if(size <= 0)
+                    return {};
+                compressed.resize(size);
+                break;
+            }
+            case RisPackCompression::ZSTD:
+            {
+                compressed.resize(ZSTD_compressBound(bytes.size()));
+                std::size_t size = ZSTD_compress(compressed.data(), compressed.size(), bytes.data(), bytes.size(), level > 0 ? level : 19);
+                if(ZSTD_isError(size))
+                    return {};
+                compressed.resize(size);
+                break;
+            }
+            case RisPackCompression::NONE:
+                return {};
+        }
+
+        // not worth paying for decompression, stored entries can be mapped directly
+        if(compressed.size() >= bytes.size() - bytes.size() / 16)
+            return {};
+        return compressed;
+    }
+
+    template<typename T>
+    void Write(std::ofstream &out, const T &value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void Align(std::ofstream &out, std::uint64_t alignment)
+    {
+        static const char zeros[RISPACK_ALIGNMENT] = {};
+        std::uint64_t pos = out.tellp();
+        std::uint64_t padding = (alignment - pos % alignment) % alignment;
+        out.write(zeros, padding);
+    }
+
+    void WritePack(std::vector<Input> &inputs, const std::string &outputPath, const Options &options)
+    {
+        std::sort(std::begin(inputs), std::end(inputs), [](const auto &a, const auto &b){ return a.name < b.name; });
+
+        std::unordered_map<std::uint64_t, std::string> hashes;
+        for(const auto &input : inputs)
+        {
+            if(input.name.size() > UINT16_MAX)
+                throw std::runtime_error(fmt::format("Name too long: {}", input.name));
+
+            auto [found, inserted] = hashes.try_emplace(RisPackNameHash(input.name), input.name);
+            if(!inserted)
+                throw std::runtime_error(fmt::format("{} and {} have the same name hash", found->second, input.name));
+        }
+
+        std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+        if(!out)
+            throw std::runtime_error(fmt::format("Can't write {}", outputPath));
+
+        RisPackHeader header = {};
+        Write(out, header);
+
+        std::vector<RisPackEntry> entries;
+        std::string names;
+        std::uint64_t totalSize = 0, packedSize = 0;
+
+        for(const auto &input : inputs)
+        {
+            auto bytes = input.read();
+            if(bytes.size() > RISPACK_MAX_ENTRY_SIZE)
+                throw std::runtime_error(fmt::format("{} is larger than {} bytes", input.name, RISPACK_MAX_ENTRY_SIZE));
+
+            std::string extension = lowerCase(std::filesystem::path(input.name).extension().generic_string());
+            bool store = bytes.empty() || options.storeExtensions.count(extension) > 0;
+            auto compressed = store ? std::vector<std::byte>() : Compress(bytes, options.compression, options.level);
+            const auto &data = compressed.empty() ? bytes : compressed;
+
+            Align(out, RISPACK_ALIGNMENT);
+
+            RisPackEntry entry = {};
+            entry.nameHash = RisPackNameHash(input.name);
+            entry.offset = out.tellp();
+            entry.size = data.size();
+            entry.originalSize = bytes.size();
+            entry.nameOffset = static_cast<std::uint32_t>(names.size());
+            entry.nameLength = static_cast<std::uint16_t>(input.name.size());
+            entry.compression = compressed.empty() ? RisPackCompression::NONE : options.compression;
+            entries.push_back(entry);
+            names += input.name;
+
+            out.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+            totalSize += bytes.size();
+            packedSize += data.size();
+        }
+
+        std::sort(std::begin(entries), std::end(entries), [](const auto &a, const auto &b){ return a.nameHash < b.nameHash; });
+
+        Align(out, alignof(RisPackEntry));
+        header.tocOffset = out.tellp();
+        for(const auto &entry : entries)
+            Write(out, entry);
+
+        header.namesOffset = out.tellp();
+        header.namesSize = names.size();
+        out.write(names.data(), names.size());
+
+        std::memcpy(header.magic, RISPACK_MAGIC, sizeof(header.magic));
+        header.version = RISPACK_VERSION;
+        header.numEntries = static_cast<std::uint32_t>(entries.size());
+        out.seekp(0);
+        Write(out, header);
+
+        if(!out)
+            throw std::runtime_error(fmt::format("Failed to write {}", outputPath));
+
+        std::cout << fmt::format("Packed {} files, {} -> {} bytes\n", entries.size(), totalSize, packedSize);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        Args args(argc, argv);
+        if(!args.IsSet("-in") || !args.IsSet("-out"))
+        {
+            std::cout << "usage: RisPacker -in <folder|archive.zip> -out <archive.rpak> [-codec lz4|zstd|none] [-level n] [-store ext...]\n";
+            return 1;
+        }
+
+        Options options;
+        if(args.IsSet("-codec"))
+        {
+            std::string codec = lowerCase(args.GetParameter("-codec"));
+            if(codec == "lz4")
+                options.compression = RisPackCompression::LZ4;
+            else if(codec == "zstd")
+                options.compression = RisPackCompression::ZSTD;
+            else if(codec == "none")
+                options.compression = RisPackCompression::NONE;
+            else
+                throw std::runtime_error(fmt::format("Unknown codec {}", codec));
+        }
+        if(args.IsSet("-level"))
+            options.level = std::stoi(args.GetParameter("-level"));
+        if(args.IsSet("-store"))
+        {
+            for(auto extension : args.GetParameters("-store"))
+            {
+                if(!extension.empty() && extension.front() != '.')
+                    extension.insert(0, ".");
+                options.storeExtensions.insert(lowerCase(extension));
+            }
+        }
+
+        std::filesystem::path inputPath = args.GetParameter("-in");
+        std::vector<Input> inputs;
+        if(std::filesystem::is_directory(inputPath))
+            inputs = ListFolder(inputPath);
+        else
+            inputs = ListArchive(std::make_shared<libzip::archive>(inputPath.generic_string()));
+
+        WritePack(inputs, args.GetParameter("-out"), options);
+    }
+    catch(const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}